@@ -678,9 +678,8 @@ static void ImGui_ImplIOS_RenderDrawLists (ImDrawData *draw_data)
                           (int)((height - pcmd->ClipRect.w) * g_displayScale),
                           (int)((pcmd->ClipRect.z - pcmd->ClipRect.x) * g_displayScale),
                           (int)((pcmd->ClipRect.w - pcmd->ClipRect.y) * g_displayScale));
-                glDrawElements( GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer );
+                glDrawElements( GL_TRIANGLES, (GLsizei)pcmd->ElemCount, GL_UNSIGNED_SHORT, idx_buffer + pcmd->IdxOffset );
             }
-            idx_buffer += pcmd->ElemCount;
         }
     }
     
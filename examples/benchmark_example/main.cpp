@@ -0,0 +1,593 @@
+// ImGui - standalone benchmarks, headless
+// Runs a fixed workload for each benchmark and prints one line per benchmark, in a format stable enough to diff between builds.
+// Besides the time per operation, reports the vertices emitted and the heap allocations made per operation (through io.MemAllocFn).
+//
+// Usage:
+//   benchmark_example [filter]      only run the benchmarks whose name contains 'filter'
+
+#include <imgui.h>
+#include "imgui_internal.h"     // ImTimeNow(), ImHash()
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct BenchmarkResult
+{
+    double  Seconds;
+    int     Ops;
+    double  Vertices;
+    double  Allocs;
+};
+
+typedef BenchmarkResult (*BenchmarkFunc)();
+
+static unsigned int BenchmarkRng = 1;
+static float        BenchmarkRandom() { BenchmarkRng = BenchmarkRng * 1103515245u + 12345u; return (float)((BenchmarkRng >> 8) & 0xFFFF) / 65536.0f; }
+
+static volatile float BenchmarkSink;       // Results are stored here so the compiler can't optimize the work away
+static int          BenchmarkAllocs = 0;
+static void*        BenchmarkMemAlloc(size_t sz) { BenchmarkAllocs++; return malloc(sz); }
+
+// Accumulate the time and allocations spent between Begin() and End() into a result
+struct BenchmarkTimer
+{
+    double  T0;
+    int     Allocs0;
+
+    void    Begin()                                 { Allocs0 = BenchmarkAllocs; T0 = ImTimeNow(); }
+    void    End(BenchmarkResult& res, int ops)      { res.Seconds += ImTimeNow() - T0; res.Allocs += BenchmarkAllocs - Allocs0; res.Ops += ops; }
+};
+
+static void SetupContext()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.MemAllocFn = BenchmarkMemAlloc;
+    io.MemFreeFn = free;
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.MousePos = ImVec2(-1.0f, -1.0f);
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+}
+
+//-----------------------------------------------------------------------------
+// Windows
+//-----------------------------------------------------------------------------
+
+static const int StressWindowsCount = 2000;
+
+// Many small overlapping windows spread over the display
+static void SubmitStressWindows()
+{
+    BenchmarkRng = 1;
+    for (int n = 0; n < StressWindowsCount; n++)
+    {
+        const ImVec2 size(80.0f + BenchmarkRandom() * 200.0f, 40.0f + BenchmarkRandom() * 120.0f);
+        const ImVec2 pos(BenchmarkRandom() * (ImGui::GetIO().DisplaySize.x - size.x), BenchmarkRandom() * (ImGui::GetIO().DisplaySize.y - size.y));
+        ImGui::SetNextWindowPos(pos, ImGuiSetCond_Always);
+        ImGui::SetNextWindowSize(size, ImGuiSetCond_Always);
+        char name[32];
+        sprintf(name, "Window %d", n);
+        ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Text("%d", n);
+        ImGui::End();
+    }
+}
+
+static void WarmupStressWindows()
+{
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImGui::NewFrame();
+        SubmitStressWindows();
+        ImGui::Render();
+    }
+}
+
+// Mouse queries on random positions, mostly over the windows
+static int QueryHoveredWindows(int count)
+{
+    int hits = 0;
+    BenchmarkRng = 2;
+    for (int n = 0; n < count; n++)
+        hits += ImGui::IsPosHoveringAnyWindow(ImVec2(BenchmarkRandom() * 1920.0f, BenchmarkRandom() * 1080.0f)) ? 1 : 0;
+    return hits;
+}
+
+static BenchmarkResult BenchmarkStressWindowsFrame()
+{
+    WarmupStressWindows();
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < 30; frame++)
+    {
+        ImGui::GetIO().MousePos = ImVec2(100.0f + frame * 50.0f, 100.0f + frame * 25.0f);
+        timer.Begin();
+        ImGui::NewFrame();
+        SubmitStressWindows();
+        ImGui::Render();
+        timer.End(res, 1);
+        res.Vertices += ImGui::GetIO().MetricsRenderVertices;
+    }
+    return res;
+}
+
+// Queried between Begin() calls the windows are being updated, so FindHoveredWindow() scans g.Windows
+static BenchmarkResult BenchmarkHoverQueryScan()
+{
+    WarmupStressWindows();
+    ImGui::NewFrame();
+    SubmitStressWindows();
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    timer.Begin();
+    QueryHoveredWindows(100000);
+    timer.End(res, 100000);
+    ImGui::Render();
+    return res;
+}
+
+// Queried after Render() (e.g. to decide whether the application gets the mouse), FindHoveredWindow() uses the window grid
+static BenchmarkResult BenchmarkHoverQueryGrid()
+{
+    WarmupStressWindows();
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    timer.Begin();
+    QueryHoveredWindows(100000);
+    timer.End(res, 100000);
+    return res;
+}
+
+// Child windows and popups are looked up by ID, without formatting a name
+static BenchmarkResult BenchmarkChildWindows()
+{
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < 33; frame++)
+    {
+        timer.Begin();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowSize(ImVec2(400, 600), ImGuiSetCond_Always);
+        ImGui::Begin("Children", NULL, ImGuiWindowFlags_NoSavedSettings);
+        for (int n = 0; n < 500; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::BeginChild("child", ImVec2(0, 20), true);
+            ImGui::EndChild();
+            ImGui::PopID();
+        }
+        ImGui::End();
+        ImGui::Render();
+        if (frame >= 3)     // Skip the frames creating the windows
+        {
+            timer.End(res, 500);
+            res.Vertices += ImGui::GetIO().MetricsRenderVertices;
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+// Draw lists
+//-----------------------------------------------------------------------------
+
+// A 30 columns table: Columns() splits the window draw list in one channel per column, merged back in EndColumns()
+static BenchmarkResult BenchmarkColumnsTable()
+{
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < 63; frame++)
+    {
+        timer.Begin();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiSetCond_Always);
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiSetCond_Always);
+        ImGui::Begin("Table", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Columns(30, "table");
+        for (int row = 0; row < 60; row++)
+            for (int column = 0; column < 30; column++)
+            {
+                ImGui::Text("%d:%d", row, column);
+                ImGui::NextColumn();
+            }
+        ImGui::Columns(1);
+        ImGui::End();
+        ImGui::Render();
+        if (frame >= 3)
+        {
+            timer.End(res, 1);
+            res.Vertices += ImGui::GetIO().MetricsRenderVertices;
+        }
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+// Draw list primitives
+//-----------------------------------------------------------------------------
+
+// Labels of typical lengths, from a two letters button to a long line of text
+static const char* SampleTexts[] =
+{
+    "OK", "Cancel", "Apply", "File", "Edit", "Window options", "Widgets", "Enable anti-aliasing",
+    "Frame: 16.667 ms (60.0 FPS)", "Hold SHIFT or use mouse to select text", "##hidden_label",
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.",
+    "C:\\Users\\user\\Documents\\projects\\imgui\\examples\\benchmark_example\\main.cpp",
+    "0.250", "-1234.5678", "Position: (1024.0, 768.0)",
+};
+
+// A few paragraphs, wrapped at various widths
+static const char* SampleParagraph =
+    "This window is being created by the ShowTestWindow() function. Please refer to the code for programming reference.\n\n"
+    "User Guide:\nDouble-click on title bar to collapse window. Click and drag on lower right corner to resize window. "
+    "Click and drag on any empty space to move window. Mouse Wheel to scroll. TAB/SHIFT+TAB to cycle through keyboard editable fields. "
+    "CTRL+Click on a slider or drag box to input text. While editing text: hold SHIFT or use mouse to select text, CTRL+Left/Right to word jump, "
+    "CTRL+A or double-click to select all, CTRL+X,CTRL+C,CTRL+V clipboard, CTRL+Z,CTRL+Y undo/redo, ESCAPE to revert.";
+
+static const int DrawListBatch = 100;       // Primitives added between each Clear(), keeping the draw list in its steady state and under 64K vertices
+
+// Primitives are added outside of any window, but within a frame so the white pixel UV and the font texture are set up
+static void BeginDrawListBenchmark(ImDrawList& draw_list)
+{
+    ImGui::NewFrame();
+    draw_list.Clear();
+    draw_list.PushClipRectFullScreen();
+    draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+}
+
+static void EndDrawListBenchmark(ImDrawList& draw_list)
+{
+    draw_list.ClearFreeMemory();
+    ImGui::Render();
+}
+
+static void ResetDrawList(ImDrawList& draw_list, BenchmarkResult& res)
+{
+    res.Vertices += draw_list.VtxBuffer.Size + draw_list.QuadBuffer.Size * 4;  // Quads (see ImDrawList::UseQuads) count as the 4 vertices they stand for
+    draw_list.Clear();
+    draw_list.PushClipRectFullScreen();
+    draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+}
+
+// Random shapes: a polygon of 'points_count' points on a circle, convex and in clockwise order
+static void MakeConvexShape(ImVector<ImVec2>& points, int points_count, float radius)
+{
+    const ImVec2 center(100.0f + BenchmarkRandom() * 1700.0f, 100.0f + BenchmarkRandom() * 900.0f);
+    points.resize(points_count);
+    for (int i = 0; i < points_count; i++)
+    {
+        const float a = (float)i / (float)points_count * 2.0f * IM_PI;
+        points[i] = ImVec2(center.x + cosf(a) * radius, center.y + sinf(a) * radius);
+    }
+}
+
+// Polylines of 2 to 64 points: separators, graph lines and outlines, half of them anti-aliased. With use_tex the anti-aliased ones sample the line profiles baked in the font atlas.
+static BenchmarkResult PolylineBenchmark(bool use_tex)
+{
+    ImDrawList draw_list;
+    BeginDrawListBenchmark(draw_list);
+    ImGui::GetStyle().AntiAliasedLinesUseTex = use_tex;
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    ImVector<ImVec2> points;
+    BenchmarkRng = 3;
+    for (int batch = 0; batch < 200; batch++)
+    {
+        timer.Begin();
+        for (int n = 0; n < DrawListBatch; n++)
+        {
+            const int points_count = 2 + (int)(BenchmarkRandom() * BenchmarkRandom() * 62.0f);
+            points.resize(points_count);
+            float x = BenchmarkRandom() * 1500.0f, y = 100.0f + BenchmarkRandom() * 800.0f;
+            for (int i = 0; i < points_count; i++)
+                points[i] = ImVec2(x += 2.0f + BenchmarkRandom() * 10.0f, y + BenchmarkRandom() * 50.0f);
+            draw_list.AddPolyline(points.Data, points.Size, 0xFFFFFFFF, (n & 4) != 0, (n & 2) ? 2.0f : 1.0f, (n & 1) != 0);
+        }
+        timer.End(res, DrawListBatch);
+        ResetDrawList(draw_list, res);
+    }
+    ImGui::GetStyle().AntiAliasedLinesUseTex = false;
+    EndDrawListBenchmark(draw_list);
+    return res;
+}
+
+static BenchmarkResult BenchmarkAddPolyline()           { return PolylineBenchmark(false); }
+static BenchmarkResult BenchmarkAddPolylineTex()        { return PolylineBenchmark(true); }
+
+// Convex polygons from triangles to 48 sided circles, half of them anti-aliased
+static BenchmarkResult BenchmarkAddConvexPolyFilled()
+{
+    ImDrawList draw_list;
+    BeginDrawListBenchmark(draw_list);
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    ImVector<ImVec2> points;
+    BenchmarkRng = 4;
+    for (int batch = 0; batch < 200; batch++)
+    {
+        timer.Begin();
+        for (int n = 0; n < DrawListBatch; n++)
+        {
+            MakeConvexShape(points, 3 + (int)(BenchmarkRandom() * 45.0f), 2.0f + BenchmarkRandom() * 200.0f);
+            draw_list.AddConvexPolyFilled(points.Data, points.Size, 0xFFFFFFFF, (n & 1) != 0);
+        }
+        timer.End(res, DrawListBatch);
+        ResetDrawList(draw_list, res);
+    }
+    EndDrawListBenchmark(draw_list);
+    return res;
+}
+
+// Rounded rectangles from 10 to 400 pixels wide, as used for frames, buttons and child windows
+static BenchmarkResult BenchmarkAddRectFilledRounded()
+{
+    ImDrawList draw_list;
+    BeginDrawListBenchmark(draw_list);
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    BenchmarkRng = 5;
+    for (int batch = 0; batch < 200; batch++)
+    {
+        timer.Begin();
+        for (int n = 0; n < DrawListBatch; n++)
+        {
+            const ImVec2 a(BenchmarkRandom() * 1500.0f, BenchmarkRandom() * 700.0f);
+            const ImVec2 b(a.x + 10.0f + BenchmarkRandom() * 390.0f, a.y + 10.0f + BenchmarkRandom() * 290.0f);
+            draw_list.AddRectFilled(a, b, 0xFFFFFFFF, 1.0f + BenchmarkRandom() * 11.0f, (n & 3) ? ~0 : 1 | 2);
+        }
+        timer.End(res, DrawListBatch);
+        ResetDrawList(draw_list, res);
+    }
+    EndDrawListBenchmark(draw_list);
+    return res;
+}
+
+// Text is the bulk of a typical frame. With use_quads each glyph is recorded as one ImDrawQuad, optionally expanded to triangles within the timing as Render() does for renderers without instancing.
+static BenchmarkResult AddTextBenchmark(bool use_quads, bool expand_quads)
+{
+    ImDrawList draw_list;
+    BeginDrawListBenchmark(draw_list);
+    draw_list.UseQuads = use_quads;
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    BenchmarkRng = 6;
+    for (int batch = 0; batch < 200; batch++)
+    {
+        timer.Begin();
+        for (int n = 0; n < DrawListBatch; n++)
+        {
+            const char* text = SampleTexts[n % IM_ARRAYSIZE(SampleTexts)];
+            draw_list.AddText(font, font->FontSize, ImVec2(BenchmarkRandom() * 1500.0f, BenchmarkRandom() * 1000.0f), 0xFFFFFFFF, text);
+        }
+        if (expand_quads)
+            draw_list.ExpandQuads();
+        timer.End(res, DrawListBatch);
+        ResetDrawList(draw_list, res);
+    }
+    EndDrawListBenchmark(draw_list);
+    return res;
+}
+
+static BenchmarkResult BenchmarkAddText()               { return AddTextBenchmark(false, false); }
+static BenchmarkResult BenchmarkAddTextQuads()          { return AddTextBenchmark(true, false); }
+static BenchmarkResult BenchmarkAddTextQuadsExpanded()  { return AddTextBenchmark(true, true); }
+
+//-----------------------------------------------------------------------------
+// Fonts
+//-----------------------------------------------------------------------------
+
+static BenchmarkResult BenchmarkCalcTextSize()
+{
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    float sum = 0.0f;
+    timer.Begin();
+    for (int n = 0; n < 200000; n++)
+        sum += font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, SampleTexts[n % IM_ARRAYSIZE(SampleTexts)]).x;
+    timer.End(res, 200000);
+    BenchmarkSink = sum;
+    return res;
+}
+
+// Wrapping a paragraph at the width of a typical window, over all its lines
+static BenchmarkResult BenchmarkCalcWordWrapPosition()
+{
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    const char* text_end = SampleParagraph + strlen(SampleParagraph);
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    timer.Begin();
+    int lines = 0;
+    for (int n = 0; n < 2000; n++)
+    {
+        const float wrap_width = 100.0f + (float)(n % 6) * 100.0f;
+        for (const char* s = SampleParagraph; s < text_end; lines++)
+        {
+            const char* wrap = font->CalcWordWrapPositionA(1.0f, s, text_end, wrap_width);
+            s = (wrap == s) ? wrap + 1 : wrap;
+            while (s < text_end && (*s == ' ' || *s == '\n'))
+                s++;
+        }
+    }
+    timer.End(res, lines);
+    return res;
+}
+
+// Default font in a new atlas: glyphs rasterization, packing and texture creation
+static BenchmarkResult BenchmarkFontAtlasBuild()
+{
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    for (int n = 0; n < 20; n++)
+    {
+        timer.Begin();
+        {
+            ImFontAtlas atlas;
+            atlas.AddFontDefault();
+            unsigned char* pixels;
+            int width, height;
+            atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+        }
+        timer.End(res, 1);
+    }
+    return res;
+}
+
+// Icons from 16x16 to 48x48 added to an empty image atlas, which grows and repacks along the way
+static BenchmarkResult BenchmarkImageAtlasAdd()
+{
+    static unsigned char pixels[48 * 48 * 4];
+    memset(pixels, 0xFF, sizeof(pixels));
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    BenchmarkRng = 8;
+    for (int pass = 0; pass < 10; pass++)
+    {
+        ImImageAtlas atlas;
+        timer.Begin();
+        for (int n = 0; n < 1000; n++)
+        {
+            const int size = 16 + (int)(BenchmarkRandom() * 32.0f);
+            atlas.AddImage(pixels, size, size);
+        }
+        timer.End(res, 1000);
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+// Hashing and storage
+//-----------------------------------------------------------------------------
+
+// Hashing labels, as done for each widget ID
+static BenchmarkResult BenchmarkHashString()
+{
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    ImU32 seed = 0;
+    timer.Begin();
+    for (int n = 0; n < 1000000; n++)
+        seed = ImHash(SampleTexts[n % 11], 0, seed);    // Skip the long texts, not used as labels
+    timer.End(res, 1000000);
+    BenchmarkSink = (float)seed;
+    return res;
+}
+
+// Hashing integers and pointers, as done by PushID(int) and PushID(const void*)
+static BenchmarkResult BenchmarkHashInt()
+{
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    ImU32 seed = 0;
+    timer.Begin();
+    for (int n = 0; n < 1000000; n++)
+        seed = ImHash(&n, sizeof(n), seed);
+    timer.End(res, 1000000);
+    BenchmarkSink = (float)seed;
+    return res;
+}
+
+// Lookups in a storage holding 1000 keys, as a window holding the state of its tree nodes and columns
+static BenchmarkResult BenchmarkStorageGetInt()
+{
+    ImGuiStorage storage;
+    for (int n = 0; n < 1000; n++)
+        storage.SetInt(ImHash(&n, sizeof(n), 0), n);
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    int sum = 0;
+    timer.Begin();
+    for (int n = 0; n < 1000000; n++)
+    {
+        const int key_n = n % 1000;
+        sum += storage.GetInt(ImHash(&key_n, sizeof(key_n), 0));
+    }
+    timer.End(res, 1000000);
+    storage.Clear();
+    BenchmarkSink = (float)sum;
+    return res;
+}
+
+// Inserting 1000 keys in random order in an empty storage
+static BenchmarkResult BenchmarkStorageSetInt()
+{
+    ImGuiStorage storage;
+    BenchmarkResult res = { 0.0, 0 };
+    BenchmarkTimer timer;
+    BenchmarkRng = 7;
+    for (int pass = 0; pass < 100; pass++)
+    {
+        storage.Clear();
+        timer.Begin();
+        for (int n = 0; n < 1000; n++)
+            storage.SetInt((ImGuiID)(BenchmarkRandom() * 1000000.0f), n);
+        timer.End(res, 1000);
+    }
+    storage.Clear();
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+
+struct Benchmark
+{
+    const char*     Name;
+    const char*     Unit;
+    BenchmarkFunc   Func;
+};
+
+static const Benchmark Benchmarks[] =
+{
+    { "windows/frame_2000_windows",     "frame",    BenchmarkStressWindowsFrame },
+    { "windows/hover_query_scan_2000",  "query",    BenchmarkHoverQueryScan },
+    { "windows/hover_query_grid_2000",  "query",    BenchmarkHoverQueryGrid },
+    { "windows/begin_child_500",        "child",    BenchmarkChildWindows },
+    { "drawlist/columns_30x60",         "frame",    BenchmarkColumnsTable },
+    { "drawlist/add_polyline",          "call",     BenchmarkAddPolyline },
+    { "drawlist/add_polyline_tex",      "call",     BenchmarkAddPolylineTex },
+    { "drawlist/add_convex_poly_filled", "call",    BenchmarkAddConvexPolyFilled },
+    { "drawlist/add_rect_filled_rounded", "call",   BenchmarkAddRectFilledRounded },
+    { "drawlist/add_text",              "call",     BenchmarkAddText },
+    { "drawlist/add_text_quads",        "call",     BenchmarkAddTextQuads },
+    { "drawlist/add_text_quads_expanded", "call",   BenchmarkAddTextQuadsExpanded },
+    { "font/calc_text_size",            "call",     BenchmarkCalcTextSize },
+    { "font/calc_word_wrap_position",   "line",     BenchmarkCalcWordWrapPosition },
+    { "font/atlas_build_default",       "build",    BenchmarkFontAtlasBuild },
+    { "image_atlas/add_image_1000",     "image",    BenchmarkImageAtlasAdd },
+    { "hash/string",                    "call",     BenchmarkHashString },
+    { "hash/int",                       "call",     BenchmarkHashInt },
+    { "storage/get_int_1000",           "call",     BenchmarkStorageGetInt },
+    { "storage/set_int_1000",           "call",     BenchmarkStorageSetInt },
+};
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : NULL;
+    printf("%-40s %14s %12s %12s  %s\n", "benchmark", "ns/op", "vtx/op", "allocs/op", "unit");
+    for (int n = 0; n < IM_ARRAYSIZE(Benchmarks); n++)
+    {
+        const Benchmark& bench = Benchmarks[n];
+        if (filter && strstr(bench.Name, filter) == NULL)
+            continue;
+
+        // Each benchmark runs on a fresh context
+        ImGuiContext* prev_ctx = ImGui::GetCurrentContext();
+        ImGuiContext* ctx = ImGui::CreateContext();
+        ImGui::SetCurrentContext(ctx);
+        SetupContext();
+        BenchmarkResult res = bench.Func();
+        ImGui::Shutdown();
+        ImGui::DestroyContext(ctx);
+        ImGui::SetCurrentContext(prev_ctx);
+        const double ops = res.Ops > 0 ? (double)res.Ops : 1.0;
+        printf("%-40s %14.1f %12.1f %12.3f  %s\n", bench.Name, res.Seconds * 1e9 / ops, res.Vertices / ops, res.Allocs / ops, bench.Unit);
+    }
+    return 0;
+}
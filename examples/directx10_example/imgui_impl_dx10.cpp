@@ -201,10 +201,10 @@ void ImGui_ImplDX10_RenderDrawLists(ImDrawData* draw_data)
                 const D3D10_RECT r = { (LONG)pcmd->ClipRect.x, (LONG)pcmd->ClipRect.y, (LONG)pcmd->ClipRect.z, (LONG)pcmd->ClipRect.w };
                 ctx->PSSetShaderResources(0, 1, (ID3D10ShaderResourceView**)&pcmd->TextureId);
                 ctx->RSSetScissorRects(1, &r);
-                ctx->DrawIndexed(pcmd->ElemCount, idx_offset, vtx_offset);
+                ctx->DrawIndexed(pcmd->ElemCount, idx_offset + pcmd->IdxOffset, vtx_offset);
             }
-            idx_offset += pcmd->ElemCount;
         }
+        idx_offset += cmd_list->IdxBuffer.Size;
         vtx_offset += cmd_list->VtxBuffer.Size;
     }
 
@@ -79,9 +79,8 @@ void ImGui_Marmalade_RenderDrawLists(ImDrawData* draw_data)
                 pCurrentMaterial->SetAlphaTestMode(CIwMaterial::ALPHATEST_DISABLED);
                 pCurrentMaterial->SetTexture((CIwTexture*)pcmd->TextureId);
                 IwGxSetMaterial(pCurrentMaterial);
-                IwGxDrawPrims(IW_GX_TRI_LIST, (uint16*)idx_buffer, pcmd->ElemCount);
+                IwGxDrawPrims(IW_GX_TRI_LIST, (uint16*)(idx_buffer + pcmd->IdxOffset), pcmd->ElemCount);
             }
-            idx_buffer += pcmd->ElemCount;
         }
         IwGxFlush();
     }
@@ -0,0 +1,226 @@
+// ImGui - N contexts driven by N threads at once (IMGUI_USE_THREAD_LOCAL_CONTEXT)
+// Each thread creates its own context and runs the same scripted UI: windows, buttons, sliders, text input, tree nodes, columns, plots,
+// popups and the metrics window. A reference run on the main thread first records what each frame produces (vertex/index counts and
+// a hash of the vertices and indices). Every thread must reproduce it exactly, so any state shared by the contexts shows up as a mismatch.
+// The font atlas is shared: it is built before the threads start and only read afterwards.
+// POSIX only (pthreads), no window or graphics library needed. ImGui must be compiled with IMGUI_USE_THREAD_LOCAL_CONTEXT, the Makefile does it.
+//
+// Usage:
+//   multicontext_example [options]
+//     --threads <count>     number of contexts/threads running at once (default: 8)
+//     --frames <count>      number of frames run by each context (default: 300)
+
+#include <imgui.h>
+#include "imgui_internal.h"     // ImTimeNow(), ImHash()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifndef IMGUI_USE_THREAD_LOCAL_CONTEXT
+#error "Compile ImGui and this example with IMGUI_USE_THREAD_LOCAL_CONTEXT"
+#endif
+
+struct FrameResult
+{
+    int     Vertices;
+    int     Indices;
+    ImU32   Hash;
+};
+
+struct ThreadData
+{
+    pthread_t           Thread;
+    int                 Index;
+    int                 FramesCount;
+    ImFontAtlas*        Fonts;
+    const FrameResult*  Reference;
+    FrameResult*        Results;
+    int                 Mismatches;
+    double              Ms;
+};
+
+static void ScriptedFrame(int frame)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    const int phase = frame % 40;
+    io.MousePos = (phase < 20) ? ImVec2(40.0f + (float)((frame * 11) % 400), 40.0f + (float)((frame * 7) % 300)) : ImVec2(60.0f, 70.0f + (float)((frame / 40 * 19) % 200));
+    io.MouseDown[0] = (phase == 30 || phase == 31);
+    io.MouseDown[1] = (frame % 150) == 75;
+    if ((frame % 9) == 0)
+        io.AddInputCharacter((ImWchar)('a' + frame % 26));
+
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiSetCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(420, 360), ImGuiSetCond_FirstUseEver);
+    ImGui::Begin("Document");
+    static IM_THREAD_LOCAL int counter = 0;     // Widget state of a context lives in its own thread
+    static IM_THREAD_LOCAL float value = 0.5f;
+    static IM_THREAD_LOCAL char text[64] = "";
+    if (ImGui::Button("Count"))
+        counter++;
+    ImGui::SameLine();
+    ImGui::Text("%d clicks, frame %d", counter, ImGui::GetFrameCount());
+    ImGui::SliderFloat("Value", &value, 0.0f, 1.0f);
+    ImGui::InputText("Text", text, IM_ARRAYSIZE(text));
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Typed characters go here");
+    for (int n = 0; n < 4; n++)
+        if (ImGui::TreeNode((void*)(size_t)n, "Node %d", n))
+        {
+            ImGui::Columns(3, "cols");
+            for (int i = 0; i < 9; i++)
+            {
+                ImGui::Text("Cell %d.%d", n, i);
+                ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::TreePop();
+        }
+    float samples[64];
+    for (int n = 0; n < IM_ARRAYSIZE(samples); n++)
+        samples[n] = (float)((n * 37 + frame) % 64) / 64.0f;
+    ImGui::PlotLines("Samples", samples, IM_ARRAYSIZE(samples), 0, NULL, 0.0f, 1.0f, ImVec2(0, 60));
+    if (ImGui::BeginPopupContextWindow())
+    {
+        ImGui::MenuItem("Cut");
+        ImGui::MenuItem("Paste");
+        ImGui::EndPopup();
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(460, 20), ImGuiSetCond_FirstUseEver);
+    ImGui::ShowMetricsWindow();
+
+    ImGui::Render();
+}
+
+static FrameResult GetFrameResult()
+{
+    FrameResult result;
+    memset(&result, 0, sizeof(result));
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        result.Hash = ImHash(cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), result.Hash);
+        result.Hash = ImHash(cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), result.Hash);
+    }
+    result.Vertices = draw_data->TotalVtxCount;
+    result.Indices = draw_data->TotalIdxCount;
+    return result;
+}
+
+static void SetupContext(ImFontAtlas* fonts)
+{
+    ImGui::SetCurrentContext(ImGui::CreateContext());
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1024, 768);
+    io.Fonts = fonts;
+    io.MemUsePools = true;
+}
+
+static void DestroyContext()
+{
+    ImGui::GetIO().Fonts = NULL;    // The atlas is shared, don't clear it
+    ImGui::Shutdown();
+    ImGui::DestroyContext(ImGui::GetCurrentContext());
+}
+
+static void* ContextThreadMain(void* arg)
+{
+    ThreadData* data = (ThreadData*)arg;
+    SetupContext(data->Fonts);
+    const double t0 = ImTimeNow();
+    for (int frame = 0; frame < data->FramesCount; frame++)
+    {
+        ScriptedFrame(frame);
+        const FrameResult result = GetFrameResult();
+        const FrameResult& reference = data->Reference[frame];
+        if (result.Vertices != reference.Vertices || result.Indices != reference.Indices || result.Hash != reference.Hash)
+            data->Mismatches++;
+    }
+    data->Ms = (ImTimeNow() - t0) * 1000.0;
+    DestroyContext();
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    int threads_count = 8;
+    int frames_count = 300;
+    for (int n = 1; n < argc; n++)
+    {
+        const bool has_value = n + 1 < argc;
+        if (strcmp(argv[n], "--threads") == 0 && has_value)        threads_count = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--frames") == 0 && has_value)    frames_count = atoi(argv[++n]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--threads <count>] [--frames <count>]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads_count < 1 || frames_count < 1)
+        return 1;
+
+    // Build the shared atlas before any thread uses it. There is no default context in this mode, so it allocates with malloc().
+    ImFontAtlas* fonts = new ImFontAtlas();
+    unsigned char* pixels;
+    int width, height;
+    fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    // Reference run, alone on the main thread
+    FrameResult* reference = (FrameResult*)malloc(sizeof(FrameResult) * (size_t)frames_count);
+    SetupContext(fonts);
+    double t0 = ImTimeNow();
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        ScriptedFrame(frame);
+        reference[frame] = GetFrameResult();
+    }
+    const double reference_ms = (ImTimeNow() - t0) * 1000.0;
+    DestroyContext();
+
+    // All contexts at once
+    ThreadData* threads = (ThreadData*)calloc((size_t)threads_count, sizeof(ThreadData));
+    t0 = ImTimeNow();
+    for (int n = 0; n < threads_count; n++)
+    {
+        threads[n].Index = n;
+        threads[n].FramesCount = frames_count;
+        threads[n].Fonts = fonts;
+        threads[n].Reference = reference;
+        if (pthread_create(&threads[n].Thread, NULL, ContextThreadMain, &threads[n]) != 0)
+        {
+            fprintf(stderr, "Error creating thread %d\n", n);
+            return 1;
+        }
+    }
+    int mismatches = 0;
+    for (int n = 0; n < threads_count; n++)
+    {
+        pthread_join(threads[n].Thread, NULL);
+        mismatches += threads[n].Mismatches;
+    }
+    const double parallel_ms = (ImTimeNow() - t0) * 1000.0;
+
+    printf("%d frames, %d vertices on the last frame\n", frames_count, reference[frames_count - 1].Vertices);
+    printf("1 context:  %.3f ms/frame\n", reference_ms / frames_count);
+    printf("%d contexts on %d threads: %.3f ms for all frames, %.3f ms/frame per context\n", threads_count, threads_count, parallel_ms, parallel_ms / frames_count);
+    for (int n = 0; n < threads_count; n++)
+        printf("  thread %d: %.3f ms/frame, %d/%d frames differ from the reference\n", n, threads[n].Ms / frames_count, threads[n].Mismatches, frames_count);
+
+    free(threads);
+    free(reference);
+    delete fonts;
+    if (mismatches > 0)
+    {
+        fprintf(stderr, "%d frames differ from the reference run\n", mismatches);
+        return 2;
+    }
+    return 0;
+}
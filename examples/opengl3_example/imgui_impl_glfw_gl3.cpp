@@ -28,7 +28,66 @@ static GLuint       g_FontTexture = 0;
 static int          g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static int          g_AttribLocationPosition = 0, g_AttribLocationUV = 0, g_AttribLocationColor = 0;
-static unsigned int g_VboHandle = 0, g_VaoHandle = 0, g_ElementsHandle = 0;
+static unsigned int g_VaoHandle = 0;
+static int          g_QuadShaderHandle = 0, g_QuadVertHandle = 0;
+static int          g_QuadAttribLocationTex = 0, g_QuadAttribLocationProjMtx = 0;
+static int          g_QuadAttribLocationMin = 0, g_QuadAttribLocationMax = 0, g_QuadAttribLocationUvMin = 0, g_QuadAttribLocationUvMax = 0, g_QuadAttribLocationColor = 0;
+static unsigned int g_QuadVaoHandle = 0;
+
+// Buffers are kept per ImDrawList between frames and only uploaded again when the list's ContentVersion changed (we set io.RenderDrawListsTrackChanges)
+struct ImGui_ImplGlfwGL3_ListBuffers
+{
+    const ImDrawList*   List;
+    unsigned int        ContentVersion;
+    GLuint              VboHandle, ElementsHandle, QuadVboHandle;
+    int                 LastFrameUsed;
+};
+static ImVector<ImGui_ImplGlfwGL3_ListBuffers> g_ListBuffers;
+static int          g_FrameCount = 0;
+
+#define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
+
+static ImGui_ImplGlfwGL3_ListBuffers* ImGui_ImplGlfwGL3_GetListBuffers(const ImDrawList* cmd_list)
+{
+    for (int i = 0; i < g_ListBuffers.Size; i++)
+        if (g_ListBuffers[i].List == cmd_list)
+            return &g_ListBuffers[i];
+    ImGui_ImplGlfwGL3_ListBuffers buffers;
+    buffers.List = cmd_list;
+    buffers.ContentVersion = 0;
+    glGenBuffers(1, &buffers.VboHandle);
+    glGenBuffers(1, &buffers.ElementsHandle);
+    glGenBuffers(1, &buffers.QuadVboHandle);
+    buffers.LastFrameUsed = g_FrameCount;
+    g_ListBuffers.push_back(buffers);
+    return &g_ListBuffers.back();
+}
+
+static void ImGui_ImplGlfwGL3_DeleteListBuffers(ImGui_ImplGlfwGL3_ListBuffers* buffers)
+{
+    glDeleteBuffers(1, &buffers->VboHandle);
+    glDeleteBuffers(1, &buffers->ElementsHandle);
+    glDeleteBuffers(1, &buffers->QuadVboHandle);
+}
+
+// Point the vertex attributes at the currently bound GL_ARRAY_BUFFER
+static void ImGui_ImplGlfwGL3_SetupVertexAttribs()
+{
+    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+    glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
+}
+
+// Point the per-instance attributes at the first quad of a command (GL 3.3 has no base instance for glDrawArraysInstanced)
+static void ImGui_ImplGlfwGL3_SetupQuadAttribs(unsigned int quad_offset)
+{
+    const size_t base = quad_offset * sizeof(ImDrawQuad);
+    glVertexAttribPointer(g_QuadAttribLocationMin, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(base + OFFSETOF(ImDrawQuad, Min)));
+    glVertexAttribPointer(g_QuadAttribLocationMax, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(base + OFFSETOF(ImDrawQuad, Max)));
+    glVertexAttribPointer(g_QuadAttribLocationUvMin, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(base + OFFSETOF(ImDrawQuad, UvMin)));
+    glVertexAttribPointer(g_QuadAttribLocationUvMax, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(base + OFFSETOF(ImDrawQuad, UvMax)));
+    glVertexAttribPointer(g_QuadAttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawQuad), (GLvoid*)(base + OFFSETOF(ImDrawQuad, Col)));
+}
 
 // This is the main rendering function that you have to implement and provide to ImGui (via setting up 'RenderDrawListsFn' in the ImGuiIO structure)
 // If text or lines are blurry when integrating ImGui in your engine:
@@ -79,21 +138,40 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
         { 0.0f,                  0.0f,                  -1.0f, 0.0f },
         {-1.0f,                  1.0f,                   0.0f, 1.0f },
     };
+    glUseProgram(g_QuadShaderHandle);
+    glUniform1i(g_QuadAttribLocationTex, 0);
+    glUniformMatrix4fv(g_QuadAttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glUseProgram(g_ShaderHandle);
     glUniform1i(g_AttribLocationTex, 0);
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glBindVertexArray(g_VaoHandle);
+    g_FrameCount++;
 
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
         const ImDrawIdx* idx_buffer_offset = 0;
 
-        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        // Upload the list unless the buffers already hold this version of its content (a ContentVersion of 0 means it isn't tracked)
+        ImGui_ImplGlfwGL3_ListBuffers* buffers = ImGui_ImplGlfwGL3_GetListBuffers(cmd_list);
+        const bool upload = (cmd_list->ContentVersion == 0 || cmd_list->ContentVersion != buffers->ContentVersion);
+        buffers->ContentVersion = cmd_list->ContentVersion;
+        buffers->LastFrameUsed = g_FrameCount;
+
+        glBindBuffer(GL_ARRAY_BUFFER, buffers->VboHandle);
+        if (upload)
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_DYNAMIC_DRAW);
+        ImGui_ImplGlfwGL3_SetupVertexAttribs();
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->ElementsHandle);
+        if (upload)
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_DYNAMIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        if (upload && cmd_list->QuadBuffer.Size > 0)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, buffers->QuadVboHandle);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->QuadBuffer.Size * sizeof(ImDrawQuad), (const GLvoid*)cmd_list->QuadBuffer.Data, GL_DYNAMIC_DRAW);
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -106,9 +184,37 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
             {
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
                 glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
+                if (pcmd->QuadCount > 0)
+                {
+                    // One instance per quad, 4 vertices each
+                    glUseProgram(g_QuadShaderHandle);
+                    glBindVertexArray(g_QuadVaoHandle);
+                    glBindBuffer(GL_ARRAY_BUFFER, buffers->QuadVboHandle);
+                    ImGui_ImplGlfwGL3_SetupQuadAttribs(pcmd->QuadOffset);
+                    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)pcmd->QuadCount);
+                    glUseProgram(g_ShaderHandle);
+                    glBindVertexArray(g_VaoHandle);
+                }
+                else
+                {
+                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset + pcmd->IdxOffset);
+                }
             }
-            idx_buffer_offset += pcmd->ElemCount;
+        }
+    }
+
+    // Release the buffers of lists which haven't been rendered for a while (e.g. closed windows)
+    for (int i = 0; i < g_ListBuffers.Size; )
+    {
+        if (g_FrameCount - g_ListBuffers[i].LastFrameUsed > 60)
+        {
+            ImGui_ImplGlfwGL3_DeleteListBuffers(&g_ListBuffers[i]);
+            g_ListBuffers[i] = g_ListBuffers.back();
+            g_ListBuffers.pop_back();
+        }
+        else
+        {
+            i++;
         }
     }
 
@@ -221,6 +327,25 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
         "	gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // Quads: corners are picked from gl_VertexID (drawn as a 4 vertices triangle strip), the rest comes from per-instance attributes
+    const GLchar *quad_vertex_shader =
+        "#version 330\n"
+        "uniform mat4 ProjMtx;\n"
+        "in vec2 QuadMin;\n"
+        "in vec2 QuadMax;\n"
+        "in vec2 QuadUvMin;\n"
+        "in vec2 QuadUvMax;\n"
+        "in vec4 QuadColor;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "	vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+        "	Frag_UV = mix(QuadUvMin, QuadUvMax, corner);\n"
+        "	Frag_Color = QuadColor;\n"
+        "	gl_Position = ProjMtx * vec4(mix(QuadMin, QuadMax, corner),0,1);\n"
+        "}\n";
+
     const GLchar* fragment_shader =
         "#version 330\n"
         "uniform sampler2D Texture;\n"
@@ -249,21 +374,37 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
 
-    glGenBuffers(1, &g_VboHandle);
-    glGenBuffers(1, &g_ElementsHandle);
-
+    g_QuadShaderHandle = glCreateProgram();
+    g_QuadVertHandle = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(g_QuadVertHandle, 1, &quad_vertex_shader, 0);
+    glCompileShader(g_QuadVertHandle);
+    glAttachShader(g_QuadShaderHandle, g_QuadVertHandle);
+    glAttachShader(g_QuadShaderHandle, g_FragHandle);
+    glLinkProgram(g_QuadShaderHandle);
+
+    g_QuadAttribLocationTex = glGetUniformLocation(g_QuadShaderHandle, "Texture");
+    g_QuadAttribLocationProjMtx = glGetUniformLocation(g_QuadShaderHandle, "ProjMtx");
+    g_QuadAttribLocationMin = glGetAttribLocation(g_QuadShaderHandle, "QuadMin");
+    g_QuadAttribLocationMax = glGetAttribLocation(g_QuadShaderHandle, "QuadMax");
+    g_QuadAttribLocationUvMin = glGetAttribLocation(g_QuadShaderHandle, "QuadUvMin");
+    g_QuadAttribLocationUvMax = glGetAttribLocation(g_QuadShaderHandle, "QuadUvMax");
+    g_QuadAttribLocationColor = glGetAttribLocation(g_QuadShaderHandle, "QuadColor");
+
+    // Attribute pointers are set when rendering, from the buffers of each draw list
     glGenVertexArrays(1, &g_VaoHandle);
     glBindVertexArray(g_VaoHandle);
-    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
     glEnableVertexAttribArray(g_AttribLocationPosition);
     glEnableVertexAttribArray(g_AttribLocationUV);
     glEnableVertexAttribArray(g_AttribLocationColor);
 
-#define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
-    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
-#undef OFFSETOF
+    glGenVertexArrays(1, &g_QuadVaoHandle);
+    glBindVertexArray(g_QuadVaoHandle);
+    const int quad_attribs[5] = { g_QuadAttribLocationMin, g_QuadAttribLocationMax, g_QuadAttribLocationUvMin, g_QuadAttribLocationUvMax, g_QuadAttribLocationColor };
+    for (int i = 0; i < 5; i++)
+    {
+        glEnableVertexAttribArray(quad_attribs[i]);
+        glVertexAttribDivisor(quad_attribs[i], 1);
+    }
 
     ImGui_ImplGlfwGL3_CreateFontsTexture();
 
@@ -278,9 +419,19 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
 void    ImGui_ImplGlfwGL3_InvalidateDeviceObjects()
 {
     if (g_VaoHandle) glDeleteVertexArrays(1, &g_VaoHandle);
-    if (g_VboHandle) glDeleteBuffers(1, &g_VboHandle);
-    if (g_ElementsHandle) glDeleteBuffers(1, &g_ElementsHandle);
-    g_VaoHandle = g_VboHandle = g_ElementsHandle = 0;
+    g_VaoHandle = 0;
+    if (g_QuadVaoHandle) glDeleteVertexArrays(1, &g_QuadVaoHandle);
+    g_QuadVaoHandle = 0;
+    for (int i = 0; i < g_ListBuffers.Size; i++)
+        ImGui_ImplGlfwGL3_DeleteListBuffers(&g_ListBuffers[i]);
+    g_ListBuffers.clear();
+
+    if (g_QuadShaderHandle && g_QuadVertHandle) glDetachShader(g_QuadShaderHandle, g_QuadVertHandle);
+    if (g_QuadShaderHandle && g_FragHandle) glDetachShader(g_QuadShaderHandle, g_FragHandle);
+    if (g_QuadVertHandle) glDeleteShader(g_QuadVertHandle);
+    g_QuadVertHandle = 0;
+    if (g_QuadShaderHandle) glDeleteProgram(g_QuadShaderHandle);
+    g_QuadShaderHandle = 0;
 
     if (g_ShaderHandle && g_VertHandle) glDetachShader(g_ShaderHandle, g_VertHandle);
     if (g_VertHandle) glDeleteShader(g_VertHandle);
@@ -327,6 +478,8 @@ bool    ImGui_ImplGlfwGL3_Init(GLFWwindow* window, bool install_callbacks)
     io.KeyMap[ImGuiKey_Z] = GLFW_KEY_Z;
 
     io.RenderDrawListsFn = ImGui_ImplGlfwGL3_RenderDrawLists;       // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+    io.RenderDrawListsUseQuads = true;                              // We draw ImDrawCmd::QuadCount instances from QuadBuffer, so quads recorded with io.DrawListsUseQuads don't need to be expanded to triangles.
+    io.RenderDrawListsTrackChanges = true;                          // We keep the buffers of each draw list between frames and only upload those whose ContentVersion changed.
     io.SetClipboardTextFn = ImGui_ImplGlfwGL3_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplGlfwGL3_GetClipboardText;
     io.ClipboardUserData = g_Window;
@@ -30,6 +30,7 @@ int main(int, char**)
 
     // Setup ImGui binding
     ImGui_ImplGlfwGL3_Init(window, true);
+    ImGui::GetIO().DrawListsUseQuads = true;    // Record rectangles, images and text as instanced quads (the binding draws them with glDrawArraysInstanced)
 
     // Load Fonts
     // (there is a default font, this is only if you want to change it. see extra_fonts/README.txt for more details)
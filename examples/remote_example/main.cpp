@@ -0,0 +1,408 @@
+// ImGui - remote rendering over a local socket, with ImDrawDataEncoder/ImDrawDataDecoder
+// The server process runs the demo window with scripted inputs and sends each frame; the client process decodes it and
+// renders it with a minimal software rasterizer. Reports the bytes sent per frame against the size of the raw ImDrawData.
+// POSIX only (fork, socketpair). In a real application the two sides would run on different machines, over TCP.
+//
+// Usage:
+//   remote_example [options]
+//     --frames <count>      number of frames to run (default: 300)
+//     --ppm <file>          write the last frame rendered by the client to <file>
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+static const int DisplayWidth = 1280, DisplayHeight = 720;
+
+// Each frame is sent with a header: compressed size, then statistics from the encoder
+struct FrameHeader
+{
+    unsigned int    Size;               // 0 to end the stream
+    unsigned int    DrawDataBytes;
+    unsigned int    PayloadBytes;
+};
+
+static bool SendAll(int fd, const void* data, size_t size)
+{
+    const char* p = (const char*)data;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool RecvAll(int fd, void* data, size_t size)
+{
+    char* p = (char*)data;
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Server
+//-----------------------------------------------------------------------------
+
+static int RunServer(int fd, int frames_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2((float)DisplayWidth, (float)DisplayHeight);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // The texture ID is only a key for the client to find the texture: use anything unique
+    ImDrawDataEncoder encoder;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->TexID = (void*)(intptr_t)1;
+    encoder.SetTexture(io.Fonts->TexID, pixels, width, height, 4);
+
+    ImVector<unsigned char> buf;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        // Same scripted interaction as replay_example: sweep the mouse over the demo window and click down its left side
+        const int step = frame / 30, phase = frame % 30;
+        if (phase >= 25)
+            io.MousePos = ImVec2(90.0f, 115.0f + (float)((step * 23) % 600));
+        else
+            io.MousePos = ImVec2(60.0f + (float)((frame * 7) % 550), 60.0f + (float)((frame * 13) % 640));
+        io.MouseDown[0] = (phase == 27);
+        io.MouseWheel = (frame % 97) == 0 ? -3.0f : 0.0f;
+        ImGui::NewFrame();
+        ImGui::ShowTestWindow();
+        ImGui::Render();
+
+        encoder.EncodeFrame(ImGui::GetDrawData(), io.DisplaySize, &buf);
+        FrameHeader header = { (unsigned int)buf.Size, (unsigned int)encoder.LastDrawDataBytes, (unsigned int)encoder.LastPayloadBytes };
+        if (!SendAll(fd, &header, sizeof(header)) || !SendAll(fd, buf.Data, (size_t)buf.Size))
+            return 1;
+    }
+    FrameHeader end = { 0, 0, 0 };
+    SendAll(fd, &end, sizeof(end));
+    ImGui::Shutdown();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Round-trip check
+//-----------------------------------------------------------------------------
+
+// Compare the triangles drawn by each command, through the indices of each side
+static bool SameDrawData(const ImDrawData* a, const ImDrawData* b)
+{
+    if (a->CmdListsCount != b->CmdListsCount)
+        return false;
+    for (int n = 0; n < a->CmdListsCount; n++)
+    {
+        const ImDrawList* list_a = a->CmdLists[n];
+        const ImDrawList* list_b = b->CmdLists[n];
+        if (list_a->CmdBuffer.Size != list_b->CmdBuffer.Size)
+            return false;
+        for (int cmd_i = 0; cmd_i < list_a->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd& cmd_a = list_a->CmdBuffer[cmd_i];
+            const ImDrawCmd& cmd_b = list_b->CmdBuffer[cmd_i];
+            if (cmd_a.ElemCount != cmd_b.ElemCount || cmd_a.TextureId != cmd_b.TextureId || memcmp(&cmd_a.ClipRect, &cmd_b.ClipRect, sizeof(ImVec4)) != 0)
+                return false;
+            for (unsigned int i = 0; i < cmd_a.ElemCount; i++)
+                if (memcmp(&list_a->VtxBuffer[list_a->IdxBuffer[cmd_a.IdxOffset + i]], &list_b->VtxBuffer[list_b->IdxBuffer[cmd_b.IdxOffset + i]], sizeof(ImDrawVert)) != 0)
+                    return false;
+        }
+    }
+    return true;
+}
+
+// Columns split and merge the draw list every frame, changing its commands a lot between frames. Then feed the decoder truncated and corrupted frames.
+// Run in its own context before forking, so the server starts from a fresh state.
+static int RunRoundTripCheck(int frames_count)
+{
+    ImGuiContext* prev_ctx = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImFontAtlas fonts;
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2((float)DisplayWidth, (float)DisplayHeight);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.Fonts = &fonts;
+    unsigned char* pixels;
+    int width, height;
+    fonts.GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    ImDrawDataEncoder encoder;
+    ImDrawDataDecoder decoder;
+    ImVector<unsigned char> buf;
+    int errors = 0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowSize(ImVec2(600, 500), ImGuiSetCond_FirstUseEver);
+        ImGui::Begin("Columns");
+        ImGui::Columns(4, "cols");
+        const int rows = (frame * 13) % 40 + 1;
+        for (int i = 0; i < rows * 4; i++)
+        {
+            ImGui::Text(((i + frame) % 3) ? "Item %d" : "A longer item %d", i);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::End();
+        ImGui::Render();
+
+        encoder.EncodeFrame(ImGui::GetDrawData(), io.DisplaySize, &buf);
+        if (!decoder.DecodeFrame(buf.Data, buf.Size) || !SameDrawData(ImGui::GetDrawData(), &decoder.DrawData))
+            errors++;
+    }
+
+    // Truncated and corrupted frames must be rejected, whatever the byte hit. Resend a keyframe so each one can be decoded on its own.
+    encoder.Reset();
+    encoder.EncodeFrame(ImGui::GetDrawData(), io.DisplaySize, &buf);
+    int bad_frames = 0, bad_frames_accepted = 0;
+    ImVector<unsigned char> bad_buf;
+    bad_buf.resize(buf.Size);
+    for (int size = 0; size < buf.Size; size += (size < 64) ? 1 : 61)
+    {
+        bad_frames++;
+        bad_frames_accepted += decoder.DecodeFrame(buf.Data, size) ? 1 : 0;
+    }
+    for (int offset = 0; offset < buf.Size; offset += (offset < 64) ? 1 : 37)
+    {
+        if (offset >= 12 && offset < 16)
+            continue;   // stb_compress() window size, not used to decompress
+        memcpy(bad_buf.Data, buf.Data, (size_t)buf.Size);
+        bad_buf[offset] ^= (unsigned char)(1 << (offset & 7));
+        bad_frames++;
+        bad_frames_accepted += decoder.DecodeFrame(bad_buf.Data, bad_buf.Size) ? 1 : 0;
+    }
+    if (!decoder.DecodeFrame(buf.Data, buf.Size) || !SameDrawData(ImGui::GetDrawData(), &decoder.DrawData))
+        errors++;
+    printf("Round-trip check: %d/%d frames with Columns decoded differently, %d/%d truncated or corrupted frames accepted\n", errors, frames_count + 1, bad_frames_accepted, bad_frames);
+    fflush(stdout);    // Before fork() duplicates the buffer
+
+    io.Fonts = NULL;
+    ImGui::Shutdown();
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(prev_ctx);
+    return (errors > 0 || bad_frames_accepted > 0) ? 2 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Client
+//-----------------------------------------------------------------------------
+
+struct Framebuffer
+{
+    int             Width, Height;
+    unsigned char*  Pixels;     // RGBA
+};
+
+static inline float EdgeFunction(const ImVec2& a, const ImVec2& b, float x, float y) { return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x); }
+static inline float ColorChannel(ImU32 col, int shift)                              { return (float)((col >> shift) & 0xFF) * (1.0f / 255.0f); }
+
+// Nearest sampling, flat-shaded colors interpolated per pixel, scissored to the clip rectangle
+static void RasterizeTriangle(Framebuffer& fb, const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const ImVec4& clip, const ImDrawDataStreamTexture* tex)
+{
+    float area = EdgeFunction(v0.pos, v1.pos, v2.pos.x, v2.pos.y);
+    if (area == 0.0f)
+        return;
+    int x0 = (int)(v0.pos.x < v1.pos.x ? (v0.pos.x < v2.pos.x ? v0.pos.x : v2.pos.x) : (v1.pos.x < v2.pos.x ? v1.pos.x : v2.pos.x));
+    int y0 = (int)(v0.pos.y < v1.pos.y ? (v0.pos.y < v2.pos.y ? v0.pos.y : v2.pos.y) : (v1.pos.y < v2.pos.y ? v1.pos.y : v2.pos.y));
+    int x1 = (int)(v0.pos.x > v1.pos.x ? (v0.pos.x > v2.pos.x ? v0.pos.x : v2.pos.x) : (v1.pos.x > v2.pos.x ? v1.pos.x : v2.pos.x)) + 1;
+    int y1 = (int)(v0.pos.y > v1.pos.y ? (v0.pos.y > v2.pos.y ? v0.pos.y : v2.pos.y) : (v1.pos.y > v2.pos.y ? v1.pos.y : v2.pos.y)) + 1;
+    if (x0 < (int)clip.x) x0 = (int)clip.x;
+    if (y0 < (int)clip.y) y0 = (int)clip.y;
+    if (x1 > (int)clip.z) x1 = (int)clip.z;
+    if (y1 > (int)clip.w) y1 = (int)clip.w;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > fb.Width) x1 = fb.Width;
+    if (y1 > fb.Height) y1 = fb.Height;
+
+    const float inv_area = 1.0f / area;
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++)
+        {
+            const float px = x + 0.5f, py = y + 0.5f;
+            const float w0 = EdgeFunction(v1.pos, v2.pos, px, py) * inv_area;
+            const float w1 = EdgeFunction(v2.pos, v0.pos, px, py) * inv_area;
+            const float w2 = EdgeFunction(v0.pos, v1.pos, px, py) * inv_area;
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                continue;
+            float r = w0 * ColorChannel(v0.col, 0) + w1 * ColorChannel(v1.col, 0) + w2 * ColorChannel(v2.col, 0);
+            float g = w0 * ColorChannel(v0.col, 8) + w1 * ColorChannel(v1.col, 8) + w2 * ColorChannel(v2.col, 8);
+            float b = w0 * ColorChannel(v0.col, 16) + w1 * ColorChannel(v1.col, 16) + w2 * ColorChannel(v2.col, 16);
+            float a = w0 * ColorChannel(v0.col, 24) + w1 * ColorChannel(v1.col, 24) + w2 * ColorChannel(v2.col, 24);
+            if (tex)
+            {
+                const float u = w0 * v0.uv.x + w1 * v1.uv.x + w2 * v2.uv.x, v = w0 * v0.uv.y + w1 * v1.uv.y + w2 * v2.uv.y;
+                int tx = (int)(u * tex->Width), ty = (int)(v * tex->Height);
+                tx = tx < 0 ? 0 : tx >= tex->Width ? tex->Width - 1 : tx;
+                ty = ty < 0 ? 0 : ty >= tex->Height ? tex->Height - 1 : ty;
+                const unsigned char* texel = &tex->Pixels[(ty * tex->Width + tx) * tex->BytesPerPixel];
+                if (tex->BytesPerPixel == 4)
+                {
+                    r *= texel[0] / 255.0f; g *= texel[1] / 255.0f; b *= texel[2] / 255.0f; a *= texel[3] / 255.0f;
+                }
+                else
+                {
+                    a *= texel[0] / 255.0f;
+                }
+            }
+            unsigned char* dst = &fb.Pixels[(y * fb.Width + x) * 4];
+            dst[0] = (unsigned char)(r * a * 255.0f + dst[0] * (1.0f - a));
+            dst[1] = (unsigned char)(g * a * 255.0f + dst[1] * (1.0f - a));
+            dst[2] = (unsigned char)(b * a * 255.0f + dst[2] * (1.0f - a));
+            dst[3] = 255;
+        }
+}
+
+static void RenderDrawData(Framebuffer& fb, const ImDrawDataDecoder& decoder)
+{
+    memset(fb.Pixels, 0, (size_t)(fb.Width * fb.Height * 4));
+    const ImDrawData* draw_data = &decoder.DrawData;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            const ImDrawDataStreamTexture* tex = decoder.FindTexture(pcmd->TextureId);
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+                RasterizeTriangle(fb, cmd_list->VtxBuffer[idx[i]], cmd_list->VtxBuffer[idx[i + 1]], cmd_list->VtxBuffer[idx[i + 2]], pcmd->ClipRect, tex);
+        }
+    }
+}
+
+static bool WritePPM(const char* filename, const Framebuffer& fb)
+{
+    FILE* f = fopen(filename, "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P6\n%d %d\n255\n", fb.Width, fb.Height);
+    for (int i = 0; i < fb.Width * fb.Height; i++)
+        fwrite(&fb.Pixels[i * 4], 1, 3, f);
+    fclose(f);
+    return true;
+}
+
+static int RunClient(int fd, const char* ppm_filename)
+{
+    ImDrawDataDecoder decoder;
+    Framebuffer fb;
+    fb.Width = DisplayWidth;
+    fb.Height = DisplayHeight;
+    fb.Pixels = (unsigned char*)malloc((size_t)(fb.Width * fb.Height * 4));
+
+    ImVector<unsigned char> buf;
+    int frames = 0;
+    double total_bytes = 0.0, total_draw_data_bytes = 0.0, total_payload_bytes = 0.0;
+    unsigned int first_bytes = 0, max_bytes = 0;
+    for (;;)
+    {
+        FrameHeader header;
+        if (!RecvAll(fd, &header, sizeof(header)))
+        {
+            fprintf(stderr, "Connection lost\n");
+            return 1;
+        }
+        if (header.Size == 0)
+            break;
+        buf.resize((int)header.Size);
+        if (!RecvAll(fd, buf.Data, header.Size))
+        {
+            fprintf(stderr, "Connection lost\n");
+            return 1;
+        }
+        if (!decoder.DecodeFrame(buf.Data, buf.Size))
+        {
+            fprintf(stderr, "Error decoding frame %d\n", frames);
+            return 1;
+        }
+        RenderDrawData(fb, decoder);
+
+        if (frames == 0)
+            first_bytes = header.Size;
+        else if (header.Size > max_bytes)
+            max_bytes = header.Size;
+        frames++;
+        total_bytes += header.Size;
+        total_draw_data_bytes += header.DrawDataBytes;
+        total_payload_bytes += header.PayloadBytes;
+    }
+
+    if (frames > 0)
+    {
+        printf("%d frames, %.0f bytes/frame sent (first frame %u bytes with the font atlas, max %u bytes after)\n", frames, total_bytes / frames, first_bytes, max_bytes);
+        printf("ImDrawData %.0f bytes/frame, %.0f bytes/frame after delta encoding, %.1fx smaller once compressed\n", total_draw_data_bytes / frames, total_payload_bytes / frames, total_bytes > 0.0 ? total_draw_data_bytes / total_bytes : 0.0);
+    }
+    if (ppm_filename && !WritePPM(ppm_filename, fb))
+        fprintf(stderr, "Error writing '%s'\n", ppm_filename);
+    free(fb.Pixels);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int frames_count = 300;
+    const char* ppm_filename = NULL;
+    for (int n = 1; n < argc; n++)
+    {
+        const bool has_value = n + 1 < argc;
+        if (strcmp(argv[n], "--frames") == 0 && has_value)      frames_count = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--ppm") == 0 && has_value)    ppm_filename = argv[++n];
+        else
+        {
+            fprintf(stderr, "Usage: %s [--frames <count>] [--ppm <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (int ret = RunRoundTripCheck(60))
+        return ret;
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        perror("socketpair");
+        return 1;
+    }
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        const int ret = RunServer(fds[1], frames_count);
+        close(fds[1]);
+        return ret;
+    }
+    close(fds[1]);
+    const int ret = RunClient(fds[0], ppm_filename);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return ret != 0 ? ret : (WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+}
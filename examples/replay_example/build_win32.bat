@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Debug
+cl /nologo /Zi /MD /O2 /I ..\.. *.cpp ..\..\*.cpp /FeDebug/replay_example.exe /FoDebug/
@@ -0,0 +1,249 @@
+// ImGui - headless input replay over the demo window, for frame-time regression testing
+// Record inputs in your application with ImGui::BeginInputRecording()/EndInputRecording(), then replay them here.
+// Frames are driven with a fixed timestep and nothing is rendered: we measure the CPU cost of NewFrame() + ShowTestWindow() + Render().
+//
+// Usage:
+//   replay_example <recording> [options]
+//     --generate <frames>       write a scripted recording of the demo window into <recording> and exit
+//     --dt <seconds>            fixed timestep (default: 1/60)
+//     --csv <file>              write per-frame results (frame, cpu_ms, vertices, indices, allocs, alloc_bytes)
+//     --save-baseline <file>    write the summary to <file>
+//     --baseline <file>         compare the summary with <file>, exit code 2 on regression
+//     --time-tolerance <ratio>  allowed ratio on CPU times over the baseline (default: 1.25). Vertex/allocation counts must not grow.
+
+#include <imgui.h>
+#include "imgui_internal.h"     // ImTimeNow()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ReplaySummary
+{
+    int     Frames;
+    double  TotalMs;
+    double  MaxMs;
+    double  TotalVertices;
+    double  TotalIndices;
+    double  TotalAllocs;
+    double  TotalAllocBytes;
+    int     MaxVertices;
+    int     MaxAllocs;
+};
+
+static const char* SummaryFieldNames[] = { "frames", "total_ms", "max_ms", "total_vertices", "total_indices", "total_allocs", "total_alloc_bytes", "max_vertices", "max_allocs" };
+
+static void SummaryGetFields(const ReplaySummary& s, double* out)
+{
+    out[0] = s.Frames; out[1] = s.TotalMs; out[2] = s.MaxMs; out[3] = s.TotalVertices; out[4] = s.TotalIndices;
+    out[5] = s.TotalAllocs; out[6] = s.TotalAllocBytes; out[7] = s.MaxVertices; out[8] = s.MaxAllocs;
+}
+
+static void SetupContext()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    for (int n = 0; n < ImGuiKey_COUNT; n++)
+        io.KeyMap[n] = n;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+}
+
+// Scripted interaction: sweep the mouse over the demo window, click, scroll and type. Deterministic, so CI can regenerate it.
+static bool GenerateRecording(const char* filename, int frames_count, float dt)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (!ImGui::BeginInputRecording(filename))
+        return false;
+    unsigned int rng = 1;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        rng = rng * 1103515245u + 12345u;
+        io.DeltaTime = dt;
+        // Every 30 frames, click down the left side of the window (opening headers and tree nodes), hovering elsewhere in between
+        const int step = frame / 30, phase = frame % 30;
+        if (phase >= 25)
+            io.MousePos = ImVec2(90.0f, 115.0f + (float)((step * 23) % 600));
+        else
+            io.MousePos = ImVec2(60.0f + (float)((frame * 7) % 550), 60.0f + (float)((frame * 13) % 640));
+        io.MouseDown[0] = (phase == 27);
+        io.MouseWheel = (frame % 97) == 0 ? -3.0f : 0.0f;
+        if ((frame % 50) == 25)
+            io.AddInputCharacter((ImWchar)('a' + (rng >> 16) % 26));
+        io.KeysDown[ImGuiKey_Tab] = (frame % 150) == 149;
+        ImGui::NewFrame();
+        ImGui::ShowTestWindow();
+        ImGui::Render();
+    }
+    ImGui::EndInputRecording();
+    return true;
+}
+
+static bool LoadBaseline(const char* filename, double* out)
+{
+    FILE* f = fopen(filename, "rt");
+    if (!f)
+        return false;
+    int found = 0;
+    char name[64];
+    double value;
+    while (fscanf(f, "%63s %lf", name, &value) == 2)
+        for (int n = 0; n < IM_ARRAYSIZE(SummaryFieldNames); n++)
+            if (strcmp(name, SummaryFieldNames[n]) == 0)
+            {
+                out[n] = value;
+                found++;
+            }
+    fclose(f);
+    return found == IM_ARRAYSIZE(SummaryFieldNames);
+}
+
+int main(int argc, char** argv)
+{
+    const char* recording = NULL;
+    const char* csv_filename = NULL;
+    const char* baseline_filename = NULL;
+    const char* save_baseline_filename = NULL;
+    int generate_frames = 0;
+    float dt = 1.0f / 60.0f;
+    double time_tolerance = 1.25;
+    for (int n = 1; n < argc; n++)
+    {
+        const bool has_value = n + 1 < argc;
+        if (strcmp(argv[n], "--generate") == 0 && has_value)            generate_frames = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--dt") == 0 && has_value)             dt = (float)atof(argv[++n]);
+        else if (strcmp(argv[n], "--csv") == 0 && has_value)            csv_filename = argv[++n];
+        else if (strcmp(argv[n], "--baseline") == 0 && has_value)       baseline_filename = argv[++n];
+        else if (strcmp(argv[n], "--save-baseline") == 0 && has_value)  save_baseline_filename = argv[++n];
+        else if (strcmp(argv[n], "--time-tolerance") == 0 && has_value) time_tolerance = atof(argv[++n]);
+        else if (argv[n][0] != '-' && recording == NULL)                recording = argv[n];
+        else
+        {
+            fprintf(stderr, "Unknown or incomplete option '%s'\n", argv[n]);
+            return 1;
+        }
+    }
+    if (recording == NULL)
+    {
+        fprintf(stderr, "Usage: %s <recording> [--generate <frames>] [--dt <seconds>] [--csv <file>] [--save-baseline <file>] [--baseline <file>] [--time-tolerance <ratio>]\n", argv[0]);
+        return 1;
+    }
+
+    SetupContext();
+    if (generate_frames > 0)
+    {
+        if (!GenerateRecording(recording, generate_frames, dt))
+        {
+            fprintf(stderr, "Error writing '%s'\n", recording);
+            return 1;
+        }
+        printf("Wrote %d frames to '%s'\n", generate_frames, recording);
+        ImGui::Shutdown();
+        return 0;
+    }
+
+    if (!ImGui::BeginInputReplay(recording, dt))
+    {
+        fprintf(stderr, "Error reading '%s'\n", recording);
+        return 1;
+    }
+    FILE* csv = csv_filename ? fopen(csv_filename, "wt") : NULL;
+    if (csv)
+        fprintf(csv, "frame,cpu_ms,vertices,indices,allocs,alloc_bytes\n");
+
+    // io.MetricsFrameAllocs is updated by NewFrame() for the frame before it, so each row is completed one frame late
+    // and we run an extra empty frame after the replay ends.
+    ImGuiIO& io = ImGui::GetIO();
+    ReplaySummary summary;
+    memset(&summary, 0, sizeof(summary));
+    bool has_prev = false;
+    double prev_ms = 0.0;
+    int prev_vertices = 0, prev_indices = 0;
+    for (;;)
+    {
+        const bool replaying = ImGui::IsInputReplaying();
+        const double t0 = ImTimeNow();
+        ImGui::NewFrame();
+        if (replaying)
+            ImGui::ShowTestWindow();
+        ImGui::Render();
+        const double ms = (ImTimeNow() - t0) * 1000.0;
+
+        if (has_prev)
+        {
+            summary.TotalAllocs += io.MetricsFrameAllocs;
+            summary.TotalAllocBytes += io.MetricsFrameAllocsBytes;
+            summary.MaxAllocs = io.MetricsFrameAllocs > summary.MaxAllocs ? io.MetricsFrameAllocs : summary.MaxAllocs;
+            if (csv)
+                fprintf(csv, "%d,%.4f,%d,%d,%d,%d\n", summary.Frames - 1, prev_ms, prev_vertices, prev_indices, io.MetricsFrameAllocs, io.MetricsFrameAllocsBytes);
+        }
+        if (!replaying)
+            break;
+        summary.Frames++;
+        summary.TotalMs += ms;
+        summary.MaxMs = ms > summary.MaxMs ? ms : summary.MaxMs;
+        summary.TotalVertices += io.MetricsRenderVertices;
+        summary.TotalIndices += io.MetricsRenderIndices;
+        summary.MaxVertices = io.MetricsRenderVertices > summary.MaxVertices ? io.MetricsRenderVertices : summary.MaxVertices;
+        has_prev = true;
+        prev_ms = ms;
+        prev_vertices = io.MetricsRenderVertices;
+        prev_indices = io.MetricsRenderIndices;
+    }
+    if (csv)
+        fclose(csv);
+    ImGui::Shutdown();
+
+    double fields[IM_ARRAYSIZE(SummaryFieldNames)];
+    SummaryGetFields(summary, fields);
+    printf("%d frames, %.3f ms/frame (max %.3f ms), %.0f vertices/frame, %.1f allocs/frame\n", summary.Frames,
+        summary.Frames ? summary.TotalMs / summary.Frames : 0.0, summary.MaxMs,
+        summary.Frames ? summary.TotalVertices / summary.Frames : 0.0, summary.Frames ? summary.TotalAllocs / summary.Frames : 0.0);
+
+    if (save_baseline_filename)
+    {
+        FILE* f = fopen(save_baseline_filename, "wt");
+        if (!f)
+        {
+            fprintf(stderr, "Error writing '%s'\n", save_baseline_filename);
+            return 1;
+        }
+        for (int n = 0; n < IM_ARRAYSIZE(SummaryFieldNames); n++)
+            fprintf(f, "%s %.4f\n", SummaryFieldNames[n], fields[n]);
+        fclose(f);
+    }
+
+    if (baseline_filename)
+    {
+        double baseline[IM_ARRAYSIZE(SummaryFieldNames)];
+        if (!LoadBaseline(baseline_filename, baseline))
+        {
+            fprintf(stderr, "Error reading '%s'\n", baseline_filename);
+            return 1;
+        }
+        if (fields[0] != baseline[0])
+        {
+            fprintf(stderr, "Baseline was recorded over %.0f frames, replayed %.0f\n", baseline[0], fields[0]);
+            return 1;
+        }
+        int regressions = 0;
+        for (int n = 1; n < IM_ARRAYSIZE(SummaryFieldNames); n++)
+        {
+            if (n == 2)     // max_ms is too noisy to gate on
+                continue;
+            const double limit = (n == 1) ? baseline[n] * time_tolerance : baseline[n];
+            if (fields[n] > limit)
+            {
+                fprintf(stderr, "Regression: %s = %.4f, baseline %.4f (limit %.4f)\n", SummaryFieldNames[n], fields[n], baseline[n], limit);
+                regressions++;
+            }
+        }
+        if (regressions > 0)
+            return 2;
+        printf("No regression against '%s'\n", baseline_filename);
+    }
+    return 0;
+}
@@ -22,7 +22,39 @@ static GLuint       g_FontTexture = 0;
 static int          g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static int          g_AttribLocationPosition = 0, g_AttribLocationUV = 0, g_AttribLocationColor = 0;
-static unsigned int g_VboHandle = 0, g_VaoHandle = 0, g_ElementsHandle = 0;
+static unsigned int g_VaoHandle = 0;
+
+// Buffers are kept per ImDrawList between frames and only uploaded again when the list's ContentVersion changed (we set io.RenderDrawListsTrackChanges)
+struct ImGui_ImplSdlGL3_ListBuffers
+{
+    const ImDrawList*   List;
+    unsigned int        ContentVersion;
+    GLuint              VboHandle, ElementsHandle;
+    int                 LastFrameUsed;
+};
+static ImVector<ImGui_ImplSdlGL3_ListBuffers> g_ListBuffers;
+static int          g_FrameCount = 0;
+
+static ImGui_ImplSdlGL3_ListBuffers* ImGui_ImplSdlGL3_GetListBuffers(const ImDrawList* cmd_list)
+{
+    for (int i = 0; i < g_ListBuffers.Size; i++)
+        if (g_ListBuffers[i].List == cmd_list)
+            return &g_ListBuffers[i];
+    ImGui_ImplSdlGL3_ListBuffers buffers;
+    buffers.List = cmd_list;
+    buffers.ContentVersion = 0;
+    glGenBuffers(1, &buffers.VboHandle);
+    glGenBuffers(1, &buffers.ElementsHandle);
+    buffers.LastFrameUsed = g_FrameCount;
+    g_ListBuffers.push_back(buffers);
+    return &g_ListBuffers.back();
+}
+
+static void ImGui_ImplSdlGL3_DeleteListBuffers(ImGui_ImplSdlGL3_ListBuffers* buffers)
+{
+    glDeleteBuffers(1, &buffers->VboHandle);
+    glDeleteBuffers(1, &buffers->ElementsHandle);
+}
 
 // This is the main rendering function that you have to implement and provide to ImGui (via setting up 'RenderDrawListsFn' in the ImGuiIO structure)
 // If text or lines are blurry when integrating ImGui in your engine:
@@ -77,17 +109,31 @@ void ImGui_ImplSdlGL3_RenderDrawLists(ImDrawData* draw_data)
     glUniform1i(g_AttribLocationTex, 0);
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glBindVertexArray(g_VaoHandle);
+    g_FrameCount++;
 
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
         const ImDrawIdx* idx_buffer_offset = 0;
 
-        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        // Upload the list unless the buffers already hold this version of its content (a ContentVersion of 0 means it isn't tracked)
+        ImGui_ImplSdlGL3_ListBuffers* buffers = ImGui_ImplSdlGL3_GetListBuffers(cmd_list);
+        const bool upload = (cmd_list->ContentVersion == 0 || cmd_list->ContentVersion != buffers->ContentVersion);
+        buffers->ContentVersion = cmd_list->ContentVersion;
+        buffers->LastFrameUsed = g_FrameCount;
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers->VboHandle);
+        if (upload)
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (GLvoid*)cmd_list->VtxBuffer.Data, GL_DYNAMIC_DRAW);
+#define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
+        glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
+        glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+        glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
+#undef OFFSETOF
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->ElementsHandle);
+        if (upload)
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (GLvoid*)cmd_list->IdxBuffer.Data, GL_DYNAMIC_DRAW);
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -100,9 +146,23 @@ void ImGui_ImplSdlGL3_RenderDrawLists(ImDrawData* draw_data)
             {
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
                 glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
+                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset + pcmd->IdxOffset);
             }
-            idx_buffer_offset += pcmd->ElemCount;
+        }
+    }
+
+    // Release the buffers of lists which haven't been rendered for a while (e.g. closed windows)
+    for (int i = 0; i < g_ListBuffers.Size; )
+    {
+        if (g_FrameCount - g_ListBuffers[i].LastFrameUsed > 60)
+        {
+            ImGui_ImplSdlGL3_DeleteListBuffers(&g_ListBuffers[i]);
+            g_ListBuffers[i] = g_ListBuffers.back();
+            g_ListBuffers.pop_back();
+        }
+        else
+        {
+            i++;
         }
     }
 
@@ -249,22 +309,13 @@ bool ImGui_ImplSdlGL3_CreateDeviceObjects()
     g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
 
-    glGenBuffers(1, &g_VboHandle);
-    glGenBuffers(1, &g_ElementsHandle);
-
+    // Attribute pointers are set when rendering, from the buffers of each draw list
     glGenVertexArrays(1, &g_VaoHandle);
     glBindVertexArray(g_VaoHandle);
-    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
     glEnableVertexAttribArray(g_AttribLocationPosition);
     glEnableVertexAttribArray(g_AttribLocationUV);
     glEnableVertexAttribArray(g_AttribLocationColor);
 
-#define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
-    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
-#undef OFFSETOF
-
     ImGui_ImplSdlGL3_CreateFontsTexture();
 
     // Restore modified GL state
@@ -278,9 +329,10 @@ bool ImGui_ImplSdlGL3_CreateDeviceObjects()
 void    ImGui_ImplSdlGL3_InvalidateDeviceObjects()
 {
     if (g_VaoHandle) glDeleteVertexArrays(1, &g_VaoHandle);
-    if (g_VboHandle) glDeleteBuffers(1, &g_VboHandle);
-    if (g_ElementsHandle) glDeleteBuffers(1, &g_ElementsHandle);
-    g_VaoHandle = g_VboHandle = g_ElementsHandle = 0;
+    g_VaoHandle = 0;
+    for (int i = 0; i < g_ListBuffers.Size; i++)
+        ImGui_ImplSdlGL3_DeleteListBuffers(&g_ListBuffers[i]);
+    g_ListBuffers.clear();
 
     if (g_ShaderHandle && g_VertHandle) glDetachShader(g_ShaderHandle, g_VertHandle);
     if (g_VertHandle) glDeleteShader(g_VertHandle);
@@ -325,6 +377,7 @@ bool    ImGui_ImplSdlGL3_Init(SDL_Window* window)
     io.KeyMap[ImGuiKey_Z] = SDLK_z;
 
     io.RenderDrawListsFn = ImGui_ImplSdlGL3_RenderDrawLists;   // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+    io.RenderDrawListsTrackChanges = true;                     // We keep the buffers of each draw list between frames and only upload those whose ContentVersion changed.
     io.SetClipboardTextFn = ImGui_ImplSdlGL3_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplSdlGL3_GetClipboardText;
     io.ClipboardUserData = NULL;
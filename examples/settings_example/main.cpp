@@ -0,0 +1,119 @@
+// ImGui - window settings saved to a binary journal (io.IniBinaryFilename)
+// Runs three sessions, each in its own context, over the same journal: the first one moves the windows and writes the journal on Shutdown(),
+// the second one checks they come back then moves them (Shutdown() only appends the changed records), the third one checks the moves.
+// One of the windows has a name longer than 512 bytes. No window or graphics library needed.
+//
+// Usage:
+//   settings_example [options]
+//     --journal <file>      path of the journal, deleted first (default: settings_example.bin)
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WINDOWS_COUNT   3
+
+struct WindowDesc
+{
+    char    Name[700];
+    ImVec2  Pos[2];     // Position set by the first session, then by the second one
+    bool    Collapsed;  // Set by the second session
+};
+
+static WindowDesc Windows[WINDOWS_COUNT];
+
+static void SetupWindows()
+{
+    strcpy(Windows[0].Name, "Tools");
+    strcpy(Windows[1].Name, "Scene###scene");   // Settings are saved under "###scene", the visible title may change
+    const int long_name_len = (int)sizeof(Windows[2].Name) - 1;
+    for (int n = 0; n < long_name_len; n++)
+        Windows[2].Name[n] = "A window with a very long name "[n % 31];
+    Windows[2].Name[long_name_len] = 0;
+    for (int i = 0; i < WINDOWS_COUNT; i++)
+    {
+        Windows[i].Pos[0] = ImVec2(40.0f + i * 200.0f, 30.0f + i * 100.0f);
+        Windows[i].Pos[1] = ImVec2(Windows[i].Pos[0].x + 17.0f, Windows[i].Pos[0].y + 23.0f * (i + 1));
+        Windows[i].Collapsed = (i == 1);
+    }
+}
+
+// Returns the number of windows found at their expected position ('expected' < 0: nothing expected, e.g. on the first session)
+static int RunSession(ImFontAtlas* fonts, const char* journal_filename, int expected, int moved_to)
+{
+    ImGuiContext* prev_ctx = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.IniBinaryFilename = journal_filename;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.Fonts = fonts;
+
+    int restored = 0;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImGui::NewFrame();
+        for (int i = 0; i < WINDOWS_COUNT; i++)
+        {
+            if (frame == 0)
+                ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f + i * 20.0f), ImGuiSetCond_FirstUseEver);   // Where windows without saved settings appear
+            else if (frame == 1 && moved_to >= 0)
+            {
+                ImGui::SetNextWindowPos(Windows[i].Pos[moved_to], ImGuiSetCond_Always);
+                ImGui::SetNextWindowCollapsed(moved_to == 1 && Windows[i].Collapsed, ImGuiSetCond_Always);
+            }
+            ImGui::SetNextWindowSize(ImVec2(180, 90), ImGuiSetCond_FirstUseEver);
+            ImGui::Begin(Windows[i].Name);
+            if (frame == 0 && expected >= 0)
+            {
+                const ImVec2 pos = ImGui::GetWindowPos();
+                const bool collapsed = ImGui::IsWindowCollapsed();
+                if (pos.x == Windows[i].Pos[expected].x && pos.y == Windows[i].Pos[expected].y && collapsed == (expected == 1 && Windows[i].Collapsed))
+                    restored++;
+                else
+                    printf("Window %d (%d bytes name) at %.0f,%.0f%s, expected %.0f,%.0f\n", i, (int)strlen(Windows[i].Name), pos.x, pos.y, collapsed ? " collapsed" : "", Windows[i].Pos[expected].x, Windows[i].Pos[expected].y);
+            }
+            ImGui::End();
+        }
+        ImGui::Render();
+    }
+
+    io.Fonts = NULL;
+    ImGui::Shutdown();
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(prev_ctx);
+    return restored;
+}
+
+int main(int argc, char** argv)
+{
+    const char* journal_filename = "settings_example.bin";
+    for (int n = 1; n < argc; n++)
+    {
+        const bool has_value = n + 1 < argc;
+        if (strcmp(argv[n], "--journal") == 0 && has_value)  journal_filename = argv[++n];
+        else
+        {
+            fprintf(stderr, "Usage: %s [--journal <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetupWindows();
+    ImFontAtlas fonts;
+    unsigned char* pixels;
+    int width, height;
+    fonts.GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    remove(journal_filename);
+    RunSession(&fonts, journal_filename, -1, 0);
+    const int restored_written = RunSession(&fonts, journal_filename, 0, 1);
+    const int restored_appended = RunSession(&fonts, journal_filename, 1, -1);
+    printf("%d/%d windows restored from the journal, %d/%d after appending their moves\n", restored_written, WINDOWS_COUNT, restored_appended, WINDOWS_COUNT);
+    remove(journal_filename);
+    return (restored_written == WINDOWS_COUNT && restored_appended == WINDOWS_COUNT) ? 0 : 2;
+}
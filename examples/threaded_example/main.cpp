@@ -0,0 +1,220 @@
+// ImGui - render thread fed with ImDrawDataSnapshot
+// The UI thread runs the demo window with scripted inputs and captures each frame into a snapshot taken from a pool of 3,
+// which goes through a bounded queue to a render thread. The render thread "submits" it: it uploads the vertices/indices of the lists
+// whose ContentVersion changed into staging memory, then waits --submit-ms to stand for the driver and the GPU.
+// The same frames are then run serially (UI and submission on one thread) to report how much of the submission cost is hidden.
+// POSIX only (pthreads), no window or graphics library needed.
+//
+// Usage:
+//   threaded_example [options]
+//     --frames <count>      number of frames to run in each mode (default: 300)
+//     --submit-ms <ms>      simulated driver/GPU cost of submitting a frame (default: 1.0)
+
+#include <imgui.h>
+#include "imgui_internal.h"     // ImTimeNow()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define SNAPSHOT_COUNT  3       // 1 being built by the UI thread, 1 being submitted, 1 waiting in between
+
+// Blocking FIFO of snapshots. Two of them cycle the pool: the UI thread takes from Free and pushes to Ready, the render thread does the opposite.
+struct SnapshotQueue
+{
+    pthread_mutex_t         Mutex;
+    pthread_cond_t          Cond;
+    ImDrawDataSnapshot*     Items[SNAPSHOT_COUNT + 1];
+    int                     Head, Count;
+
+    SnapshotQueue()     { pthread_mutex_init(&Mutex, NULL); pthread_cond_init(&Cond, NULL); Head = Count = 0; }
+    ~SnapshotQueue()    { pthread_cond_destroy(&Cond); pthread_mutex_destroy(&Mutex); }
+
+    void Push(ImDrawDataSnapshot* snapshot)     // NULL ends the stream
+    {
+        pthread_mutex_lock(&Mutex);
+        IM_ASSERT(Count < IM_ARRAYSIZE(Items));
+        Items[(Head + Count++) % IM_ARRAYSIZE(Items)] = snapshot;
+        pthread_cond_signal(&Cond);
+        pthread_mutex_unlock(&Mutex);
+    }
+
+    ImDrawDataSnapshot* Pop(double* waited_ms)
+    {
+        const double t0 = ImTimeNow();
+        pthread_mutex_lock(&Mutex);
+        while (Count == 0)
+            pthread_cond_wait(&Cond, &Mutex);
+        ImDrawDataSnapshot* snapshot = Items[Head];
+        Head = (Head + 1) % IM_ARRAYSIZE(Items);
+        Count--;
+        pthread_mutex_unlock(&Mutex);
+        if (waited_ms)
+            *waited_ms += (ImTimeNow() - t0) * 1000.0;
+        return snapshot;
+    }
+};
+
+// What a backend keeps between frames. The render thread must not call ImGui functions, including ImGui::MemAlloc() through ImVector<>, so this uses malloc().
+struct Renderer
+{
+    struct UploadedList { const ImDrawList* List; unsigned int ContentVersion; };
+    UploadedList    Uploaded[64];
+    int             UploadedCount;
+    unsigned char*  Staging;
+    size_t          StagingSize;
+    double          SubmitMs;
+    int             ListsUploaded, ListsTotal;
+
+    Renderer(double submit_ms)  { UploadedCount = 0; Staging = NULL; StagingSize = 0; SubmitMs = submit_ms; ListsUploaded = ListsTotal = 0; }
+    ~Renderer()                 { free(Staging); }
+
+    // 'key' identifies the buffers of the list: the list itself, or for a snapshot the list it was captured from
+    bool NeedsUpload(const ImDrawList* key, const ImDrawList* cmd_list)
+    {
+        for (int i = 0; i < UploadedCount; i++)
+            if (Uploaded[i].List == key)
+            {
+                if (cmd_list->ContentVersion != 0 && Uploaded[i].ContentVersion == cmd_list->ContentVersion)
+                    return false;
+                Uploaded[i].ContentVersion = cmd_list->ContentVersion;
+                return true;
+            }
+        if (UploadedCount < IM_ARRAYSIZE(Uploaded))
+        {
+            Uploaded[UploadedCount].List = key;
+            Uploaded[UploadedCount].ContentVersion = cmd_list->ContentVersion;
+            UploadedCount++;
+        }
+        return true;
+    }
+
+    void Submit(const ImDrawData* draw_data, const ImDrawList* const* keys)
+    {
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            ListsTotal++;
+            if (!NeedsUpload(keys[n], cmd_list))
+                continue;
+            const size_t vtx_size = (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), idx_size = (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+            if (StagingSize < vtx_size + idx_size)
+            {
+                StagingSize = vtx_size + idx_size;
+                Staging = (unsigned char*)realloc(Staging, StagingSize);
+            }
+            memcpy(Staging, cmd_list->VtxBuffer.Data, vtx_size);
+            memcpy(Staging + vtx_size, cmd_list->IdxBuffer.Data, idx_size);
+            ListsUploaded++;
+        }
+        if (SubmitMs > 0.0)
+            usleep((useconds_t)(SubmitMs * 1000.0));
+    }
+};
+
+struct RenderThreadData
+{
+    SnapshotQueue*  Ready;
+    SnapshotQueue*  Free;
+    Renderer*       Backend;
+};
+
+static void* RenderThreadMain(void* user_data)
+{
+    RenderThreadData* data = (RenderThreadData*)user_data;
+    while (ImDrawDataSnapshot* snapshot = data->Ready->Pop(NULL))
+    {
+        data->Backend->Submit(&snapshot->DrawData, snapshot->CmdListsSource.Data);
+        data->Free->Push(snapshot);
+    }
+    return NULL;
+}
+
+// Same scripted interaction as replay_example: sweep the mouse over the demo window and click down its left side
+static void NewFrameWithScriptedInputs(int frame)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const int step = frame / 30, phase = frame % 30;
+    if (phase >= 25)
+        io.MousePos = ImVec2(90.0f, 115.0f + (float)((step * 23) % 600));
+    else
+        io.MousePos = ImVec2(60.0f + (float)((frame * 7) % 550), 60.0f + (float)((frame * 13) % 640));
+    io.MouseDown[0] = (phase == 27);
+    io.MouseWheel = (frame % 97) == 0 ? -3.0f : 0.0f;
+    ImGui::NewFrame();
+    ImGui::ShowTestWindow();
+    ImGui::Render();
+}
+
+int main(int argc, char** argv)
+{
+    int frames_count = 300;
+    double submit_ms = 1.0;
+    for (int n = 1; n < argc; n++)
+    {
+        const bool has_value = n + 1 < argc;
+        if (strcmp(argv[n], "--frames") == 0 && has_value)          frames_count = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--submit-ms") == 0 && has_value)  submit_ms = atof(argv[++n]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--frames <count>] [--submit-ms <ms>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.RenderDrawListsTrackChanges = true;      // So the renderer can skip uploading the lists which didn't change
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    // Serial: submit from the UI thread, straight from ImGui::GetDrawData()
+    Renderer serial_renderer(submit_ms);
+    double t0 = ImTimeNow();
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        NewFrameWithScriptedInputs(frame);
+        serial_renderer.Submit(ImGui::GetDrawData(), ImGui::GetDrawData()->CmdLists);
+    }
+    const double serial_ms = (ImTimeNow() - t0) * 1000.0;
+
+    // Threaded: capture into a free snapshot and hand it over, the render thread submits it while we build the next frame
+    ImDrawDataSnapshot snapshots[SNAPSHOT_COUNT];
+    SnapshotQueue ready, free_snapshots;
+    for (int i = 0; i < SNAPSHOT_COUNT; i++)
+        free_snapshots.Push(&snapshots[i]);
+    Renderer threaded_renderer(submit_ms);
+    RenderThreadData thread_data = { &ready, &free_snapshots, &threaded_renderer };
+    pthread_t render_thread;
+    if (pthread_create(&render_thread, NULL, RenderThreadMain, &thread_data) != 0)
+    {
+        fprintf(stderr, "Error creating the render thread\n");
+        return 1;
+    }
+    double ui_waited_ms = 0.0;
+    t0 = ImTimeNow();
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        NewFrameWithScriptedInputs(frame);
+        ImDrawDataSnapshot* snapshot = free_snapshots.Pop(&ui_waited_ms);
+        snapshot->Capture(ImGui::GetDrawData());
+        ready.Push(snapshot);
+    }
+    ready.Push(NULL);
+    pthread_join(render_thread, NULL);
+    const double threaded_ms = (ImTimeNow() - t0) * 1000.0;
+
+    printf("%d frames, %.1f ms simulated submission per frame\n", frames_count, submit_ms);
+    printf("serial:   %.3f ms/frame, uploaded %d/%d draw lists\n", serial_ms / frames_count, serial_renderer.ListsUploaded, serial_renderer.ListsTotal);
+    printf("threaded: %.3f ms/frame, uploaded %d/%d draw lists, UI thread waited %.3f ms/frame for a free snapshot\n", threaded_ms / frames_count, threaded_renderer.ListsUploaded, threaded_renderer.ListsTotal, ui_waited_ms / frames_count);
+
+    for (int i = 0; i < SNAPSHOT_COUNT; i++)
+        snapshots[i].Clear();   // Before Shutdown(), which tears down the allocator
+    ImGui::Shutdown();
+    return 0;
+}
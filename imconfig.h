@@ -26,6 +26,17 @@
 //---- Don't define obsolete functions names
 //#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 
+//---- Make the current context pointer thread-local, so N threads can each drive their own context concurrently.
+//---- There is no default context in this mode: every thread calls SetCurrentContext(CreateContext()) first. Font atlases may be shared once built.
+//#define IMGUI_USE_THREAD_LOCAL_CONTEXT
+
+//---- Number of consecutive frames a draw list must keep far more capacity than it uses before Clear() shrinks its buffers (default: 120). 0 to never shrink.
+//---- Also the number of frames after which NewFrame() frees the draw list of a window that isn't submitted anymore.
+//#define IMGUI_DRAWLIST_TRIM_FRAMES 120
+
+//---- Don't use SSE2 intrinsics (used by text filtering when the compiler targets SSE2)
+//#define IMGUI_DISABLE_SSE
+
 //---- Pack colors to BGRA instead of RGBA (remove need to post process vertex buffer in back ends)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
@@ -628,6 +628,10 @@
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#if !defined(IMGUI_DISABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_ENABLE_SSE2
+#include <emmintrin.h>  // _mm_loadu_si128, _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
 
 #ifdef _MSC_VER
 #pragma warning (disable: 4127) // condition expression is constant
@@ -658,6 +662,8 @@
 //-------------------------------------------------------------------------
 
 static void             LogRenderedText(const ImVec2& ref_pos, const char* text, const char* text_end = NULL);
+static void             LogFlushBuffer(bool allow_async, bool finish);
+static void             WaitFileWriteJob(volatile int* pending);
 
 static void             PushMultiItemsWidths(int components, float w_full = 0.0f);
 static float            GetDraggedColumnOffset(int column_index);
@@ -672,7 +678,9 @@ static void             SetWindowPos(ImGuiWindow* window, const ImVec2& pos, ImG
 static void             SetWindowSize(ImGuiWindow* window, const ImVec2& size, ImGuiSetCond cond);
 static void             SetWindowCollapsed(ImGuiWindow* window, bool collapsed, ImGuiSetCond cond);
 static ImGuiWindow*     FindHoveredWindow(ImVec2 pos, bool excluding_childs);
-static ImGuiWindow*     CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags);
+static void             WindowGridBuild();
+static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiID id, ImVec2 size, ImGuiWindowFlags flags);
+static void             GcStaleWindows();
 static inline bool      IsWindowContentHoverable(ImGuiWindow* window);
 static void             ClearSetNextWindowData();
 static void             CheckStacksSize(ImGuiWindow* window, bool write);
@@ -686,6 +694,10 @@ static ImGuiIniData*    FindWindowSettings(const char* name);
 static ImGuiIniData*    AddWindowSettings(const char* name);
 static void             LoadIniSettingsFromDisk(const char* ini_filename);
 static void             SaveIniSettingsToDisk(const char* ini_filename);
+static bool             LoadIniSettingsBinary(const char* filename);
+static void             SaveIniSettingsBinary(const char* filename, bool allow_async);
+static void             UpdateIniSettingsFromWindows();
+static void             UpdateIniSettingsFromWindow(ImGuiWindow* window);
 static void             MarkIniSettingsDirty();
 
 static void             PushColumnClipRect(int column_index = -1);
@@ -715,6 +727,7 @@ static bool             DataTypeApplyOpFromText(const char* buf, const char* ini
 static const char*      GetClipboardTextFn_DefaultImpl(void* user_data);
 static void             SetClipboardTextFn_DefaultImpl(void* user_data, const char* text);
 static void             ImeSetInputScreenPosFn_DefaultImpl(int x, int y);
+static bool             ImFileReplace(const char* src_filename, const char* dst_filename);
 
 //-----------------------------------------------------------------------------
 // Context
@@ -722,17 +735,25 @@ static void             ImeSetInputScreenPosFn_DefaultImpl(int x, int y);
 
 // Default font atlas storage .
 // New contexts always point by default to this font atlas. It can be changed by reassigning the GetIO().Fonts variable.
+// It is shared by all contexts: when several threads use it, build it (GetTexDataAsRGBA32() etc.) before they start, it is only read afterward.
 static ImFontAtlas      GImDefaultFontAtlas;
 
 // Default context storage + current context pointer.
 // Implicitely used by all ImGui functions. Always assumed to be != NULL. Change to a different context by calling ImGui::SetCurrentContext()
 // ImGui is currently not thread-safe because of this variable. If you want thread-safety to allow N threads to access N different contexts, you might work around it by:
 // - Having multiple instances of the ImGui code compiled inside different namespace (easiest/safest, if you have a finite number of contexts)
-// - or: Changing this variable to be TLS. You may #define GImGui in imconfig.h for further custom hackery. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
+// - or: #define IMGUI_USE_THREAD_LOCAL_CONTEXT in imconfig.h to make this pointer thread-local. There is no default context then, each thread creates its own with CreateContext().
+//   Other process-wide data is either constant or only written by the thread using it, except for font atlases: build a shared atlas before using it from several threads,
+//   and set io.Fonts = NULL before calling Shutdown() on contexts which don't own it.
+// - or: You may #define GImGui in imconfig.h for further custom hackery. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
 #ifndef GImGui
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+IM_THREAD_LOCAL ImGuiContext* GImGui = NULL;
+#else
 static ImGuiContext     GImDefaultContext;
 ImGuiContext*           GImGui = &GImDefaultContext;
 #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // User facing structures
@@ -761,6 +782,7 @@ ImGuiStyle::ImGuiStyle()
     DisplayWindowPadding    = ImVec2(22,22);    // Window positions are clamped to be visible within the display area by at least this amount. Only covers regular windows.
     DisplaySafeAreaPadding  = ImVec2(4,4);      // If you cannot see the edge of your screen (e.g. on a TV) increase the safe area padding. Covers popups/tooltips as well regular windows.
     AntiAliasedLines        = true;             // Enable anti-aliasing on lines/borders. Disable if you are really short on CPU/GPU.
+    AntiAliasedLinesUseTex  = false;            // Draw thin anti-aliased lines by sampling the font texture. Requires bilinear filtering in your renderer.
     AntiAliasedShapes       = true;             // Enable anti-aliasing on filled shapes (rounded rectangles, circles, etc.)
     CurveTessellationTol    = 1.25f;            // Tessellation tolerance. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
 
@@ -837,9 +859,14 @@ ImGuiIO::ImGuiIO()
     KeyRepeatDelay = 0.250f;
     KeyRepeatRate = 0.050f;
     UserData = NULL;
+    WindowsGcFrames = 0;
+    WindowsGcTime = 0.0f;
+    WindowsGcKeepStorage = false;
 
     // User functions
     RenderDrawListsFn = NULL;
+    RenderDrawListsUseQuads = false;
+    RenderDrawListsTrackChanges = false;
     MemAllocFn = malloc;
     MemFreeFn = free;
     GetClipboardTextFn = GetClipboardTextFn_DefaultImpl;   // Platform dependent default implementations
@@ -962,6 +989,51 @@ const char* ImStristr(const char* haystack, const char* haystack_end, const char
     return NULL;
 }
 
+static inline bool ImStrEqualLower(const char* s, const char* s_lower, const char* s_lower_end)
+{
+    for (; s_lower < s_lower_end; s++, s_lower++)
+        if (ImCharToLower(*s) != *s_lower)
+            return false;
+    return true;
+}
+
+const char* ImStristrLower(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    if (!haystack_end)
+        haystack_end = haystack + strlen(haystack);
+    if (!needle_end)
+        needle_end = needle + strlen(needle);
+    const int needle_len = (int)(needle_end - needle);
+    if (needle_len == 0)
+        return haystack;
+    if (haystack_end - haystack < needle_len)
+        return NULL;
+
+    // Test the first and last characters of the needle at each position, then compare the middle of the candidates
+    const char* last = haystack_end - needle_len;
+    const char lc0 = needle[0], uc0 = ImCharToUpper(lc0);
+    const char lc1 = needle[needle_len - 1], uc1 = ImCharToUpper(lc1);
+    const char* p = haystack;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128i lv0 = _mm_set1_epi8(lc0), uv0 = _mm_set1_epi8(uc0);
+    const __m128i lv1 = _mm_set1_epi8(lc1), uv1 = _mm_set1_epi8(uc1);
+    for (; p + 15 <= last; p += 16)
+    {
+        const __m128i b0 = _mm_loadu_si128((const __m128i*)p);
+        const __m128i b1 = _mm_loadu_si128((const __m128i*)(p + needle_len - 1));
+        const __m128i m0 = _mm_or_si128(_mm_cmpeq_epi8(b0, lv0), _mm_cmpeq_epi8(b0, uv0));
+        const __m128i m1 = _mm_or_si128(_mm_cmpeq_epi8(b1, lv1), _mm_cmpeq_epi8(b1, uv1));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(m0, m1));
+        for (int n = 0; mask != 0; n++, mask >>= 1)
+            if ((mask & 1) && ImStrEqualLower(p + n + 1, needle + 1, needle_end - 1))
+                return p + n;
+    }
+#endif
+    for (; p <= last; p++)
+        if (ImCharToLower(p[0]) == lc0 && ImCharToLower(p[needle_len - 1]) == lc1 && ImStrEqualLower(p + 1, needle + 1, needle_end - 1))
+            return p;
+    return NULL;
+}
 
 // MSVC version appears to return -1 on overflow, whereas glibc appears to return total count (which may be >= buf_size). 
 // Ideally we would test for only one of those limits at runtime depending on the behavior the vsnprintf(), but trying to deduct it at compile time sounds like a pandora can of worm.
@@ -988,23 +1060,48 @@ int ImFormatStringV(char* buf, int buf_size, const char* fmt, va_list args)
     return w;
 }
 
+// CRC32 lookup table (polynomial 0xEDB88320). Constant so that no thread has to initialize it.
+static const ImU32 GCrc32LookupTable[256] =
+{
+    0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,
+    0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
+    0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,
+    0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
+    0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,
+    0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
+    0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,
+    0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
+    0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,
+    0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
+    0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,
+    0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
+    0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,
+    0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
+    0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,
+    0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
+    0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,
+    0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
+    0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,
+    0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
+    0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,
+    0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
+    0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,
+    0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
+    0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,
+    0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
+    0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,
+    0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
+    0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,
+    0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
+    0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,
+    0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
+};
+
 // Pass data_size==0 for zero-terminated strings
 // FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImU32 ImHash(const void* data, int data_size, ImU32 seed)
 {
-    static ImU32 crc32_lut[256] = { 0 };
-    if (!crc32_lut[1])
-    {
-        const ImU32 polynomial = 0xEDB88320;
-        for (ImU32 i = 0; i < 256; i++)
-        {
-            ImU32 crc = i;
-            for (ImU32 j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
-            crc32_lut[i] = crc;
-        }
-    }
-
+    const ImU32* crc32_lut = GCrc32LookupTable;
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* current = (const unsigned char*)data;
@@ -1502,7 +1599,7 @@ ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
     }
     else
     {
-        InputBuf[0] = 0;
+        InputBuf[0] = InputBufLower[0] = 0;
         CountGrep = 0;
     }
 }
@@ -1543,6 +1640,11 @@ void ImGuiTextFilter::Build()
     TextRange input_range(InputBuf, InputBuf+strlen(InputBuf));
     input_range.split(',', Filters);
 
+    // Lower-case the terms once so PassFilter() only needs to fold the tested text
+    for (int i = 0; i < IM_ARRAYSIZE(InputBufLower); i++)
+        if ((InputBufLower[i] = ImCharToLower(InputBuf[i])) == 0)
+            break;
+
     CountGrep = 0;
     for (int i = 0; i != Filters.Size; i++)
     {
@@ -1561,22 +1663,26 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
 
     for (int i = 0; i != Filters.Size; i++)
     {
         const TextRange& f = Filters[i];
         if (f.empty())
             continue;
+        const char* f_lower_begin = InputBufLower + (f.begin() - InputBuf);
+        const char* f_lower_end = InputBufLower + (f.end() - InputBuf);
         if (f.front() == '-')
         {
             // Subtract
-            if (ImStristr(text, text_end, f.begin()+1, f.end()) != NULL)
+            if (ImStristrLower(text, text_end, f_lower_begin+1, f_lower_end) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.begin(), f.end()) != NULL)
+            if (ImStristrLower(text, text_end, f_lower_begin, f_lower_end) != NULL)
                 return true;
         }
     }
@@ -1588,6 +1694,107 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTextFilterCache
+//-----------------------------------------------------------------------------
+
+// Return true if every text passing 'new_filter' also passes 'old_filter', so only the items which passed before need to be tested again.
+// This is the case when characters were appended to the last term without starting a new term, and that term was an inclusive one.
+static bool TextFilterIsNarrowing(const char* old_filter, const ImGuiTextFilter& new_filter)
+{
+    const char* old_end = old_filter + strlen(old_filter);
+    if (strncmp(new_filter.InputBuf, old_filter, (size_t)(old_end - old_filter)) != 0 || strchr(new_filter.InputBuf + (old_end - old_filter), ',') != NULL)
+        return false;
+    const char* last_term = old_filter;
+    for (const char* p = old_filter; p < old_end; p++)
+        if (*p == ',')
+            last_term = p + 1;
+    bool any_term = false;
+    for (const char* p = old_filter; p < old_end; p++)
+        if (*p != ',' && !ImGuiTextFilter::TextRange::is_blank(*p))
+            any_term = true;
+    if (!any_term)
+        return true;    // Nothing was filtered out
+    ImGuiTextFilter::TextRange last_range(last_term, old_end);
+    last_range.trim_blanks();
+    return !last_range.empty() && last_range.front() != '-';
+}
+
+const ImVector<int>& ImGuiTextFilterCache::Update(const ImGuiTextFilter& filter, int items_count, bool (*items_getter)(void* data, int idx, const char** out_text), void* data)
+{
+    if (items_count < ItemsCount)
+        Clear();
+
+    bool rebuild_indices = false;
+    if (strcmp(FilterBuf, filter.InputBuf) != 0)
+    {
+        if (TextFilterIsNarrowing(FilterBuf, filter))
+        {
+            // Re-test the items which passed, in place
+            int dst = 0;
+            for (int n = 0; n < Indices.Size; n++)
+            {
+                const int idx = Indices[n];
+                const char* text;
+                if (items_getter(data, idx, &text) && filter.PassFilter(text))
+                    Indices[dst++] = idx;
+                else
+                    Bits[idx >> 5] &= ~(1u << (idx & 31));
+            }
+            Indices.resize(dst);
+        }
+        else
+        {
+            ItemsCount = 0;
+            Indices.resize(0);
+            InvalidatedItems.resize(0);
+        }
+        ImStrncpy(FilterBuf, filter.InputBuf, IM_ARRAYSIZE(FilterBuf));
+    }
+
+    // Re-test items which changed
+    for (int n = 0; n < InvalidatedItems.Size; n++)
+    {
+        const int idx = InvalidatedItems[n];
+        if (idx >= ItemsCount)
+            continue;
+        const char* text;
+        const bool pass = items_getter(data, idx, &text) && filter.PassFilter(text);
+        if (pass != PassFilter(idx))
+        {
+            Bits[idx >> 5] ^= (1u << (idx & 31));
+            rebuild_indices = true;
+        }
+    }
+    InvalidatedItems.resize(0);
+    if (rebuild_indices)
+    {
+        Indices.resize(0);
+        for (int idx = 0; idx < ItemsCount; idx++)
+            if (PassFilter(idx))
+                Indices.push_back(idx);
+    }
+
+    // Test new items
+    if (items_count > ItemsCount)
+    {
+        Bits.resize((items_count + 31) >> 5);
+        for (int n = ItemsCount >> 5; n < Bits.Size; n++)
+            Bits[n] &= (n == (ItemsCount >> 5)) ? ((1u << (ItemsCount & 31)) - 1) : 0;
+        for (int idx = ItemsCount; idx < items_count; idx++)
+        {
+            const char* text;
+            if (items_getter(data, idx, &text) && filter.PassFilter(text))
+            {
+                Bits[idx >> 5] |= (1u << (idx & 31));
+                Indices.push_back(idx);
+            }
+        }
+        ItemsCount = items_count;
+    }
+    return Indices;
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -1628,6 +1835,302 @@ void ImGuiTextBuffer::append(const char* fmt, ...)
     va_end(args);
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTextRope
+//-----------------------------------------------------------------------------
+
+static int ImTextCountLines(const char* text, const char* text_end)
+{
+    int count = 0;
+    while (text < text_end && (text = (const char*)memchr(text, '\n', (size_t)(text_end - text))) != NULL)
+    {
+        count++;
+        text++;
+    }
+    return count;
+}
+
+// Return where the first chunk carved from [text, text_end) should end: after a '\n' close to IM_TEXTROPE_CHUNK_SIZE bytes, or text_end if there is none.
+static const char* ImTextRopeFindChunkEnd(const char* text, const char* text_end)
+{
+    if (text_end - text <= IM_TEXTROPE_CHUNK_SIZE)
+        return text_end;
+    for (const char* p = text + IM_TEXTROPE_CHUNK_SIZE - 1; p >= text; p--)
+        if (*p == '\n')
+            return p + 1;
+    const char* p = (const char*)memchr(text + IM_TEXTROPE_CHUNK_SIZE, '\n', (size_t)(text_end - text - IM_TEXTROPE_CHUNK_SIZE));
+    return p ? p + 1 : text_end;
+}
+
+static void ImTextRopeChunkReserve(ImGuiTextRope::Chunk& chunk, int new_capacity)
+{
+    if (new_capacity <= chunk.Capacity)
+        return;
+    char* new_data = (char*)ImGui::MemAlloc((size_t)new_capacity);
+    if (chunk.Data)
+    {
+        memcpy(new_data, chunk.Data, (size_t)chunk.Size);
+        ImGui::MemFree(chunk.Data);
+    }
+    chunk.Data = new_data;
+    chunk.Capacity = new_capacity;
+}
+
+ImGuiTextRope::ImGuiTextRope(const char* text, const char* text_end)
+{
+    SetText(text ? text : "", text_end);
+}
+
+ImGuiTextRope::~ImGuiTextRope()
+{
+    for (int i = 0; i < Chunks.Size; i++)
+        ImGui::MemFree(Chunks[i].Data);
+}
+
+void ImGuiTextRope::Clear()
+{
+    SetText("");
+}
+
+void ImGuiTextRope::SetText(const char* text, const char* text_end)
+{
+    if (!text_end)
+        text_end = text + strlen(text);
+    for (int i = 0; i < Chunks.Size; i++)
+        ImGui::MemFree(Chunks[i].Data);
+    Chunks.resize(0);
+    InsertChunks(0, text, text_end);
+    if (Chunks.empty())
+    {
+        Chunk empty_chunk = { NULL, 0, 0, 0 };
+        Chunks.push_back(empty_chunk);
+    }
+    UpdateIndex(0);
+}
+
+// Carve [text, text_end) into new chunks inserted at 'chunk_idx'. Doesn't update the index.
+void ImGuiTextRope::InsertChunks(int chunk_idx, const char* text, const char* text_end)
+{
+    int new_count = 0;
+    for (const char* p = text; p < text_end; p = ImTextRopeFindChunkEnd(p, text_end))
+        new_count++;
+    if (new_count == 0)
+        return;
+
+    const int old_count = Chunks.Size;
+    Chunks.resize(old_count + new_count);
+    if (chunk_idx < old_count)
+        memmove(Chunks.Data + chunk_idx + new_count, Chunks.Data + chunk_idx, (size_t)(old_count - chunk_idx) * sizeof(Chunk));
+    for (const char* p = text; p < text_end; chunk_idx++)
+    {
+        const char* p_end = ImTextRopeFindChunkEnd(p, text_end);
+        Chunk& chunk = Chunks[chunk_idx];
+        chunk.Size = (int)(p_end - p);
+        chunk.Capacity = chunk.Size;
+        chunk.Data = (char*)ImGui::MemAlloc((size_t)chunk.Size);
+        chunk.LinesCount = ImTextCountLines(p, p_end);
+        memcpy(chunk.Data, p, (size_t)chunk.Size);
+        p = p_end;
+    }
+}
+
+// Split a chunk which grew past IM_TEXTROPE_CHUNK_SIZE. Doesn't update the index.
+void ImGuiTextRope::SplitChunk(int chunk_idx)
+{
+    if (Chunks[chunk_idx].Size <= IM_TEXTROPE_CHUNK_SIZE)
+        return;
+    const char* data = Chunks[chunk_idx].Data;
+    const char* data_end = data + Chunks[chunk_idx].Size;
+    const char* split = ImTextRopeFindChunkEnd(data, data_end);
+    if (split == data_end)
+        return;
+    InsertChunks(chunk_idx + 1, split, data_end);
+
+    Chunk& chunk = Chunks[chunk_idx];
+    chunk.Size = (int)(split - data);
+    chunk.LinesCount = ImTextCountLines(data, split);
+    if (chunk.Capacity > chunk.Size * 2 + IM_TEXTROPE_CHUNK_SIZE)
+    {
+        // Release the memory of a large insertion
+        char* new_data = (char*)ImGui::MemAlloc((size_t)chunk.Size);
+        memcpy(new_data, chunk.Data, (size_t)chunk.Size);
+        ImGui::MemFree(chunk.Data);
+        chunk.Data = new_data;
+        chunk.Capacity = chunk.Size;
+    }
+}
+
+// Update prefix sums from 'chunk_idx' onward
+void ImGuiTextRope::UpdateIndex(int chunk_idx)
+{
+    ChunksOffset.resize(Chunks.Size + 1);
+    ChunksLine.resize(Chunks.Size + 1);
+    if (chunk_idx == 0)
+        ChunksOffset[0] = ChunksLine[0] = 0;
+    for (int i = chunk_idx; i < Chunks.Size; i++)
+    {
+        ChunksOffset[i + 1] = ChunksOffset[i] + Chunks[i].Size;
+        ChunksLine[i + 1] = ChunksLine[i] + Chunks[i].LinesCount;
+    }
+}
+
+void ImGuiTextRope::Insert(int offset, const char* text, const char* text_end)
+{
+    IM_ASSERT(offset >= 0 && offset <= GetSize());
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int len = (int)(text_end - text);
+    if (len == 0)
+        return;
+
+    const int chunk_idx = FindChunkFromOffset(offset);
+    Chunk& chunk = Chunks[chunk_idx];
+    const int local_offset = offset - ChunksOffset[chunk_idx];
+    ImTextRopeChunkReserve(chunk, ImMax(chunk.Size + len, chunk.Capacity * 2));
+    memmove(chunk.Data + local_offset + len, chunk.Data + local_offset, (size_t)(chunk.Size - local_offset));
+    memcpy(chunk.Data + local_offset, text, (size_t)len);
+    chunk.Size += len;
+    chunk.LinesCount += ImTextCountLines(text, text_end);
+    SplitChunk(chunk_idx);
+    UpdateIndex(chunk_idx);
+}
+
+void ImGuiTextRope::Erase(int offset, int size)
+{
+    IM_ASSERT(offset >= 0 && size >= 0 && offset + size <= GetSize());
+    if (size <= 0)
+        return;
+
+    // Remove bytes from each chunk overlapped by the range
+    const int first_chunk_idx = FindChunkFromOffset(offset);
+    int chunk_idx = first_chunk_idx;
+    int local_offset = offset - ChunksOffset[chunk_idx];
+    while (size > 0)
+    {
+        Chunk& chunk = Chunks[chunk_idx];
+        const int n = ImMin(size, chunk.Size - local_offset);
+        chunk.LinesCount -= ImTextCountLines(chunk.Data + local_offset, chunk.Data + local_offset + n);
+        memmove(chunk.Data + local_offset, chunk.Data + local_offset + n, (size_t)(chunk.Size - local_offset - n));
+        chunk.Size -= n;
+        size -= n;
+        local_offset = 0;
+        chunk_idx++;
+    }
+
+    // Remove emptied chunks
+    for (int i = chunk_idx - 1; i >= first_chunk_idx; i--)
+        if (Chunks[i].Size == 0 && Chunks.Size > 1)
+        {
+            ImGui::MemFree(Chunks[i].Data);
+            Chunks.erase(Chunks.begin() + i);
+        }
+
+    // Restore the invariant that every chunk but the last one ends with '\n' by merging with the next chunk, which also coalesces small chunks
+    if (first_chunk_idx + 1 < Chunks.Size)
+    {
+        Chunk& chunk = Chunks[first_chunk_idx];
+        const Chunk& next_chunk = Chunks[first_chunk_idx + 1];
+        if (chunk.Size == 0 || chunk.Data[chunk.Size - 1] != '\n' || chunk.Size + next_chunk.Size <= IM_TEXTROPE_CHUNK_SIZE / 2)
+        {
+            ImTextRopeChunkReserve(chunk, chunk.Size + next_chunk.Size);
+            memcpy(chunk.Data + chunk.Size, next_chunk.Data, (size_t)next_chunk.Size);
+            chunk.Size += next_chunk.Size;
+            chunk.LinesCount += next_chunk.LinesCount;
+            ImGui::MemFree(next_chunk.Data);
+            Chunks.erase(Chunks.begin() + first_chunk_idx + 1);
+            SplitChunk(first_chunk_idx);
+        }
+    }
+    UpdateIndex(ImMin(first_chunk_idx, Chunks.Size - 1));
+}
+
+int ImGuiTextRope::CopyText(int offset, int size, char* out_buf) const
+{
+    offset = ImClamp(offset, 0, GetSize());
+    size = ImClamp(size, 0, GetSize() - offset);
+    int copied = 0;
+    for (int chunk_idx = FindChunkFromOffset(offset); copied < size; chunk_idx++)
+    {
+        const Chunk& chunk = Chunks[chunk_idx];
+        const int local_offset = offset + copied - ChunksOffset[chunk_idx];
+        const int n = ImMin(size - copied, chunk.Size - local_offset);
+        memcpy(out_buf + copied, chunk.Data + local_offset, (size_t)n);
+        copied += n;
+    }
+    return copied;
+}
+
+char ImGuiTextRope::GetChar(int offset) const
+{
+    if (offset < 0 || offset >= GetSize())
+        return 0;
+    const int chunk_idx = FindChunkFromOffset(offset);
+    return Chunks[chunk_idx].Data[offset - ChunksOffset[chunk_idx]];
+}
+
+int ImGuiTextRope::FindChunkFromOffset(int offset) const
+{
+    int lo = 0, hi = Chunks.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (ChunksOffset[mid] <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+int ImGuiTextRope::FindChunkFromLine(int line) const
+{
+    int lo = 0, hi = Chunks.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (ChunksLine[mid] <= line)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+const char* ImGuiTextRope::GetLineText(int line, const char** out_line_end) const
+{
+    IM_ASSERT(line >= 0 && line < GetLinesCount());
+    const int chunk_idx = FindChunkFromLine(line);
+    const Chunk& chunk = Chunks[chunk_idx];
+    if (chunk.Size == 0)
+    {
+        *out_line_end = "";
+        return *out_line_end;
+    }
+    const char* p = chunk.Data;
+    const char* p_end = chunk.Data + chunk.Size;
+    for (int n = line - ChunksLine[chunk_idx]; n > 0; n--)
+        p = (const char*)memchr(p, '\n', (size_t)(p_end - p)) + 1;
+    const char* line_end = (const char*)memchr(p, '\n', (size_t)(p_end - p));
+    *out_line_end = line_end ? line_end : p_end;
+    return p;
+}
+
+int ImGuiTextRope::GetLineStart(int line) const
+{
+    const int chunk_idx = FindChunkFromLine(line);
+    const char* line_end;
+    const char* line_begin = GetLineText(line, &line_end);
+    return ChunksOffset[chunk_idx] + (Chunks[chunk_idx].Size > 0 ? (int)(line_begin - Chunks[chunk_idx].Data) : 0);
+}
+
+int ImGuiTextRope::GetLineFromOffset(int offset) const
+{
+    offset = ImClamp(offset, 0, GetSize());
+    const int chunk_idx = FindChunkFromOffset(offset);
+    const char* data = Chunks[chunk_idx].Data;
+    return ChunksLine[chunk_idx] + (data ? ImTextCountLines(data, data + offset - ChunksOffset[chunk_idx]) : 0);
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiSimpleColumns
 //-----------------------------------------------------------------------------
@@ -1760,10 +2263,10 @@ bool ImGuiListClipper::Step()
 // ImGuiWindow
 //-----------------------------------------------------------------------------
 
-ImGuiWindow::ImGuiWindow(const char* name)
+ImGuiWindow::ImGuiWindow(const char* name, ImGuiID id)
 {
     Name = ImStrdup(name);
-    ID = ImHash(name, 0);
+    ID = id;
     IDStack.push_back(ID);
     MoveId = GetID("#MOVE");
 
@@ -1783,6 +2286,7 @@ ImGuiWindow::ImGuiWindow(const char* name)
     Accessed = false;
     Collapsed = false;
     SkipItems = false;
+    SkipItemsOffscreen = false;
     BeginCount = 0;
     PopupId = 0;
     AutoFitFramesX = AutoFitFramesY = -1;
@@ -1793,6 +2297,7 @@ ImGuiWindow::ImGuiWindow(const char* name)
     SetWindowPosCenterWanted = false;
 
     LastFrameActive = -1;
+    LastTimeActive = -1.0f;
     ItemWidthDefault = 0.0f;
     FontWindowScale = 1.0f;
 
@@ -1839,6 +2344,16 @@ ImGuiID ImGuiWindow::GetIDNoKeepAlive(const char* str, const char* str_end)
     return ImHash(str, str_end ? (int)(str_end - str) : 0, seed);
 }
 
+int ImGuiWindow::GetRetainedBytes() const
+{
+    int bytes = (int)sizeof(ImGuiWindow) + (int)strlen(Name) + 1 + (int)sizeof(ImDrawList) + DrawList->GetRetainedBytes();
+    bytes += IDStack.Capacity * (int)sizeof(ImGuiID) + StateStorage.Data.Capacity * (int)sizeof(ImGuiStorage::Pair);
+    bytes += DC.ChildWindows.Capacity * (int)sizeof(ImGuiWindow*) + DC.ItemWidthStack.Capacity * (int)sizeof(float) + DC.TextWrapPosStack.Capacity * (int)sizeof(float);
+    bytes += DC.AllowKeyboardFocusStack.Capacity * (int)sizeof(bool) + DC.ButtonRepeatStack.Capacity * (int)sizeof(bool) + DC.GroupStack.Capacity * (int)sizeof(ImGuiGroupData);
+    bytes += DC.ColumnsData.Capacity * (int)sizeof(ImGuiColumnData);
+    return bytes;
+}
+
 //-----------------------------------------------------------------------------
 // Internal API exposed in imgui_internal.h
 //-----------------------------------------------------------------------------
@@ -2033,106 +2548,844 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 
 //-----------------------------------------------------------------------------
 
-void* ImGui::MemAlloc(size_t sz)
+// Process-wide list of the pools holding chunks (see ImGuiMemPool). The lock is only taken when a pool gains or loses chunks, and by remote frees.
+static ImGuiMemPool*    GImMemPools = NULL;
+static volatile int     GImMemPoolsCount = 0;
+static volatile int     GImMemPoolsLock = 0;
+
+static void MemPoolsLock()
 {
-    GImGui->IO.MetricsAllocs++;
-    return GImGui->IO.MemAllocFn(sz);
+    while (ImAtomicExchange(&GImMemPoolsLock, 1))
+        ImThreadYield();
 }
 
-void ImGui::MemFree(void* ptr)
+static void MemPoolsUnlock()
 {
-    if (ptr) GImGui->IO.MetricsAllocs--;
-    return GImGui->IO.MemFreeFn(ptr);
+    ImAtomicStore(&GImMemPoolsLock, 0);
 }
 
-const char* ImGui::GetClipboardText()
+static void MemPoolsUnlink(ImGuiMemPool* pool)
 {
-    return GImGui->IO.GetClipboardTextFn ? GImGui->IO.GetClipboardTextFn(GImGui->IO.ClipboardUserData) : "";
+    for (ImGuiMemPool** p = &GImMemPools; *p; p = &(*p)->Next)
+        if (*p == pool)
+        {
+            *p = pool->Next;
+            pool->Next = NULL;
+            ImAtomicStore(&GImMemPoolsCount, GImMemPoolsCount - 1);
+            return;
+        }
 }
 
-void ImGui::SetClipboardText(const char* text)
+ImGuiMemPool::~ImGuiMemPool()
 {
-    if (GImGui->IO.SetClipboardTextFn)
-        GImGui->IO.SetClipboardTextFn(GImGui->IO.ClipboardUserData, text);
+    if (Chunks == NULL)
+        return;
+    MemPoolsLock();
+    while (RemoteFreeList)
+    {
+        void* next = *(void**)RemoteFreeList;
+        Free(RemoteFreeList);
+        RemoteFreeList = next;
+    }
+    TrimLocked();
+    if (ChunksCount == 0)
+    {
+        MemPoolsUnlock();
+        return;
+    }
+
+    // Blocks are still in use: move the chunks to an orphan pool, released as they get freed (see FreeRemote())
+    ImGuiMemPool* orphan = (ImGuiMemPool*)malloc(sizeof(ImGuiMemPool));
+    IM_PLACEMENT_NEW(orphan) ImGuiMemPool();
+    orphan->Chunks = Chunks;
+    orphan->ChunksCount = ChunksCount;
+    orphan->ChunksCapacity = ChunksCapacity;
+    orphan->FreeFn = FreeFn;
+    orphan->Orphan = true;
+    for (ImGuiMemPool** p = &GImMemPools; *p; p = &(*p)->Next)
+        if (*p == this)
+        {
+            *p = orphan;
+            orphan->Next = Next;
+            break;
+        }
+    Chunks = NULL;
+    ChunksCount = ChunksCapacity = 0;
+    MemPoolsUnlock();
 }
 
-const char* ImGui::GetVersion()
+void* ImGuiMemPool::Alloc(size_t sz)
 {
-    return IMGUI_VERSION;
+    if (sz == 0 || sz > ((size_t)16 << (IM_MEMPOOL_CLASS_COUNT - 1)))
+        return NULL;
+    if (ImAtomicLoad(&RemoteFreesPending))
+        TakeRemoteFrees();
+    int size_class = 0;
+    while (((size_t)16 << size_class) < sz)
+        size_class++;
+    const int block_size = 16 << size_class;
+    const int blocks_per_chunk = IM_MEMPOOL_CHUNK_SIZE / block_size;
+
+    // Find a chunk of the right class with a free block, starting with the one we used last
+    ImGuiMemPoolChunk* chunk = NULL;
+    int hint = LastChunk[size_class];
+    if (hint >= 0 && hint < ChunksCount && Chunks[hint].SizeClass == size_class && (Chunks[hint].FreeList || Chunks[hint].BlocksCarved < blocks_per_chunk))
+        chunk = &Chunks[hint];
+    for (int n = 0; n < ChunksCount && !chunk; n++)
+        if (Chunks[n].SizeClass == size_class && (Chunks[n].FreeList || Chunks[n].BlocksCarved < blocks_per_chunk))
+            chunk = &Chunks[n];
+
+    if (!chunk)
+    {
+        ImGuiIO& io = GImGui->IO;
+        char* data = (char*)io.MemAllocFn(IM_MEMPOOL_CHUNK_SIZE);
+        if (!data)
+            return NULL;
+        ImGuiMemPoolChunk* new_chunks = NULL;
+        if (ChunksCount == ChunksCapacity)
+            new_chunks = (ImGuiMemPoolChunk*)io.MemAllocFn((size_t)(ChunksCapacity ? ChunksCapacity * 2 : 16) * sizeof(ImGuiMemPoolChunk));
+
+        // Other threads may be looking up our chunks (see FreeRemote())
+        MemPoolsLock();
+        if (ChunksCount == 0)
+        {
+            FreeFn = io.MemFreeFn;
+            Next = GImMemPools;
+            GImMemPools = this;
+            ImAtomicStore(&GImMemPoolsCount, GImMemPoolsCount + 1);
+        }
+        if (new_chunks)
+        {
+            if (Chunks)
+                memcpy(new_chunks, Chunks, (size_t)ChunksCount * sizeof(ImGuiMemPoolChunk));
+            io.MemFreeFn(Chunks);
+            Chunks = new_chunks;
+            ChunksCapacity = ChunksCapacity ? ChunksCapacity * 2 : 16;
+        }
+
+        // Sorted insertion by address
+        int insert_n = 0;
+        while (insert_n < ChunksCount && Chunks[insert_n].Data < data)
+            insert_n++;
+        memmove(Chunks + insert_n + 1, Chunks + insert_n, (size_t)(ChunksCount - insert_n) * sizeof(ImGuiMemPoolChunk));
+        ChunksCount++;
+        for (int n = 0; n < IM_MEMPOOL_CLASS_COUNT; n++)
+            LastChunk[n] = -1;
+        chunk = &Chunks[insert_n];
+        chunk->Data = data;
+        chunk->FreeList = NULL;
+        chunk->SizeClass = size_class;
+        chunk->BlocksUsed = chunk->BlocksCarved = 0;
+        MemPoolsUnlock();
+    }
+    LastChunk[size_class] = (int)(chunk - Chunks);
+
+    void* ptr;
+    if (chunk->FreeList)
+    {
+        ptr = chunk->FreeList;
+        chunk->FreeList = *(void**)ptr;
+    }
+    else
+    {
+        ptr = chunk->Data + chunk->BlocksCarved * block_size;
+        chunk->BlocksCarved++;
+    }
+    chunk->BlocksUsed++;
+    return ptr;
 }
 
-// Internal state access - if you want to share ImGui state between modules (e.g. DLL) or allocate it yourself
-// Note that we still point to some static data and members (such as GFontAtlas), so the state instance you end up using will point to the static data within its module
-ImGuiContext* ImGui::GetCurrentContext()
+// Binary search the chunk owning ptr
+int ImGuiMemPool::FindChunk(const void* ptr) const
 {
-    return GImGui;
+    const char* p = (const char*)ptr;
+    int lo = 0, hi = ChunksCount - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) >> 1;
+        if (p < Chunks[mid].Data)
+            hi = mid - 1;
+        else if (p >= Chunks[mid].Data + IM_MEMPOOL_CHUNK_SIZE)
+            lo = mid + 1;
+        else
+            return mid;
+    }
+    return -1;
 }
 
-void ImGui::SetCurrentContext(ImGuiContext* ctx)
+bool ImGuiMemPool::Free(void* ptr)
 {
-#ifdef IMGUI_SET_CURRENT_CONTEXT_FUNC
-    IMGUI_SET_CURRENT_CONTEXT_FUNC(ctx); // For custom thread-based hackery you may want to have control over this.
-#else
-    GImGui = ctx;
-#endif
+    int chunk_n = FindChunk(ptr);
+    if (chunk_n < 0)
+        return false;
+    ImGuiMemPoolChunk* chunk = &Chunks[chunk_n];
+    *(void**)ptr = chunk->FreeList;
+    chunk->FreeList = ptr;
+    chunk->BlocksUsed--;
+    return true;
 }
 
-ImGuiContext* ImGui::CreateContext(void* (*malloc_fn)(size_t), void (*free_fn)(void*))
+void ImGuiMemPool::TakeRemoteFrees()
 {
-    if (!malloc_fn) malloc_fn = malloc;
-    ImGuiContext* ctx = (ImGuiContext*)malloc_fn(sizeof(ImGuiContext));
-    IM_PLACEMENT_NEW(ctx) ImGuiContext();
-    ctx->IO.MemAllocFn = malloc_fn;
-    ctx->IO.MemFreeFn = free_fn ? free_fn : free;
-    return ctx;
+    MemPoolsLock();
+    void* list = RemoteFreeList;
+    RemoteFreeList = NULL;
+    ImAtomicStore(&RemoteFreesPending, 0);
+    MemPoolsUnlock();
+    while (list)
+    {
+        void* next = *(void**)list;
+        Free(list);
+        list = next;
+    }
 }
 
-void ImGui::DestroyContext(ImGuiContext* ctx)
+bool ImGuiMemPool::FreeRemote(void* ptr)
 {
-    void (*free_fn)(void*) = ctx->IO.MemFreeFn;
-    ctx->~ImGuiContext();
-    free_fn(ctx);
-    if (GImGui == ctx)
-        SetCurrentContext(NULL);
+    if (ImAtomicLoad(&GImMemPoolsCount) == 0)
+        return false;
+    MemPoolsLock();
+    ImGuiMemPool* pool = GImMemPools;
+    while (pool && pool->FindChunk(ptr) < 0)
+        pool = pool->Next;
+    if (pool && pool->Orphan)
+    {
+        pool->Free(ptr);
+        pool->TrimLocked();
+        if (pool->ChunksCount == 0)
+            free(pool);
+    }
+    else if (pool)
+    {
+        *(void**)ptr = pool->RemoteFreeList;
+        pool->RemoteFreeList = ptr;
+        ImAtomicStore(&pool->RemoteFreesPending, 1);
+    }
+    MemPoolsUnlock();
+    return pool != NULL;
 }
 
-ImGuiIO& ImGui::GetIO()
+void ImGuiMemPool::Trim()
 {
-    return GImGui->IO;
+    if (Chunks == NULL)     // Nothing to release (also avoids locking from ~ImGuiContext() after Shutdown())
+        return;
+    if (ImAtomicLoad(&RemoteFreesPending))
+        TakeRemoteFrees();
+    MemPoolsLock();
+    TrimLocked();
+    MemPoolsUnlock();
 }
 
-ImGuiStyle& ImGui::GetStyle()
+// Release empty chunks, and leave the process-wide list once we hold none. The list lock must be held.
+void ImGuiMemPool::TrimLocked()
 {
-    return GImGui->Style;
+    int dst_n = 0;
+    for (int n = 0; n < ChunksCount; n++)
+    {
+        if (Chunks[n].BlocksUsed == 0)
+            FreeFn(Chunks[n].Data);
+        else
+            Chunks[dst_n++] = Chunks[n];
+    }
+    ChunksCount = dst_n;
+    for (int n = 0; n < IM_MEMPOOL_CLASS_COUNT; n++)
+        LastChunk[n] = -1;
+    if (ChunksCount == 0 && Chunks)
+    {
+        MemPoolsUnlink(this);
+        FreeFn(Chunks);
+        Chunks = NULL;
+        ChunksCapacity = 0;
+    }
 }
 
-// Same value as passed to your RenderDrawListsFn() function. valid after Render() and until the next call to NewFrame()
-ImDrawData* ImGui::GetDrawData()
+void* ImGuiMemFrameArena::Alloc(size_t sz)
 {
-    return GImGui->RenderDrawData.Valid ? &GImGui->RenderDrawData : NULL;
+    sz = (sz + 15) & ~(size_t)15;
+    if (Size + sz <= Capacity)
+    {
+        void* ptr = Data + Size;
+        Size += sz;
+        return ptr;
+    }
+
+    // Arena is full: chain a separate block, we will regrow on the next Rewind()
+    char* block = (char*)GImGui->IO.MemAllocFn(sz + 16);
+    *(void**)block = Overflow;
+    Overflow = block;
+    OverflowSize += sz;
+    return block + 16;
 }
 
-float ImGui::GetTime()
+static size_t MemFrameArenaCapacityForPeak(size_t peak_size)
 {
-    return GImGui->Time;
+    size_t capacity = peak_size + peak_size / 2;
+    if (capacity < IM_MEMFRAMEARENA_MIN_CAPACITY)
+        capacity = IM_MEMFRAMEARENA_MIN_CAPACITY;
+    return (capacity + 4095) & ~(size_t)4095;
 }
 
-int ImGui::GetFrameCount()
+void ImGuiMemFrameArena::Rewind()
 {
-    return GImGui->FrameCount;
+    // Shrink only once the arena stayed mostly unused for a while, and only if that at least halves it: never below the minimum capacity, which an idle arena keeps.
+    const size_t peak_size = Size + OverflowSize;
+    const size_t shrunk_capacity = MemFrameArenaCapacityForPeak(peak_size);
+    UnderusedFrames = (peak_size * 4 < Capacity && shrunk_capacity * 2 <= Capacity) ? UnderusedFrames + 1 : 0;
+    if (Overflow || UnderusedFrames > 120)
+    {
+        Clear();
+        Capacity = shrunk_capacity;
+        Data = (char*)GImGui->IO.MemAllocFn(Capacity);
+    }
+    Size = 0;
 }
 
-void ImGui::NewFrame()
+void ImGuiMemFrameArena::Clear()
 {
-    ImGuiContext& g = *GImGui;
-
-    // Check user data
-    IM_ASSERT(g.IO.DeltaTime >= 0.0f);               // Need a positive DeltaTime (zero is tolerated but will cause some timing issues)
+    if (Data == NULL && Overflow == NULL)
+        return;
+    ImGuiIO& io = GImGui->IO;
+    while (Overflow)
+    {
+        void* next = *(void**)Overflow;
+        io.MemFreeFn(Overflow);
+        Overflow = next;
+    }
+    if (Data)
+        io.MemFreeFn(Data);
+    Data = NULL;
+    Size = Capacity = OverflowSize = 0;
+    UnderusedFrames = 0;
+}
+
+void* ImGui::MemAlloc(size_t sz)
+{
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+    if (!GImGui)            // No context on this thread (e.g. building a shared font atlas, or static destructors)
+        return malloc(sz);
+#endif
+    ImGuiContext& g = *GImGui;
+    g.IO.MetricsAllocs++;
+    g.MemFrameAllocs++;
+    g.MemFrameAllocsBytes += (int)sz;
+    if (g.IO.MemUsePools)
+        if (void* ptr = g.MemPool.Alloc(sz))
+            return ptr;
+    return g.IO.MemAllocFn(sz);
+}
+
+void ImGui::MemFree(void* ptr)
+{
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+    if (!GImGui)
+    {
+        if (!ImGuiMemPool::FreeRemote(ptr))     // e.g. a shared font atlas built with a context using pools
+            free(ptr);
+        return;
+    }
+#endif
+    ImGuiContext& g = *GImGui;
+    if (ptr) g.IO.MetricsAllocs--;
+    if (ptr && g.MemPool.ChunksCount > 0 && g.MemPool.Free(ptr))   // Pool may still own blocks after io.MemUsePools got cleared
+        return;
+    if (ptr && ImGuiMemPool::FreeRemote(ptr))                       // Allocated while another context was current
+        return;
+    return g.IO.MemFreeFn(ptr);
+}
+
+void* ImGui::MemAllocFrame(size_t sz)
+{
+    ImGuiContext& g = *GImGui;
+    g.MemFrameAllocs++;
+    g.MemFrameAllocsBytes += (int)sz;
+    return g.MemFrameArena.Alloc(sz);
+}
+
+void ImGui::MemTrim()
+{
+    GImGui->MemPool.Trim();
+}
+
+const char* ImGui::GetClipboardText()
+{
+    return GImGui->IO.GetClipboardTextFn ? GImGui->IO.GetClipboardTextFn(GImGui->IO.ClipboardUserData) : "";
+}
+
+void ImGui::SetClipboardText(const char* text)
+{
+    if (GImGui->IO.SetClipboardTextFn)
+        GImGui->IO.SetClipboardTextFn(GImGui->IO.ClipboardUserData, text);
+}
+
+const char* ImGui::GetVersion()
+{
+    return IMGUI_VERSION;
+}
+
+// Internal state access - if you want to share ImGui state between modules (e.g. DLL) or allocate it yourself
+// Note that we still point to some static data and members (such as GFontAtlas), so the state instance you end up using will point to the static data within its module
+ImGuiContext* ImGui::GetCurrentContext()
+{
+    return GImGui;
+}
+
+void ImGui::SetCurrentContext(ImGuiContext* ctx)
+{
+#ifdef IMGUI_SET_CURRENT_CONTEXT_FUNC
+    IMGUI_SET_CURRENT_CONTEXT_FUNC(ctx); // For custom thread-based hackery you may want to have control over this.
+#else
+    GImGui = ctx;
+#endif
+}
+
+ImGuiContext* ImGui::CreateContext(void* (*malloc_fn)(size_t), void (*free_fn)(void*))
+{
+    if (!malloc_fn) malloc_fn = malloc;
+    ImGuiContext* ctx = (ImGuiContext*)malloc_fn(sizeof(ImGuiContext));
+    IM_PLACEMENT_NEW(ctx) ImGuiContext();
+    ctx->IO.MemAllocFn = malloc_fn;
+    ctx->IO.MemFreeFn = free_fn ? free_fn : free;
+    return ctx;
+}
+
+void ImGui::DestroyContext(ImGuiContext* ctx)
+{
+    // Destruct with ctx current, so memory still held by its pools is released through its own MemFreeFn()
+    ImGuiContext* prev_ctx = GImGui;
+    void (*free_fn)(void*) = ctx->IO.MemFreeFn;
+    SetCurrentContext(ctx);
+    ctx->~ImGuiContext();
+    free_fn(ctx);
+    SetCurrentContext(prev_ctx == ctx ? NULL : prev_ctx);
+}
+
+ImGuiIO& ImGui::GetIO()
+{
+    return GImGui->IO;
+}
+
+ImGuiStyle& ImGui::GetStyle()
+{
+    return GImGui->Style;
+}
+
+// Same value as passed to your RenderDrawListsFn() function. valid after Render() and until the next call to NewFrame()
+ImDrawData* ImGui::GetDrawData()
+{
+    return GImGui->RenderDrawData.Valid ? &GImGui->RenderDrawData : NULL;
+}
+
+float ImGui::GetTime()
+{
+    return GImGui->Time;
+}
+
+int ImGui::GetFrameCount()
+{
+    return GImGui->FrameCount;
+}
+
+void ImGuiProfiler::Clear()
+{
+    for (int i = 0; i < Names.Data.Size; i++)
+        ImGui::MemFree(Names.Data[i].val_p);
+    Names.Clear();
+    Events.clear();
+    Stack.clear();
+    Frames.clear();
+    EventsWritten = FramesWritten = 0;
+    FrameOpen = false;
+}
+
+const char* ImGuiProfiler::InternName(ImGuiID id, const char* name)
+{
+    void** p_name = Names.GetVoidPtrRef(id);
+    if (*p_name == NULL)
+        *p_name = ImStrdup(name);
+    return (const char*)*p_name;
+}
+
+void ImGui::PushProfileScopeEx(ImGuiID id, const char* name, double start_time)
+{
+    ImGuiProfiler& prof = GImGui->Profiler;
+    if (!prof.Active)
+        return;
+    ImGuiProfileEvent ev;
+    ev.Id = id;
+    ev.Name = prof.InternName(id, name);
+    ev.StartTime = start_time;
+    ev.EndTime = ev.ChildTime = 0.0;
+    ev.Depth = prof.Stack.Size;
+    prof.Stack.push_back(ev);
+}
+
+void ImGui::PushProfileScope(const char* name)
+{
+    if (GImGui->Profiler.Active)
+        PushProfileScopeEx(ImHash(name, 0), name, ImTimeNow());
+}
+
+void ImGui::PopProfileScope()
+{
+    ImGuiProfiler& prof = GImGui->Profiler;
+    if (!prof.Active || prof.Stack.empty())
+        return;
+    ImGuiProfileEvent ev = prof.Stack.back();
+    prof.Stack.pop_back();
+    ev.EndTime = ImTimeNow();
+    if (!prof.Stack.empty())
+        prof.Stack.back().ChildTime += ev.EndTime - ev.StartTime;
+    if (prof.Events.empty())
+        prof.Events.resize(IM_PROFILER_EVENTS_COUNT);
+    prof.GetEvent(prof.EventsWritten++) = ev;
+}
+
+static void ProfilerBeginFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler& prof = g.Profiler;
+    prof.Stack.resize(0);
+    prof.CurrentFrame.FrameCount = g.FrameCount + 1;
+    prof.CurrentFrame.StartTime = ImTimeNow();
+    prof.CurrentFrame.EventsBegin = prof.EventsWritten;
+    prof.FrameOpen = true;
+}
+
+static void ProfilerEndFrame()
+{
+    ImGuiProfiler& prof = GImGui->Profiler;
+    while (!prof.Stack.empty())
+        ImGui::PopProfileScope();
+    prof.CurrentFrame.EndTime = ImTimeNow();
+    prof.CurrentFrame.EventsEnd = prof.EventsWritten;
+    if (prof.Frames.empty())
+        prof.Frames.resize(IM_PROFILER_FRAMES_COUNT);
+    prof.Frames[(int)(prof.FramesWritten++ & (IM_PROFILER_FRAMES_COUNT - 1))] = prof.CurrentFrame;
+    prof.FrameOpen = false;
+}
+
+static void ProfileTraceWriteString(FILE* f, const char* str)
+{
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            fprintf(f, "\\%c", *p);
+        else if (*p < 0x20)
+            fprintf(f, "\\u%04x", *p);
+        else
+            fputc(*p, f);
+    }
+}
+
+// Chrome trace event format: https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+bool ImGui::SaveProfileTrace(const char* filename)
+{
+    ImGuiProfiler& prof = GImGui->Profiler;
+    FILE* f = ImFileOpen(filename, "wt");
+    if (!f)
+        return false;
+
+    const unsigned int events_count = (prof.EventsWritten < (unsigned int)prof.Events.Size) ? prof.EventsWritten : (unsigned int)prof.Events.Size;
+    const unsigned int events_first = prof.EventsWritten - events_count;
+    double time_base = DBL_MAX;
+    for (unsigned int n = events_first; n != prof.EventsWritten; n++)
+        if (prof.GetEvent(n).StartTime < time_base)
+            time_base = prof.GetEvent(n).StartTime;
+
+    fprintf(f, "{\"traceEvents\":[");
+    const char* separator = "\n";
+    const unsigned int frames_count = (prof.FramesWritten < (unsigned int)prof.Frames.Size) ? prof.FramesWritten : (unsigned int)prof.Frames.Size;
+    for (unsigned int n = prof.FramesWritten - frames_count; n != prof.FramesWritten; n++)
+    {
+        const ImGuiProfileFrame& frame = prof.Frames[(int)(n & (IM_PROFILER_FRAMES_COUNT - 1))];
+        if (!prof.IsEventValid(frame.EventsBegin))
+            continue;
+        fprintf(f, "%s{\"name\":\"Frame %d\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}", separator, frame.FrameCount, (frame.StartTime - time_base) * 1000000.0, (frame.EndTime - frame.StartTime) * 1000000.0);
+        separator = ",\n";
+    }
+    for (unsigned int n = events_first; n != prof.EventsWritten; n++)
+    {
+        const ImGuiProfileEvent& ev = prof.GetEvent(n);
+        fprintf(f, "%s{\"name\":\"", separator);
+        ProfileTraceWriteString(f, ev.Name);
+        fprintf(f, "\",\"cat\":\"imgui\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}", (ev.StartTime - time_base) * 1000000.0, (ev.EndTime - ev.StartTime) * 1000000.0);
+        separator = ",\n";
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Input recording/replay
+//-----------------------------------------------------------------------------
+
+static const char IM_INPUT_RECORD_MAGIC[8] = { 'I','m','G','u','i','R','e','c' };
+
+static void InputRecordWrite(ImVector<unsigned char>& buf, const void* data, int size)
+{
+    const int pos = buf.Size;
+    buf.resize(pos + size);
+    memcpy(buf.Data + pos, data, (size_t)size);
+}
+
+static bool InputReplayRead(ImGuiInputRecorder& rec, void* data, int size)
+{
+    if (rec.ReplayPos + size > rec.ReplayData.Size)
+        return false;
+    memcpy(data, rec.ReplayData.Data + rec.ReplayPos, (size_t)size);
+    rec.ReplayPos += size;
+    return true;
+}
+
+static int InputRecordGetButtons(const ImGuiIO& io)
+{
+    int buttons = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown); n++)
+        if (io.MouseDown[n])
+            buttons |= 1 << n;
+    if (io.KeyCtrl)  buttons |= 1 << 5;
+    if (io.KeyShift) buttons |= 1 << 6;
+    if (io.KeyAlt)   buttons |= 1 << 7;
+    if (io.KeySuper) buttons |= 1 << 8;
+    return buttons;
+}
+
+bool ImGui::BeginInputRecording(const char* filename)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiInputRecorder& rec = g.InputRecorder;
+    IM_ASSERT(rec.ReplayData.Size == 0);    // Recording and replaying share the delta-encoding state
+    EndInputRecording();
+    if ((rec.RecordFile = ImFileOpen(filename, "wb")) == NULL)
+        return false;
+
+    rec.ResetState();
+    rec.FrameData.resize(0);
+    const int version = IM_INPUT_RECORD_VERSION, keys_count = ImGuiKey_COUNT;
+    InputRecordWrite(rec.FrameData, IM_INPUT_RECORD_MAGIC, sizeof(IM_INPUT_RECORD_MAGIC));
+    InputRecordWrite(rec.FrameData, &version, sizeof(version));
+    InputRecordWrite(rec.FrameData, &keys_count, sizeof(keys_count));
+    InputRecordWrite(rec.FrameData, g.IO.KeyMap, sizeof(g.IO.KeyMap));
+    if (fwrite(rec.FrameData.Data, 1, (size_t)rec.FrameData.Size, rec.RecordFile) != (size_t)rec.FrameData.Size)
+    {
+        EndInputRecording();
+        return false;
+    }
+    return true;
+}
+
+void ImGui::EndInputRecording()
+{
+    ImGuiInputRecorder& rec = GImGui->InputRecorder;
+    if (rec.RecordFile)
+        fclose(rec.RecordFile);
+    rec.RecordFile = NULL;
+    rec.FrameData.clear();
+}
+
+static void InputRecordFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiInputRecorder& rec = g.InputRecorder;
+    const ImGuiIO& io = g.IO;
+    ImVector<unsigned char>& buf = rec.FrameData;
+
+    int keys_toggled = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(io.KeysDown); n++)
+        if (io.KeysDown[n] != rec.KeysDown[n])
+            keys_toggled++;
+    int chars_count = 0;
+    while (chars_count < IM_ARRAYSIZE(io.InputCharacters) && io.InputCharacters[chars_count] != 0)
+        chars_count++;
+    const int buttons = InputRecordGetButtons(io);
+
+    unsigned char flags = 0;
+    if (rec.Frames == 0 || io.DisplaySize.x != rec.DisplaySize.x || io.DisplaySize.y != rec.DisplaySize.y) flags |= ImGuiInputRecordFlags_DisplaySize;
+    if (rec.Frames == 0 || io.MousePos.x != rec.MousePos.x || io.MousePos.y != rec.MousePos.y)             flags |= ImGuiInputRecordFlags_MousePos;
+    if (buttons != rec.Buttons)     flags |= ImGuiInputRecordFlags_Buttons;
+    if (io.MouseWheel != 0.0f)      flags |= ImGuiInputRecordFlags_MouseWheel;
+    if (keys_toggled > 0)           flags |= ImGuiInputRecordFlags_Keys;
+    if (chars_count > 0)            flags |= ImGuiInputRecordFlags_Chars;
+
+    buf.resize(0);
+    InputRecordWrite(buf, &flags, 1);
+    InputRecordWrite(buf, &io.DeltaTime, sizeof(float));
+    if (flags & ImGuiInputRecordFlags_DisplaySize)
+        InputRecordWrite(buf, &io.DisplaySize, sizeof(ImVec2));
+    if (flags & ImGuiInputRecordFlags_MousePos)
+        InputRecordWrite(buf, &io.MousePos, sizeof(ImVec2));
+    if (flags & ImGuiInputRecordFlags_Buttons)
+    {
+        const unsigned short buttons_u16 = (unsigned short)buttons;
+        InputRecordWrite(buf, &buttons_u16, sizeof(buttons_u16));
+    }
+    if (flags & ImGuiInputRecordFlags_MouseWheel)
+        InputRecordWrite(buf, &io.MouseWheel, sizeof(float));
+    if (flags & ImGuiInputRecordFlags_Keys)
+    {
+        const unsigned short count = (unsigned short)keys_toggled;
+        InputRecordWrite(buf, &count, sizeof(count));
+        for (unsigned short n = 0; n < IM_ARRAYSIZE(io.KeysDown); n++)
+            if (io.KeysDown[n] != rec.KeysDown[n])
+                InputRecordWrite(buf, &n, sizeof(n));
+    }
+    if (flags & ImGuiInputRecordFlags_Chars)
+    {
+        const unsigned char count = (unsigned char)chars_count;
+        InputRecordWrite(buf, &count, 1);
+        InputRecordWrite(buf, io.InputCharacters, chars_count * (int)sizeof(ImWchar));
+    }
+
+    if (fwrite(buf.Data, 1, (size_t)buf.Size, rec.RecordFile) != (size_t)buf.Size)
+    {
+        ImGui::EndInputRecording();
+        return;
+    }
+    rec.DisplaySize = io.DisplaySize;
+    rec.MousePos = io.MousePos;
+    rec.Buttons = buttons;
+    memcpy(rec.KeysDown, io.KeysDown, sizeof(rec.KeysDown));
+    rec.Frames++;
+}
+
+bool ImGui::BeginInputReplay(const char* filename, float fixed_delta_time)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiInputRecorder& rec = g.InputRecorder;
+    IM_ASSERT(rec.RecordFile == NULL);      // Recording and replaying share the delta-encoding state
+    EndInputReplay();
+
+    int file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (!file_data)
+        return false;
+    rec.ReplayData.resize(file_size);
+    memcpy(rec.ReplayData.Data, file_data, (size_t)file_size);
+    ImGui::MemFree(file_data);
+
+    char magic[sizeof(IM_INPUT_RECORD_MAGIC)];
+    int version = 0, keys_count = 0;
+    int key_map[ImGuiKey_COUNT];
+    if (!InputReplayRead(rec, magic, sizeof(magic)) || memcmp(magic, IM_INPUT_RECORD_MAGIC, sizeof(magic)) != 0 ||
+        !InputReplayRead(rec, &version, sizeof(version)) || version != IM_INPUT_RECORD_VERSION ||
+        !InputReplayRead(rec, &keys_count, sizeof(keys_count)) || keys_count != ImGuiKey_COUNT ||
+        !InputReplayRead(rec, key_map, sizeof(key_map)))
+    {
+        EndInputReplay();
+        return false;
+    }
+    memcpy(g.IO.KeyMap, key_map, sizeof(key_map));
+    rec.ReplayDeltaTime = fixed_delta_time;
+    rec.ResetState();
+    return true;
+}
+
+bool ImGui::IsInputReplaying()
+{
+    ImGuiInputRecorder& rec = GImGui->InputRecorder;
+    return rec.ReplayPos < rec.ReplayData.Size;
+}
+
+void ImGui::EndInputReplay()
+{
+    ImGuiInputRecorder& rec = GImGui->InputRecorder;
+    rec.ReplayData.clear();
+    rec.ReplayPos = 0;
+}
+
+// Overwrite the io inputs with the next recorded frame. Ends the replay on truncated data.
+static void InputReplayFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiInputRecorder& rec = g.InputRecorder;
+    ImGuiIO& io = g.IO;
+
+    unsigned char flags = 0;
+    float delta_time = 0.0f;
+    bool ok = InputReplayRead(rec, &flags, 1) && InputReplayRead(rec, &delta_time, sizeof(float));
+    if (ok && (flags & ImGuiInputRecordFlags_DisplaySize))
+        ok = InputReplayRead(rec, &rec.DisplaySize, sizeof(ImVec2));
+    if (ok && (flags & ImGuiInputRecordFlags_MousePos))
+        ok = InputReplayRead(rec, &rec.MousePos, sizeof(ImVec2));
+    if (ok && (flags & ImGuiInputRecordFlags_Buttons))
+    {
+        unsigned short buttons = 0;
+        ok = InputReplayRead(rec, &buttons, sizeof(buttons));
+        rec.Buttons = buttons;
+    }
+    float mouse_wheel = 0.0f;
+    if (ok && (flags & ImGuiInputRecordFlags_MouseWheel))
+        ok = InputReplayRead(rec, &mouse_wheel, sizeof(float));
+    if (ok && (flags & ImGuiInputRecordFlags_Keys))
+    {
+        unsigned short count = 0, key = 0;
+        ok = InputReplayRead(rec, &count, sizeof(count));
+        for (int n = 0; ok && n < count; n++)
+        {
+            ok = InputReplayRead(rec, &key, sizeof(key)) && key < IM_ARRAYSIZE(rec.KeysDown);
+            if (ok)
+                rec.KeysDown[key] = !rec.KeysDown[key];
+        }
+    }
+    unsigned char chars_count = 0;
+    ImWchar chars[IM_ARRAYSIZE(io.InputCharacters)];
+    if (ok && (flags & ImGuiInputRecordFlags_Chars))
+        ok = InputReplayRead(rec, &chars_count, 1) && chars_count < IM_ARRAYSIZE(chars) && InputReplayRead(rec, chars, chars_count * (int)sizeof(ImWchar));
+    if (!ok)
+    {
+        ImGui::EndInputReplay();
+        return;
+    }
+
+    io.DeltaTime = rec.ReplayDeltaTime > 0.0f ? rec.ReplayDeltaTime : delta_time;
+    io.DisplaySize = rec.DisplaySize;
+    io.MousePos = rec.MousePos;
+    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown); n++)
+        io.MouseDown[n] = (rec.Buttons & (1 << n)) != 0;
+    io.KeyCtrl = (rec.Buttons & (1 << 5)) != 0;
+    io.KeyShift = (rec.Buttons & (1 << 6)) != 0;
+    io.KeyAlt = (rec.Buttons & (1 << 7)) != 0;
+    io.KeySuper = (rec.Buttons & (1 << 8)) != 0;
+    io.MouseWheel = mouse_wheel;
+    memcpy(io.KeysDown, rec.KeysDown, sizeof(io.KeysDown));
+    memcpy(io.InputCharacters, chars, chars_count * sizeof(ImWchar));
+    io.InputCharacters[chars_count] = 0;
+    rec.Frames++;
+}
+
+void ImGui::NewFrame()
+{
+    ImGuiContext& g = *GImGui;
+
+    // Replayed inputs override the io values set by the application. Recording captures what NewFrame() is about to read.
+    if (g.InputRecorder.ReplayData.Size > 0)
+    {
+        if (ImGui::IsInputReplaying())
+            InputReplayFrame();
+        else
+            ImGui::EndInputReplay();
+    }
+    if (g.InputRecorder.RecordFile)
+        InputRecordFrame();
+
+    // Check user data
+    IM_ASSERT(g.IO.DeltaTime >= 0.0f);               // Need a positive DeltaTime (zero is tolerated but will cause some timing issues)
     IM_ASSERT(g.IO.DisplaySize.x >= 0.0f && g.IO.DisplaySize.y >= 0.0f);
     IM_ASSERT(g.IO.Fonts->Fonts.Size > 0);           // Font Atlas not created. Did you call io.Fonts->GetTexDataAsRGBA32 / GetTexDataAsAlpha8 ?
     IM_ASSERT(g.IO.Fonts->Fonts[0]->IsLoaded());     // Font Atlas not created. Did you call io.Fonts->GetTexDataAsRGBA32 / GetTexDataAsAlpha8 ?
     IM_ASSERT(g.Style.CurveTessellationTol > 0.0f);  // Invalid style setting
 
+    // Close the previous profiler frame if Render() wasn't called, and latch the enabled state for the whole frame
+    if (g.Profiler.FrameOpen)
+        ProfilerEndFrame();
+    g.Profiler.Active = g.IO.ProfilerEnabled;
+    if (g.Profiler.Active)
+    {
+        ProfilerBeginFrame();
+        PushProfileScope("NewFrame");
+    }
+
     if (!g.Initialized)
     {
         // Initialize on first frame
@@ -2140,7 +3393,8 @@ void ImGui::NewFrame()
         IM_PLACEMENT_NEW(g.LogClipboard) ImGuiTextBuffer();
 
         IM_ASSERT(g.Settings.empty());
-        LoadIniSettingsFromDisk(g.IO.IniFilename);
+        if (!g.IO.IniBinaryFilename || !LoadIniSettingsBinary(g.IO.IniBinaryFilename))
+            LoadIniSettingsFromDisk(g.IO.IniFilename);
         g.Initialized = true;
     }
 
@@ -2150,7 +3404,17 @@ void ImGui::NewFrame()
     g.Time += g.IO.DeltaTime;
     g.FrameCount += 1;
     g.Tooltip[0] = '\0';
+
+    // Publish memory counters of the previous frame and recycle its transient allocations
+    g.IO.MetricsFrameAllocs = g.MemFrameAllocs;
+    g.IO.MetricsFrameAllocsBytes = g.MemFrameAllocsBytes;
+    g.MemFrameAllocs = g.MemFrameAllocsBytes = 0;
+    g.MemFrameArena.Rewind();
+    if (ImAtomicLoad(&g.MemPool.RemoteFreesPending))
+        g.MemPool.TakeRemoteFrees();
+    g.IO.MetricsPoolBytes = g.MemPool.GetReservedBytes() + (int)g.MemFrameArena.Capacity;
     g.OverlayDrawList.Clear();
+    g.OverlayDrawList.UseQuads = g.IO.DrawListsUseQuads;
     g.OverlayDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.OverlayDrawList.PushClipRectFullScreen();
 
@@ -2248,7 +3512,12 @@ void ImGui::NewFrame()
     {
         g.SettingsDirtyTimer -= g.IO.DeltaTime;
         if (g.SettingsDirtyTimer <= 0.0f)
-            SaveIniSettingsToDisk(g.IO.IniFilename);
+        {
+            if (g.IO.IniBinaryFilename)
+                SaveIniSettingsBinary(g.IO.IniBinaryFilename, true);
+            else
+                SaveIniSettingsToDisk(g.IO.IniFilename);
+        }
     }
 
     // Find the window we are hovering. Child windows can extend beyond the limit of their parent so we need to derive HoveredRootWindow from HoveredWindow
@@ -2334,12 +3603,17 @@ void ImGui::NewFrame()
         g.FocusedWindow->FocusIdxTabRequestNext = 0;
 
     // Mark all windows as not visible
+    g.WindowGrid.Valid = false;
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
         window->WasActive = window->Active;
         window->Active = false;
         window->Accessed = false;
+
+        // Clear() only trims the draw lists of submitted windows, give back the buffers of a window closed or hidden for IMGUI_DRAWLIST_TRIM_FRAMES frames
+        if (IMGUI_DRAWLIST_TRIM_FRAMES > 0 && window->LastFrameActive == g.FrameCount - 1 - IMGUI_DRAWLIST_TRIM_FRAMES)
+            window->DrawList->ClearFreeMemory();
     }
 
     // Closing the focused window restore focus to the first active root window in descending z-order
@@ -2357,6 +3631,11 @@ void ImGui::NewFrame()
     g.CurrentPopupStack.resize(0);
     CloseInactivePopups();
 
+    // Free the windows which haven't been used for a while
+    GcStaleWindows();
+
+    PopProfileScope();
+
     // Create implicit window - we will only render it if the user has added something to it.
     ImGui::SetNextWindowSize(ImVec2(400,400), ImGuiSetCond_FirstUseEver);
     ImGui::Begin("Debug");
@@ -2375,6 +3654,8 @@ void ImGui::Shutdown()
     if (!g.Initialized)
         return;
 
+    if (g.IO.IniBinaryFilename)
+        SaveIniSettingsBinary(g.IO.IniBinaryFilename, false);
     SaveIniSettingsToDisk(g.IO.IniFilename);
 
     for (int i = 0; i < g.Windows.Size; i++)
@@ -2384,6 +3665,18 @@ void ImGui::Shutdown()
     }
     g.Windows.clear();
     g.WindowsSortBuffer.clear();
+    g.WindowsById.Clear();
+    for (int i = 0; i < g.WindowsGcStorage.Data.Size; i++)
+        if (ImGuiStorage* storage = (ImGuiStorage*)g.WindowsGcStorage.Data[i].val_p)
+        {
+            storage->~ImGuiStorage();
+            ImGui::MemFree(storage);
+        }
+    g.WindowsGcStorage.Clear();
+    g.WindowGrid.Valid = false;
+    g.WindowGrid.Entries.clear();
+    g.WindowGrid.CellStart.clear();
+    g.WindowGrid.CellEntries.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.FocusedWindow = NULL;
@@ -2414,16 +3707,23 @@ void ImGui::Shutdown()
     g.InputTextState.InitialText.clear();
     g.InputTextState.TempTextBuffer.clear();
 
-    if (g.LogFile && g.LogFile != stdout)
-    {
-        fclose(g.LogFile);
-        g.LogFile = NULL;
-    }
+    if (g.LogFile || g.LogWriteFn)
+        LogFlushBuffer(false, true);
+    WaitFileWriteJob(&g.LogWriteJob.Pending);
+    g.LogFile = NULL;
+    g.LogWriteFn = NULL;
+    g.LogBuffers[0].clear();
+    g.LogBuffers[1].clear();
     if (g.LogClipboard)
     {
         g.LogClipboard->~ImGuiTextBuffer();
         ImGui::MemFree(g.LogClipboard);
     }
+    g.Profiler.Clear();
+    ImGui::EndInputRecording();
+    ImGui::EndInputReplay();
+    g.MemFrameArena.Clear();
+    g.MemPool.Trim();
 
     g.Initialized = false;
 }
@@ -2450,6 +3750,7 @@ static ImGuiIniData* AddWindowSettings(const char* name)
     ini->Collapsed = false;
     ini->Pos = ImVec2(FLT_MAX,FLT_MAX);
     ini->Size = ImVec2(0,0);
+    ini->Dirty = true;
     return ini;
 }
 
@@ -2500,6 +3801,26 @@ static void LoadIniSettingsFromDisk(const char* ini_filename)
     ImGui::MemFree(file_data);
 }
 
+// Gather data from windows that were active during this session
+static void UpdateIniSettingsFromWindows()
+{
+    ImGuiContext& g = *GImGui;
+    for (int i = 0; i != g.Windows.Size; i++)
+        UpdateIniSettingsFromWindow(g.Windows[i]);
+}
+
+static void UpdateIniSettingsFromWindow(ImGuiWindow* window)
+{
+    if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
+        return;
+    ImGuiIniData* settings = FindWindowSettings(window->Name);
+    if (settings->Pos.x != window->Pos.x || settings->Pos.y != window->Pos.y || settings->Size.x != window->SizeFull.x || settings->Size.y != window->SizeFull.y || settings->Collapsed != window->Collapsed)
+        settings->Dirty = true;
+    settings->Pos = window->Pos;
+    settings->Size = window->SizeFull;
+    settings->Collapsed = window->Collapsed;
+}
+
 static void SaveIniSettingsToDisk(const char* ini_filename)
 {
     ImGuiContext& g = *GImGui;
@@ -2507,17 +3828,7 @@ static void SaveIniSettingsToDisk(const char* ini_filename)
     if (!ini_filename)
         return;
 
-    // Gather data from windows that were active during this session
-    for (int i = 0; i != g.Windows.Size; i++)
-    {
-        ImGuiWindow* window = g.Windows[i];
-        if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
-            continue;
-        ImGuiIniData* settings = FindWindowSettings(window->Name);
-        settings->Pos = window->Pos;
-        settings->Size = window->SizeFull;
-        settings->Collapsed = window->Collapsed;
-    }
+    UpdateIniSettingsFromWindows();
 
     // Write .ini file
     // If a window wasn't opened in this session we preserve its settings
@@ -2542,6 +3853,201 @@ static void SaveIniSettingsToDisk(const char* ini_filename)
     fclose(f);
 }
 
+// Binary settings journal: a header followed by records, later records for a same window override earlier ones.
+// Record: ImGuiID Id, float Pos.x, Pos.y, Size.x, Size.y, unsigned short Collapsed, unsigned short NameLen, char Name[NameLen] (not zero-terminated, from the "###" marker if any)
+// Periodic saves only append the records which changed. Once overwritten records dominate, the journal is compacted by writing a temporary file and renaming it over the journal.
+static const char       IniBinaryMagic[8] = { 'I', 'm', 'G', 'u', 'i', 'I', 'n', 'i' };
+static const int        IniBinaryHeaderSize = 8 + 4;
+static const int        IniBinaryVersion = 1;
+static const int        IniBinaryRecordHeaderSize = 4 * 5 + 2 * 2;
+
+struct ImGuiIniSaveJob
+{
+    void                (*FreeFn)(void* ptr);
+    volatile int*       Pending;
+    bool                Compact;
+    char*               Filename;
+    char*               TempFilename;
+    char*               Data;
+    int                 DataSize;
+};
+
+static const char* GetIniSettingsSavedName(const ImGuiIniData* settings)
+{
+    const char* name = settings->Name;
+    if (const char* p = strstr(name, "###"))  // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
+        name = p;
+    return name;
+}
+
+static bool LoadIniSettingsBinary(const char* filename)
+{
+    ImGuiContext& g = *GImGui;
+    int file_size;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+    if (!file_data)
+        return false;
+    int version = 0;
+    if (file_size >= IniBinaryHeaderSize)
+        memcpy(&version, file_data + 8, 4);
+    if (file_size < IniBinaryHeaderSize || memcmp(file_data, IniBinaryMagic, 8) != 0 || version != IniBinaryVersion)
+    {
+        ImGui::MemFree(file_data);
+        return false;
+    }
+
+    g.SettingsJournalRecords = 0;
+    char* p = file_data + IniBinaryHeaderSize;
+    char* p_end = file_data + file_size;
+    while (p + IniBinaryRecordHeaderSize <= p_end)
+    {
+        ImGuiID id;
+        float f[4];
+        unsigned short collapsed, name_len;
+        memcpy(&id, p, 4);
+        memcpy(f, p + 4, 4 * 4);
+        memcpy(&collapsed, p + 20, 2);
+        memcpy(&name_len, p + 22, 2);
+        p += IniBinaryRecordHeaderSize;
+        if (p + name_len > p_end)   // Truncated write
+            break;
+        // Zero-terminate the name in place, over the first byte of the next record (or the padding byte at the end of the file)
+        char* name = p;
+        p += name_len;
+        const char next_c = *p;
+        *p = 0;
+        ImGuiIniData* settings = FindWindowSettings(name);
+        if (!settings)
+            settings = AddWindowSettings(name);
+        *p = next_c;
+        if (settings->Id != id)
+        {
+            // Corrupted record, or written by a build hashing names differently: reject the whole journal so the caller falls back to the .ini file
+            for (int i = 0; i < g.Settings.Size; i++)
+                ImGui::MemFree(g.Settings[i].Name);
+            g.Settings.clear();
+            g.SettingsJournalRecords = 0;
+            ImGui::MemFree(file_data);
+            return false;
+        }
+        settings->Pos = ImVec2(f[0], f[1]);
+        settings->Size = ImMax(ImVec2(f[2], f[3]), g.Style.WindowMinSize);
+        settings->Collapsed = (collapsed != 0);
+        settings->Dirty = false;
+        g.SettingsJournalRecords++;
+    }
+
+    ImGui::MemFree(file_data);
+    return true;
+}
+
+// Wait for a job handed to io.FileWriteAsyncFn to complete. Writes are short, yielding is enough to not starve the thread running the job.
+static void WaitFileWriteJob(volatile int* pending)
+{
+    while (ImAtomicLoad(pending))
+        ImThreadYield();
+}
+
+// May run on any thread: only touch the file system and the job itself.
+static void IniSaveJobRun(void* job_data)
+{
+    ImGuiIniSaveJob* job = (ImGuiIniSaveJob*)job_data;
+    if (FILE* f = ImFileOpen(job->Compact ? job->TempFilename : job->Filename, job->Compact ? "wb" : "ab"))
+    {
+        bool ok = fwrite(job->Data, 1, (size_t)job->DataSize, f) == (size_t)job->DataSize;
+        ok &= (fclose(f) == 0);
+        if (job->Compact && ok)
+            ImFileReplace(job->TempFilename, job->Filename);
+    }
+    volatile int* pending = job->Pending;
+    job->FreeFn(job);
+    ImAtomicStore(pending, 0);
+}
+
+static void SaveIniSettingsBinary(const char* filename, bool allow_async)
+{
+    ImGuiContext& g = *GImGui;
+    g.SettingsDirtyTimer = 0.0f;
+    UpdateIniSettingsFromWindows();
+
+    if (ImAtomicLoad(&g.SettingsSaveJobPending))
+    {
+        if (allow_async)
+        {
+            MarkIniSettingsDirty(); // Previous write still in flight, try again later
+            return;
+        }
+        WaitFileWriteJob(&g.SettingsSaveJobPending);
+    }
+
+    // Only append changed records, unless overwritten records dominate the journal
+    int live_count = 0, dirty_count = 0, live_bytes = 0, dirty_bytes = 0;
+    for (int i = 0; i != g.Settings.Size; i++)
+    {
+        const ImGuiIniData* settings = &g.Settings[i];
+        if (settings->Pos.x == FLT_MAX)
+            continue;
+        const int record_size = IniBinaryRecordHeaderSize + (int)strlen(GetIniSettingsSavedName(settings));
+        live_count++;
+        live_bytes += record_size;
+        if (settings->Dirty)
+        {
+            dirty_count++;
+            dirty_bytes += record_size;
+        }
+    }
+    const bool compact = (g.SettingsJournalRecords == 0) || (g.SettingsJournalRecords + dirty_count > live_count * 2 + 16);
+    if (!compact && dirty_count == 0)
+        return;
+
+    // Build the job in a single allocation from io.MemAllocFn(), so it can be released from any thread
+    const int filename_len = (int)strlen(filename);
+    const int data_size = compact ? IniBinaryHeaderSize + live_bytes : dirty_bytes;
+    ImGuiIniSaveJob* job = (ImGuiIniSaveJob*)g.IO.MemAllocFn(sizeof(ImGuiIniSaveJob) + (size_t)(filename_len + 1) + (size_t)(filename_len + 5) + (size_t)data_size);
+    job->FreeFn = g.IO.MemFreeFn;
+    job->Pending = &g.SettingsSaveJobPending;
+    job->Compact = compact;
+    job->Filename = (char*)(job + 1);
+    job->TempFilename = job->Filename + filename_len + 1;
+    job->Data = job->TempFilename + filename_len + 5;
+    job->DataSize = data_size;
+    memcpy(job->Filename, filename, (size_t)filename_len + 1);
+    ImFormatString(job->TempFilename, filename_len + 5, "%s.tmp", filename);
+
+    char* p = job->Data;
+    if (compact)
+    {
+        memcpy(p, IniBinaryMagic, 8);
+        memcpy(p + 8, &IniBinaryVersion, 4);
+        p += IniBinaryHeaderSize;
+    }
+    for (int i = 0; i != g.Settings.Size; i++)
+    {
+        ImGuiIniData* settings = &g.Settings[i];
+        if (settings->Pos.x == FLT_MAX || (!compact && !settings->Dirty))
+            continue;
+        const char* name = GetIniSettingsSavedName(settings);
+        const float f[4] = { settings->Pos.x, settings->Pos.y, settings->Size.x, settings->Size.y };
+        const unsigned short collapsed = settings->Collapsed ? 1 : 0;
+        const unsigned short name_len = (unsigned short)strlen(name);
+        memcpy(p, &settings->Id, 4);
+        memcpy(p + 4, f, 4 * 4);
+        memcpy(p + 20, &collapsed, 2);
+        memcpy(p + 22, &name_len, 2);
+        memcpy(p + IniBinaryRecordHeaderSize, name, name_len);
+        p += IniBinaryRecordHeaderSize + name_len;
+        settings->Dirty = false;
+    }
+    IM_ASSERT(p == job->Data + data_size);
+    g.SettingsJournalRecords = compact ? live_count : g.SettingsJournalRecords + dirty_count;
+
+    ImAtomicStore(&g.SettingsSaveJobPending, 1);
+    if (allow_async && g.IO.FileWriteAsyncFn)
+        g.IO.FileWriteAsyncFn(IniSaveJobRun, job);
+    else
+        IniSaveJobRun(job);
+}
+
 static void MarkIniSettingsDirty()
 {
     ImGuiContext& g = *GImGui;
@@ -2580,6 +4086,51 @@ static void AddWindowToSortedBuffer(ImVector<ImGuiWindow*>& out_sorted_windows,
     }
 }
 
+// Word at a time hash (MurmurHash3 mixing), a lot cheaper than the byte-wise CRC32 of ImHash() on vertex buffers. Only used to detect changes.
+static ImU32 HashDrawListData(const void* data, int data_size, ImU32 seed)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    ImU32 h = seed ^ (ImU32)data_size;
+    for (; data_size >= 4; data_size -= 4, p += 4)
+    {
+        ImU32 k;
+        memcpy(&k, p, 4);
+        k *= 0xcc9e2d51;
+        k = (k << 15) | (k >> 17);
+        h ^= k * 0x1b873593;
+        h = (h << 13) | (h >> 19);
+        h = h * 5 + 0xe6546b64;
+    }
+    for (; data_size > 0; data_size--)
+        h = (h ^ *p++) * 0x01000193;
+    h ^= h >> 16; h *= 0x85ebca6b;
+    h ^= h >> 13; h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+// Bump the list's ContentVersion if what the renderer would upload changed since the last time the list was rendered.
+static bool UpdateDrawListContentVersion(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImU32 hash = HashDrawListData(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), 0);
+    hash = HashDrawListData(draw_list->QuadBuffer.Data, draw_list->QuadBuffer.Size * (int)sizeof(ImDrawQuad), hash);
+    hash = HashDrawListData(&draw_list->IdxBuffer.Size, sizeof(int), hash);
+    for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+    {
+        const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_i];
+        if (cmd.UserCallback || cmd.ElemCount == 0)
+            continue;
+        hash = HashDrawListData(&cmd.IdxOffset, sizeof(cmd.IdxOffset), hash);
+        hash = HashDrawListData(draw_list->IdxBuffer.Data + cmd.IdxOffset, (int)(cmd.ElemCount * sizeof(ImDrawIdx)), hash);
+    }
+    if (draw_list->ContentVersion != 0 && draw_list->_ContentHash == hash)
+        return false;
+    draw_list->_ContentHash = hash;
+    draw_list->ContentVersion = ++g.DrawListsContentVersion;
+    return true;
+}
+
 static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDrawList* draw_list)
 {
     if (draw_list->CmdBuffer.empty())
@@ -2587,13 +4138,17 @@ static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDr
 
     // Remove trailing command if unused
     ImDrawCmd& last_cmd = draw_list->CmdBuffer.back();
-    if (last_cmd.ElemCount == 0 && last_cmd.UserCallback == NULL)
+    if (last_cmd.ElemCount == 0 && last_cmd.QuadCount == 0 && last_cmd.UserCallback == NULL)
     {
         draw_list->CmdBuffer.pop_back();
         if (draw_list->CmdBuffer.empty())
             return;
     }
 
+    // Expand quads unless the renderer draws them directly
+    if (!GImGui->IO.RenderDrawListsUseQuads)
+        draw_list->ExpandQuads();
+
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
     IM_ASSERT(draw_list->VtxBuffer.Size == 0 || draw_list->_VtxWritePtr == draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size);
     IM_ASSERT(draw_list->IdxBuffer.Size == 0 || draw_list->_IdxWritePtr == draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size);
@@ -2603,6 +4158,9 @@ static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDr
     // If this assert triggers because you are drawing lots of stuff manually, A) workaround by calling BeginChild()/EndChild() to put your draw commands in multiple draw lists, B) #define ImDrawIdx to a 'unsigned int' in imconfig.h and render accordingly.
     IM_ASSERT((int64_t)draw_list->_VtxCurrentIdx <= ((int64_t)1L << (sizeof(ImDrawIdx)*8)));  // Too many vertices in same ImDrawList. See comment above.
     
+    if (GImGui->IO.RenderDrawListsTrackChanges && UpdateDrawListContentVersion(draw_list))
+        GImGui->RenderDrawData.CmdListsChangedCount++;
+
     out_render_list.push_back(draw_list);
     GImGui->IO.MetricsRenderVertices += draw_list->VtxBuffer.Size;
     GImGui->IO.MetricsRenderIndices += draw_list->IdxBuffer.Size;
@@ -2643,6 +4201,7 @@ void ImGui::EndFrame()
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);                       // Forgot to call ImGui::NewFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // ImGui::EndFrame() called multiple times, or forgot to call ImGui::NewFrame() again
+    PushProfileScope("EndFrame");
 
     // Render tooltip
     if (g.Tooltip[0])
@@ -2701,18 +4260,25 @@ void ImGui::EndFrame()
     }
     IM_ASSERT(g.Windows.Size == g.WindowsSortBuffer.Size);  // we done something wrong
     g.Windows.swap(g.WindowsSortBuffer);
+    WindowGridBuild();
+
+    // Hand the text logged during this frame to the writer
+    if (g.LogEnabled && (g.LogFile || g.LogWriteFn))
+        LogFlushBuffer(true, false);
 
     // Clear Input data for next frame
     g.IO.MouseWheel = 0.0f;
     memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
 
     g.FrameCountEnded = g.FrameCount;
+    PopProfileScope();
 }
 
 void ImGui::Render()
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);   // Forgot to call ImGui::NewFrame()
+    PushProfileScope("Render");
 
     if (g.FrameCountEnded != g.FrameCount)
         ImGui::EndFrame();
@@ -2724,12 +4290,13 @@ void ImGui::Render()
     {
         // Gather windows to render
         g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = 0;
+        g.RenderDrawData.CmdListsChangedCount = 0;
         for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
             g.RenderDrawLists[i].resize(0);
         for (int i = 0; i != g.Windows.Size; i++)
         {
             ImGuiWindow* window = g.Windows[i];
-            if (window->Active && window->HiddenFrames <= 0 && (window->Flags & (ImGuiWindowFlags_ChildWindow)) == 0)
+            if (window->Active && window->HiddenFrames <= 0 && !window->SkipItemsOffscreen && (window->Flags & (ImGuiWindowFlags_ChildWindow)) == 0)
             {
                 // FIXME: Generalize this with a proper layering system so e.g. user can draw in specific layers, below text, ..
                 g.IO.MetricsActiveWindows++;
@@ -2771,7 +4338,7 @@ void ImGui::Render()
             g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[0], cursor_data.TexUvMax[0], IM_COL32(255,255,255,255)); // White fill
             g.OverlayDrawList.PopTextureID();
         }
-        if (!g.OverlayDrawList.VtxBuffer.empty())
+        if (!g.OverlayDrawList.VtxBuffer.empty() || !g.OverlayDrawList.QuadBuffer.empty())
             AddDrawListToRenderList(g.RenderDrawLists[0], &g.OverlayDrawList);
 
         // Setup draw data
@@ -2783,8 +4350,16 @@ void ImGui::Render()
 
         // Render. If user hasn't set a callback then they may retrieve the draw data via GetDrawData()
         if (g.RenderDrawData.CmdListsCount > 0 && g.IO.RenderDrawListsFn != NULL)
+        {
+            PushProfileScope("RenderDrawListsFn");
             g.IO.RenderDrawListsFn(&g.RenderDrawData);
+            PopProfileScope();
+        }
     }
+
+    PopProfileScope();
+    if (g.Profiler.FrameOpen)
+        ProfilerEndFrame();
 }
 
 const char* ImGui::FindRenderedTextEnd(const char* text, const char* text_end)
@@ -2807,9 +4382,23 @@ void ImGui::LogText(const char* fmt, ...)
 
     va_list args;
     va_start(args, fmt);
-    if (g.LogFile)
-    {
-        vfprintf(g.LogFile, fmt, args);
+    if (g.LogFile || g.LogWriteFn)
+    {
+        // Accumulate into the front buffer, the actual write happens in LogFlushBuffer()
+        ImVector<char>& buf = g.LogBuffers[g.LogBufferFront];
+        va_list args_copy;
+        va_copy(args_copy, args);
+        int len = vsnprintf(NULL, 0, fmt, args_copy);
+        va_end(args_copy);
+        if (len > 0)
+        {
+            const int write_off = buf.Size;
+            buf.resize(write_off + len + 1);
+            ImFormatStringV(&buf[write_off], len + 1, fmt, args);
+            buf.resize(write_off + len);    // Don't keep the zero-terminator
+            if (buf.Size >= IM_LOG_BUFFER_FLUSH_SIZE)
+                LogFlushBuffer(true, false);
+        }
     }
     else
     {
@@ -2818,6 +4407,62 @@ void ImGui::LogText(const char* fmt, ...)
     va_end(args);
 }
 
+// May run on any thread: only touch the job and its destination.
+static void LogWriteJobRun(void* job_data)
+{
+    ImGuiLogWriteJob* job = (ImGuiLogWriteJob*)job_data;
+    if (job->File)
+    {
+        if (job->DataSize > 0)
+            fwrite(job->Data, 1, (size_t)job->DataSize, job->File);
+        if (job->Finish)
+        {
+            if (job->File == stdout)
+                fflush(job->File);
+            else
+                fclose(job->File);
+        }
+    }
+    else if (job->WriteFn && job->DataSize > 0)
+    {
+        job->WriteFn(job->WriteUserData, job->Data, job->DataSize);
+    }
+    ImAtomicStore(&job->Pending, 0);
+}
+
+// Hand the front logging buffer to the writer and start filling the other one.
+// If the previous write is still in flight we keep accumulating, we only wait for it when finishing (LogFinish) as we can't keep the file/callback around.
+// When finishing, the writer also takes care of flushing/closing the file. LogFinish() does that last write synchronously, so the output is complete when it returns.
+static void LogFlushBuffer(bool allow_async, bool finish)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiLogWriteJob& job = g.LogWriteJob;
+    if (ImAtomicLoad(&job.Pending))
+    {
+        if (!finish)
+            return;
+        WaitFileWriteJob(&job.Pending);
+    }
+
+    ImVector<char>& buf = g.LogBuffers[g.LogBufferFront];
+    if (buf.Size == 0 && !finish)
+        return;
+    g.LogBufferFront ^= 1;
+    g.LogBuffers[g.LogBufferFront].resize(0);
+
+    job.File = g.LogFile;
+    job.WriteFn = g.LogWriteFn;
+    job.WriteUserData = g.LogWriteUserData;
+    job.Data = buf.Data;
+    job.DataSize = buf.Size;
+    job.Finish = finish;
+    ImAtomicStore(&job.Pending, 1);
+    if (allow_async && g.IO.FileWriteAsyncFn)
+        g.IO.FileWriteAsyncFn(LogWriteJobRun, &job);
+    else
+        LogWriteJobRun(&job);
+}
+
 // Internal version that takes a position to decide on newline placement and pad items according to their depth.
 // We split text into individual lines to add current tree level padding
 static void LogRenderedText(const ImVec2& ref_pos, const char* text, const char* text_end)
@@ -3081,11 +4726,109 @@ void ImGui::CalcListClipping(int items_count, float items_height, int* out_items
     *out_items_display_end = end;
 }
 
+// Clamp in float space before converting, mouse positions can be -FLT_MAX
+static inline int WindowGridCellIndex(float v, float origin, float inv_cell_size, int cells_count)
+{
+    return (int)ImClamp((v - origin) * inv_cell_size, 0.0f, (float)(cells_count - 1));
+}
+
+static void WindowGridBuild()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowGrid& grid = g.WindowGrid;
+    grid.Valid = false;
+    grid.Entries.resize(0);
+    ImVec2 size_sum(0.0f, 0.0f);
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!window->Active || (window->Flags & ImGuiWindowFlags_NoInputs))
+            continue;
+        ImGuiWindowGridEntry entry;
+        entry.Rect = ImRect(window->WindowRectClipped.Min - g.Style.TouchExtraPadding, window->WindowRectClipped.Max + g.Style.TouchExtraPadding);
+        if (entry.Rect.Min.x >= entry.Rect.Max.x || entry.Rect.Min.y >= entry.Rect.Max.y)
+            continue;
+        entry.Window = window;
+        entry.IsChild = (window->Flags & ImGuiWindowFlags_ChildWindow) != 0;
+        grid.Entries.push_back(entry);
+        size_sum += entry.Rect.GetSize();
+    }
+    if (grid.Entries.Size < IM_WINDOW_GRID_MIN_WINDOWS)
+        return;
+
+    // Cells about the size of an average window, so each window is referenced by a few cells only.
+    // Positions outside of the display are clamped to the border cells, which keeps the lookup exact.
+    const ImVec2 display_size(ImMax(g.IO.DisplaySize.x, 1.0f), ImMax(g.IO.DisplaySize.y, 1.0f));
+    const ImVec2 cell_size(ImMax(size_sum.x / grid.Entries.Size, 16.0f), ImMax(size_sum.y / grid.Entries.Size, 16.0f));
+    grid.CellsX = ImClamp((int)(display_size.x / cell_size.x), 1, 64);
+    grid.CellsY = ImClamp((int)(display_size.y / cell_size.y), 1, 64);
+    grid.Origin = ImVec2(0.0f, 0.0f);
+    grid.InvCellSize = ImVec2(grid.CellsX / display_size.x, grid.CellsY / display_size.y);
+    grid.TouchExtraPadding = g.Style.TouchExtraPadding;
+
+    // Two passes: count the entries of each cell, then fill them in z order
+    grid.CellStart.resize(grid.CellsX * grid.CellsY + 1);
+    memset(grid.CellStart.Data, 0, (size_t)grid.CellStart.Size * sizeof(int));
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int n = 0; n < grid.Entries.Size; n++)
+        {
+            const ImRect& r = grid.Entries[n].Rect;
+            const int x0 = WindowGridCellIndex(r.Min.x, grid.Origin.x, grid.InvCellSize.x, grid.CellsX);
+            const int y0 = WindowGridCellIndex(r.Min.y, grid.Origin.y, grid.InvCellSize.y, grid.CellsY);
+            const int x1 = WindowGridCellIndex(r.Max.x, grid.Origin.x, grid.InvCellSize.x, grid.CellsX);
+            const int y1 = WindowGridCellIndex(r.Max.y, grid.Origin.y, grid.InvCellSize.y, grid.CellsY);
+            for (int y = y0; y <= y1; y++)
+                for (int x = x0; x <= x1; x++)
+                {
+                    const int cell = y * grid.CellsX + x;
+                    if (pass == 0)
+                        grid.CellStart[cell + 1]++;
+                    else
+                        grid.CellEntries[grid.CellStart[cell]++] = n;
+                }
+        }
+        if (pass == 0)
+        {
+            for (int cell = 0; cell < grid.CellsX * grid.CellsY; cell++)
+                grid.CellStart[cell + 1] += grid.CellStart[cell];
+            grid.CellEntries.resize(grid.CellStart.back());
+        }
+        else
+        {
+            // Filling advanced each CellStart[] to the start of the next cell: shift back
+            for (int cell = grid.CellsX * grid.CellsY; cell > 0; cell--)
+                grid.CellStart[cell] = grid.CellStart[cell - 1];
+            grid.CellStart[0] = 0;
+        }
+    }
+    grid.Valid = true;
+}
+
+static ImGuiWindow* WindowGridFindHovered(const ImVec2& pos, bool excluding_childs)
+{
+    const ImGuiWindowGrid& grid = GImGui->WindowGrid;
+    const int x = WindowGridCellIndex(pos.x, grid.Origin.x, grid.InvCellSize.x, grid.CellsX);
+    const int y = WindowGridCellIndex(pos.y, grid.Origin.y, grid.InvCellSize.y, grid.CellsY);
+    const int cell = y * grid.CellsX + x;
+    for (int n = grid.CellStart[cell + 1] - 1; n >= grid.CellStart[cell]; n--)
+    {
+        const ImGuiWindowGridEntry& entry = grid.Entries[grid.CellEntries[n]];
+        if (excluding_childs && entry.IsChild)
+            continue;
+        if (entry.Rect.Contains(pos))
+            return entry.Window;
+    }
+    return NULL;
+}
+
 // Find window given position, search front-to-back
 // FIXME: Note that we have a lag here because WindowRectClipped is updated in Begin() so windows moved by user via SetWindowPos() and not SetNextWindowPos() will have that rectangle lagging by a frame at the time FindHoveredWindow() is called, aka before the next Begin(). Moving window thankfully isn't affected.
 static ImGuiWindow* FindHoveredWindow(ImVec2 pos, bool excluding_childs)
 {
     ImGuiContext& g = *GImGui;
+    if (g.WindowGrid.Valid && g.WindowGrid.TouchExtraPadding.x == g.Style.TouchExtraPadding.x && g.WindowGrid.TouchExtraPadding.y == g.Style.TouchExtraPadding.y)
+        return WindowGridFindHovered(pos, excluding_childs);
     for (int i = g.Windows.Size-1; i >= 0; i--)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -3397,7 +5140,7 @@ static ImRect GetVisibleRect()
 void ImGui::BeginTooltip()
 {
     ImGuiWindowFlags flags = ImGuiWindowFlags_Tooltip|ImGuiWindowFlags_NoTitleBar|ImGuiWindowFlags_NoMove|ImGuiWindowFlags_NoResize|ImGuiWindowFlags_NoSavedSettings|ImGuiWindowFlags_AlwaysAutoResize;
-    ImGui::Begin("##Tooltip", NULL, flags);
+    ImGui::BeginEx(ImHash("##Tooltip", 0), "##Tooltip", NULL, ImVec2(0.0f, 0.0f), -1.0f, flags);
 }
 
 void ImGui::EndTooltip()
@@ -3515,6 +5258,29 @@ static inline void ClearSetNextWindowData()
     g.SetNextWindowSizeConstraint = g.SetNextWindowFocus = false;
 }
 
+// Write 'v' as 8 hex digits followed by a zero, like "%08X" or "%08x"
+static void FormatHex8(char* buf, ImU32 v, bool uppercase)
+{
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    for (int n = 7; n >= 0; n--, v >>= 4)
+        buf[n] = digits[v & 0x0F];
+    buf[8] = 0;
+}
+
+// Continue ImHash(str, 0) of a string with 'str' appended: a "###" in 'str' restarts the hash from there, like ImHash() does
+static ImGuiID HashStrAppend(ImGuiID hash, const char* str)
+{
+    const char* str_begin = str;
+    for (const char* p = str; *p; p++)
+        if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+        {
+            str_begin = p;
+            hash = 0;
+        }
+    const int len = (int)strlen(str_begin);
+    return len > 0 ? ImHash(str_begin, len, hash) : hash;
+}
+
 static bool BeginPopupEx(const char* str_id, ImGuiWindowFlags extra_flags)
 {
     ImGuiContext& g = *GImGui;
@@ -3529,13 +5295,31 @@ static bool BeginPopupEx(const char* str_id, ImGuiWindowFlags extra_flags)
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
     ImGuiWindowFlags flags = extra_flags|ImGuiWindowFlags_Popup|ImGuiWindowFlags_NoTitleBar|ImGuiWindowFlags_NoMove|ImGuiWindowFlags_NoResize|ImGuiWindowFlags_NoSavedSettings|ImGuiWindowFlags_AlwaysAutoResize;
 
-    char name[20];
+    // The window ID is the hash of its "##menu_%d" or "##popup_%08x" name, so FindWindowByName() and Begin() with that name find it.
+    // Build the name by hand, it is short and we need its hash every frame.
+    char name_buf[20];
     if (flags & ImGuiWindowFlags_ChildMenu)
-        ImFormatString(name, IM_ARRAYSIZE(name), "##menu_%d", g.CurrentPopupStack.Size);    // Recycle windows based on depth
+    {
+        // Recycle windows based on depth
+        char digits[12];
+        int digits_count = 0;
+        for (int depth = g.CurrentPopupStack.Size; depth > 0 || digits_count == 0; depth /= 10)
+            digits[digits_count++] = (char)('0' + depth % 10);
+        memcpy(name_buf, "##menu_", 7);
+        for (int n = 0; n < digits_count; n++)
+            name_buf[7 + n] = digits[digits_count - 1 - n];
+        name_buf[7 + digits_count] = 0;
+    }
     else
-        ImFormatString(name, IM_ARRAYSIZE(name), "##popup_%08x", id); // Not recycling, so we can close/open during the same frame
+    {
+        // Not recycling, so we can close/open during the same frame
+        memcpy(name_buf, "##popup_", 8);
+        FormatHex8(name_buf + 8, id, false);
+    }
+    const ImGuiID popup_window_id = ImHash(name_buf, 0);
+    const char* name = (ImGui::FindWindowByID(popup_window_id) == NULL) ? name_buf : NULL;
 
-    bool is_open = ImGui::Begin(name, NULL, flags);
+    bool is_open = ImGui::BeginEx(popup_window_id, name, NULL, ImVec2(0.0f, 0.0f), -1.0f, flags);
     if (!(window->Flags & ImGuiWindowFlags_ShowBorders))
         g.CurrentWindow->Flags &= ~ImGuiWindowFlags_ShowBorders;
     if (!is_open) // NB: is_open can be 'false' when the popup is completely clipped (e.g. zero size display)
@@ -3643,13 +5427,27 @@ static bool BeginChildEx(const char* name, ImGuiID id, const ImVec2& size_arg, b
         flags |= ImGuiWindowFlags_ShowBorders;
     flags |= extra_flags;
 
-    char title[256];
+    // The window ID is the hash of its "%s.%s.%08X" or "%s.%08X" name, so FindWindowByName() with that name finds it.
+    // We hash the name in steps and only format it when the window gets created.
+    char id_buf[10];
+    id_buf[0] = '.';
+    FormatHex8(id_buf + 1, id, true);
+    ImGuiID child_window_id = ImHash(window->Name, 0);
     if (name)
-        ImFormatString(title, IM_ARRAYSIZE(title), "%s.%s.%08X", window->Name, name, id);
-    else
-        ImFormatString(title, IM_ARRAYSIZE(title), "%s.%08X", window->Name, id);
+        child_window_id = HashStrAppend(HashStrAppend(child_window_id, "."), name);
+    child_window_id = HashStrAppend(child_window_id, id_buf);
+    char title_buf[256];
+    const char* title = NULL;
+    if (ImGui::FindWindowByID(child_window_id) == NULL)
+    {
+        if (name)
+            ImFormatString(title_buf, IM_ARRAYSIZE(title_buf), "%s.%s.%08X", window->Name, name, id);
+        else
+            ImFormatString(title_buf, IM_ARRAYSIZE(title_buf), "%s.%08X", window->Name, id);
+        title = title_buf;
+    }
 
-    bool ret = ImGui::Begin(title, NULL, size, -1.0f, flags);
+    bool ret = ImGui::BeginEx(child_window_id, title, NULL, size, -1.0f, flags);
 
     if (!(window->Flags & ImGuiWindowFlags_ShowBorders))
         ImGui::GetCurrentWindow()->Flags &= ~ImGuiWindowFlags_ShowBorders;
@@ -3758,23 +5556,33 @@ static ImVec2 FindBestPopupWindowPos(const ImVec2& base_pos, const ImVec2& size,
 
 ImGuiWindow* ImGui::FindWindowByName(const char* name)
 {
-    // FIXME-OPT: Store sorted hashes -> pointers so we can do a bissection in a contiguous block
+    return FindWindowByID(ImHash(name, 0));
+}
+
+ImGuiWindow* ImGui::FindWindowByID(ImGuiID id)
+{
     ImGuiContext& g = *GImGui;
-    ImGuiID id = ImHash(name, 0);
-    for (int i = 0; i < g.Windows.Size; i++)
-        if (g.Windows[i]->ID == id)
-            return g.Windows[i];
-    return NULL;
+    return (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
 }
 
-static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
+static ImGuiWindow* CreateNewWindow(const char* name, ImGuiID id, ImVec2 size, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
 
     // Create window the first time
     ImGuiWindow* window = (ImGuiWindow*)ImGui::MemAlloc(sizeof(ImGuiWindow));
-    IM_PLACEMENT_NEW(window) ImGuiWindow(name);
+    IM_PLACEMENT_NEW(window) ImGuiWindow(name, id);
     window->Flags = flags;
+    g.WindowsById.SetVoidPtr(id, window);
+
+    // Give back the storage kept when a previous instance of this window was freed by GcStaleWindows()
+    if (ImGuiStorage* storage = (ImGuiStorage*)g.WindowsGcStorage.GetVoidPtr(id))
+    {
+        window->StateStorage.Data.swap(storage->Data);
+        storage->~ImGuiStorage();
+        ImGui::MemFree(storage);
+        g.WindowsGcStorage.SetVoidPtr(id, NULL);
+    }
 
     if (flags & ImGuiWindowFlags_NoSavedSettings)
     {
@@ -3833,6 +5641,95 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
     return window;
 }
 
+static bool IsWindowStale(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->WasActive || window->LastFrameActive >= g.FrameCount - 1)
+        return false;
+    if (g.IO.WindowsGcFrames > 0 && g.FrameCount - 1 - window->LastFrameActive < g.IO.WindowsGcFrames)
+        return false;
+    if (g.IO.WindowsGcTime > 0.0f && g.Time - window->LastTimeActive < g.IO.WindowsGcTime)
+        return false;
+    return true;
+}
+
+// Free the windows which haven't been submitted for io.WindowsGcFrames frames / io.WindowsGcTime seconds, keeping their .ini settings (and storage if io.WindowsGcKeepStorage is set).
+// A stale window is kept while a window we keep still points to it (parent/root of a child window or popup), or while it is referenced by an open popup, the active id or a move.
+static void GcStaleWindows()
+{
+    ImGuiContext& g = *GImGui;
+    if (g.IO.WindowsGcFrames <= 0 && g.IO.WindowsGcTime <= 0.0f)
+        return;
+
+    // WindowsSortBuffer is only used within Render(), borrow it to gather the candidates
+    ImVector<ImGuiWindow*>& candidates = g.WindowsSortBuffer;
+    candidates.resize(0);
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (IsWindowStale(window) && window != g.ActiveIdWindow && window != g.MovedWindow)
+            candidates.push_back(window);
+    }
+    if (candidates.empty())
+        return;
+    for (int i = 0; i != g.OpenPopupStack.Size; i++)
+    {
+        for (int j = candidates.Size-1; j >= 0; j--)
+            if (candidates[j] == g.OpenPopupStack[i].Window || candidates[j] == g.OpenPopupStack[i].ParentWindow)
+                candidates.erase(candidates.begin() + j);
+    }
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (int i = 0; i != g.Windows.Size; i++)
+        {
+            ImGuiWindow* window = g.Windows[i];
+            bool is_candidate = false;
+            for (int j = 0; j != candidates.Size && !is_candidate; j++)
+                is_candidate = (candidates[j] == window);
+            if (is_candidate)
+                continue;
+            for (int j = candidates.Size-1; j >= 0; j--)
+                if (candidates[j] == window->ParentWindow || candidates[j] == window->RootWindow || candidates[j] == window->RootNonPopupWindow)
+                {
+                    candidates.erase(candidates.begin() + j);
+                    changed = true;
+                }
+        }
+    }
+
+    for (int i = 0; i != candidates.Size; i++)
+    {
+        ImGuiWindow* window = candidates[i];
+        UpdateIniSettingsFromWindow(window);
+        if (g.IO.WindowsGcKeepStorage && !window->StateStorage.Data.empty())
+        {
+            ImGuiStorage* storage = (ImGuiStorage*)ImGui::MemAlloc(sizeof(ImGuiStorage));
+            IM_PLACEMENT_NEW(storage) ImGuiStorage();
+            storage->Data.swap(window->StateStorage.Data);
+            g.WindowsGcStorage.SetVoidPtr(window->ID, storage);
+        }
+        g.WindowsById.SetVoidPtr(window->ID, NULL);
+        for (int j = g.Windows.Size-1; j >= 0; j--)
+        {
+            ImVector<ImGuiWindow*>& child_windows = g.Windows[j]->DC.ChildWindows;
+            for (int k = child_windows.Size-1; k >= 0; k--)
+                if (child_windows[k] == window)
+                    child_windows.erase(child_windows.begin() + k);
+            if (g.Windows[j] == window)
+                g.Windows.erase(g.Windows.begin() + j);
+        }
+        if (g.CurrentWindow == window) g.CurrentWindow = NULL;
+        if (g.FocusedWindow == window) g.FocusedWindow = NULL;
+        if (g.HoveredWindow == window) g.HoveredWindow = NULL;
+        if (g.HoveredRootWindow == window) g.HoveredRootWindow = NULL;
+        window->~ImGuiWindow();
+        ImGui::MemFree(window);
+    }
+    candidates.resize(0);
+    g.WindowGrid.Valid = false;
+}
+
 static void ApplySizeFullWithConstraint(ImGuiWindow* window, ImVec2 new_size)
 {
     ImGuiContext& g = *GImGui;
@@ -3873,24 +5770,39 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 }
 
 bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_use, float bg_alpha, ImGuiWindowFlags flags)
+{
+    IM_ASSERT(name != NULL);                        // Window name required
+    return BeginEx(ImHash(name, 0), name, p_open, size_on_first_use, bg_alpha, flags);
+}
+
+// Same as Begin() for a window identified by 'id', so internal windows (child windows, popups, tooltips) don't need to format and hash a name every frame.
+// 'name' is only stored when the window is created, and displayed in the title bar. When NULL, the window gets a "##%08X" debug name on creation.
+bool ImGui::BeginEx(ImGuiID id, const char* name, bool* p_open, const ImVec2& size_on_first_use, float bg_alpha, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
-    IM_ASSERT(name != NULL);                        // Window name required
     IM_ASSERT(g.Initialized);                       // Forgot to call ImGui::NewFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // Called ImGui::Render() or ImGui::EndFrame() and haven't called ImGui::NewFrame() again yet
+    const double profile_start_time = g.Profiler.Active ? ImTimeNow() : 0.0;
 
     if (flags & ImGuiWindowFlags_NoInputs)
         flags |= ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize;
 
     // Find or create
     bool window_is_new = false;
-    ImGuiWindow* window = FindWindowByName(name);
+    ImGuiWindow* window = FindWindowByID(id);
     if (!window)
     {
-        window = CreateNewWindow(name, size_on_first_use, flags);
+        char debug_name[16];
+        if (name == NULL)
+            ImFormatString(debug_name, IM_ARRAYSIZE(debug_name), "##%08X", id);
+        window = CreateNewWindow(name ? name : debug_name, id, size_on_first_use, flags);
         window_is_new = true;
     }
+    if (name == NULL)
+        name = window->Name;
+    if (g.Profiler.Active && !g.CurrentWindowStack.empty()) // Don't profile the implicit "Debug" window, it spans the whole frame
+        PushProfileScopeEx(window->ID, window->Name, profile_start_time);
 
     const int current_frame = ImGui::GetFrameCount();
     const bool first_begin_of_the_frame = (window->LastFrameActive != current_frame);
@@ -3986,10 +5898,12 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         window->BeginCount = 0;
         window->ClipRect = ImVec4(-FLT_MAX,-FLT_MAX,+FLT_MAX,+FLT_MAX);
         window->LastFrameActive = current_frame;
+        window->LastTimeActive = g.Time;
         window->IDStack.resize(1);
 
         // Clear draw list, setup texture, outer clipping rectangle
         window->DrawList->Clear();
+        window->DrawList->UseQuads = g.IO.DrawListsUseQuads;
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         ImRect fullscreen_rect(GetVisibleRect());
         if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & (ImGuiWindowFlags_ComboBox|ImGuiWindowFlags_Popup)))
@@ -4026,8 +5940,12 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         // SIZE
 
         // Save contents size from last frame for auto-fitting (unless explicitly specified)
-        window->SizeContents.x = (float)(int)((window->SizeContentsExplicit.x != 0.0f) ? window->SizeContentsExplicit.x : ((window_is_new ? 0.0f : window->DC.CursorMaxPos.x - window->Pos.x) + window->Scroll.x));
-        window->SizeContents.y = (float)(int)((window->SizeContentsExplicit.y != 0.0f) ? window->SizeContentsExplicit.y : ((window_is_new ? 0.0f : window->DC.CursorMaxPos.y - window->Pos.y) + window->Scroll.y));
+        // When no items were submitted last frame because the window was off-screen, keep the size measured before that.
+        if (!window->SkipItemsOffscreen)
+        {
+            window->SizeContents.x = (float)(int)((window->SizeContentsExplicit.x != 0.0f) ? window->SizeContentsExplicit.x : ((window_is_new ? 0.0f : window->DC.CursorMaxPos.x - window->Pos.x) + window->Scroll.x));
+            window->SizeContents.y = (float)(int)((window->SizeContentsExplicit.y != 0.0f) ? window->SizeContentsExplicit.y : ((window_is_new ? 0.0f : window->DC.CursorMaxPos.y - window->Pos.y) + window->Scroll.y));
+        }
 
         // Hide popup/tooltip window when first appearing while we measure size (because we recycle them)
         if (window->HiddenFrames > 0)
@@ -4159,6 +6077,18 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         }
         window->Pos = ImVec2((float)(int)window->PosFloat.x, (float)(int)window->PosFloat.y);
 
+        // Root windows entirely outside of the display skip their contents and decorations but stay active, so their IDs, size and scrolling are preserved.
+        // The window is not hoverable (its clipped rectangle is empty) and is left out of the render list.
+        // Skip this while the window owns the active item, so e.g. a drag moving the window out of the display keeps its widget alive.
+        window->SkipItemsOffscreen = false;
+        if (!(flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip | ImGuiWindowFlags_ComboBox | ImGuiWindowFlags_ChildMenu | ImGuiWindowFlags_NoOffscreenSkip)))
+            if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && !(g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window))
+            {
+                ImRect window_rect_clipped = window->Rect();
+                window_rect_clipped.Clip(window->ClipRect);
+                window->SkipItemsOffscreen = (window_rect_clipped.Min.x >= window_rect_clipped.Max.x || window_rect_clipped.Min.y >= window_rect_clipped.Max.y);
+            }
+
         // Default item width. Make it proportional to window size if window manually resizes
         if (window->Size.x > 0.0f && !(flags & ImGuiWindowFlags_Tooltip) && !(flags & ImGuiWindowFlags_AlwaysAutoResize))
             window->ItemWidthDefault = (float)(int)(window->Size.x * 0.65f);
@@ -4194,7 +6124,11 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         // Draw window + handle manual resize
         ImRect title_bar_rect = window->TitleBarRect();
         const float window_rounding = (flags & ImGuiWindowFlags_ChildWindow) ? style.ChildWindowRounding : style.WindowRounding;
-        if (window->Collapsed)
+        if (window->SkipItemsOffscreen)
+        {
+            // Nothing to draw: keep the scrollbar state of the last frame, the contents region depends on it
+        }
+        else if (window->Collapsed)
         {
             // Draw title bar only
             RenderFrame(title_bar_rect.GetTL(), title_bar_rect.GetBR(),  GetColorU32(ImGuiCol_TitleBgCollapsed), true, window_rounding);
@@ -4347,7 +6281,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
                 FocusWindow(window);
 
         // Title bar
-        if (!(flags & ImGuiWindowFlags_NoTitleBar))
+        if (!(flags & ImGuiWindowFlags_NoTitleBar) && !window->SkipItemsOffscreen)
         {
             if (p_open != NULL)
             {
@@ -4413,7 +6347,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         IM_ASSERT((flags & ImGuiWindowFlags_NoTitleBar) != 0);
         window->Collapsed = parent_window && parent_window->Collapsed;
 
-        if (!(flags & ImGuiWindowFlags_AlwaysAutoResize) && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0)
+        if (!(flags & (ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoOffscreenSkip)) && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0)
             window->Collapsed |= (window->WindowRectClipped.Min.x >= window->WindowRectClipped.Max.x || window->WindowRectClipped.Min.y >= window->WindowRectClipped.Max.y);
 
         // We also hide the window from rendering because we've already added its border to the command list.
@@ -4425,7 +6359,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         window->Active = false;
 
     // Return false if we don't intend to display anything to allow user to perform an early out optimization
-    window->SkipItems = (window->Collapsed || !window->Active) && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0;
+    window->SkipItems = ((window->Collapsed || !window->Active) && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0) || window->SkipItemsOffscreen;
     return !window->SkipItems;
 }
 
@@ -4433,6 +6367,7 @@ void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
+    const bool profile_scope = (g.CurrentWindowStack.Size > 1);
 
     Columns(1, "#CloseColumns");
     PopClipRect();   // inner window clip rectangle
@@ -4448,6 +6383,8 @@ void ImGui::End()
         g.CurrentPopupStack.pop_back();
     CheckStacksSize(window, false);
     SetCurrentWindow(g.CurrentWindowStack.empty() ? NULL : g.CurrentWindowStack.back());
+    if (profile_scope)
+        PopProfileScope();
 }
 
 // Vertical scrollbar
@@ -4576,6 +6513,7 @@ void ImGui::FocusWindow(ImGuiWindow* window)
     // Bring to front
     if ((window->Flags & ImGuiWindowFlags_NoBringToFrontOnFocus) || g.Windows.back() == window)
         return;
+    g.WindowGrid.Valid = false;
     for (int i = 0; i < g.Windows.Size; i++)
         if (g.Windows[i] == window)
         {
@@ -4642,6 +6580,7 @@ static void SetCurrentFont(ImFont* font)
     g.FontBaseSize = g.IO.FontGlobalScale * g.Font->FontSize * g.Font->Scale;
     g.FontSize = g.CurrentWindow ? g.CurrentWindow->CalcFontSize() : 0.0f;
     g.FontTexUvWhitePixel = g.Font->ContainerAtlas->TexUvWhitePixel;
+    g.FontTexUvLines = g.Font->ContainerAtlas->TexUvLines;
 }
 
 void ImGui::PushFont(ImFont* font)
@@ -5148,6 +7087,18 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+int ImGui::GetWindowRetainedBytes()
+{
+    ImGuiWindow* window = GetCurrentWindowRead();
+    return window->GetRetainedBytes();
+}
+
+int ImGui::GetWindowRetainedBytes(const char* name)
+{
+    ImGuiWindow* window = FindWindowByName(name);
+    return window ? window->GetRetainedBytes() : 0;
+}
+
 ImFont* ImGui::GetFont()
 {
     return GImGui->Font;
@@ -5834,6 +7785,24 @@ void ImGui::LogToClipboard(int max_depth)
         g.LogAutoExpandMaxDepth = max_depth;
 }
 
+// Start logging ImGui output to a user callback
+void ImGui::LogToCallback(void (*write_fn)(void* user_data, const char* data, int size), void* user_data, int max_depth)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.LogEnabled)
+        return;
+    ImGuiWindow* window = GetCurrentWindowRead();
+    IM_ASSERT(write_fn != NULL);
+
+    g.LogEnabled = true;
+    g.LogFile = NULL;
+    g.LogWriteFn = write_fn;
+    g.LogWriteUserData = user_data;
+    g.LogStartDepth = window->DC.TreeDepth;
+    if (max_depth >= 0)
+        g.LogAutoExpandMaxDepth = max_depth;
+}
+
 void ImGui::LogFinish()
 {
     ImGuiContext& g = *GImGui;
@@ -5842,14 +7811,11 @@ void ImGui::LogFinish()
 
     LogText(IM_NEWLINE);
     g.LogEnabled = false;
-    if (g.LogFile != NULL)
-    {
-        if (g.LogFile == stdout)
-            fflush(g.LogFile);
-        else
-            fclose(g.LogFile);
-        g.LogFile = NULL;
-    }
+    if (g.LogFile != NULL || g.LogWriteFn != NULL)
+        LogFlushBuffer(false, true);
+    g.LogFile = NULL;
+    g.LogWriteFn = NULL;
+    g.LogWriteUserData = NULL;
     if (g.LogClipboard->size() > 1)
     {
         SetClipboardText(g.LogClipboard->begin());
@@ -7097,14 +9063,224 @@ bool ImGui::DragIntRange2(const char* label, int* v_current_min, int* v_current_
     return value_changed;
 }
 
-void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+// Min/max of a contiguous array of samples, accumulated into *io_min/*io_max
+static void PlotMinMax(const float* values, int count, float* io_min, float* io_max)
 {
-    ImGuiWindow* window = GetCurrentWindow();
-    if (window->SkipItems)
-        return;
+    float v_min = *io_min, v_max = *io_max;
+    int n = 0;
+#ifdef IMGUI_ENABLE_SSE2
+    if (count >= 8)
+    {
+        __m128 m_min = _mm_set1_ps(v_min), m_max = _mm_set1_ps(v_max);
+        for (; n + 4 <= count; n += 4)
+        {
+            const __m128 v = _mm_loadu_ps(values + n);
+            m_min = _mm_min_ps(m_min, v);
+            m_max = _mm_max_ps(m_max, v);
+        }
+        float r_min[4], r_max[4];
+        _mm_storeu_ps(r_min, m_min);
+        _mm_storeu_ps(r_max, m_max);
+        v_min = ImMin(ImMin(r_min[0], r_min[1]), ImMin(r_min[2], r_min[3]));
+        v_max = ImMax(ImMax(r_max[0], r_max[1]), ImMax(r_max[2], r_max[3]));
+    }
+#endif
+    for (; n < count; n++)
+    {
+        v_min = ImMin(v_min, values[n]);
+        v_max = ImMax(v_max, values[n]);
+    }
+    *io_min = v_min;
+    *io_max = v_max;
+}
 
-    ImGuiContext& g = *GImGui;
-    const ImGuiStyle& style = g.Style;
+// Recompute the buckets overlapping samples [abs_begin,abs_end) (absolute indices), from the samples still stored
+static void PlotBufferComputeBuckets(ImGuiPlotBuffer* buf, int abs_begin, int abs_end)
+{
+    const int abs_oldest = buf->Written - buf->Count;
+    abs_begin = ImMax(abs_begin, abs_oldest);
+    abs_end = ImMin(abs_end, buf->Written);
+    if (abs_begin >= abs_end)
+        return;
+    const int step = buf->EnvelopeStep;
+    const int capacity = buf->Values.Size;
+    for (int b = abs_begin / step; b <= (abs_end - 1) / step; b++)
+    {
+        const int s0 = ImMax(b * step, abs_oldest);
+        const int s1 = ImMin(b * step + step, buf->Written);
+        float v_min = FLT_MAX, v_max = -FLT_MAX;
+        int pos = buf->Offset + (s0 - abs_oldest);
+        if (pos >= capacity)
+            pos -= capacity;
+        const int n0 = ImMin(s1 - s0, capacity - pos);
+        PlotMinMax(buf->Values.Data + pos, n0, &v_min, &v_max);
+        PlotMinMax(buf->Values.Data, (s1 - s0) - n0, &v_min, &v_max);
+        buf->EnvelopeMin[b % buf->EnvelopeMin.Size] = v_min;
+        buf->EnvelopeMax[b % buf->EnvelopeMax.Size] = v_max;
+    }
+}
+
+void ImGuiPlotBuffer::SetCapacity(int capacity)
+{
+    IM_ASSERT(capacity > 0);
+    Values.resize(capacity);
+    Clear();
+}
+
+void ImGuiPlotBuffer::AddValue(float v)
+{
+    AddValues(&v, 1);
+}
+
+void ImGuiPlotBuffer::AddValues(const float* values, int values_count)
+{
+    const int capacity = Values.Size;
+    IM_ASSERT(capacity > 0); // Call SetCapacity() first
+    Written += values_count;
+    if (values_count > capacity)
+    {
+        values += values_count - capacity;
+        values_count = capacity;
+    }
+
+    // Copy after the newest sample, in up to two parts
+    int pos = Offset + Count;
+    if (pos >= capacity)
+        pos -= capacity;
+    const int n0 = ImMin(values_count, capacity - pos);
+    memcpy(Values.Data + pos, values, (size_t)n0 * sizeof(float));
+    memcpy(Values.Data, values + n0, (size_t)(values_count - n0) * sizeof(float));
+    Count += values_count;
+    if (Count > capacity)
+    {
+        Offset = (Offset + Count - capacity) % capacity;
+        Count = capacity;
+    }
+
+    // Keep absolute indices small. Rebasing by a multiple of the bucket ring size keeps buckets at the same place.
+    if (Written >= (1 << 30))
+    {
+        const int rebase_unit = (EnvelopeStep > 0) ? EnvelopeStep * EnvelopeMin.Size : 1;
+        const int rebase = ((Written - Count) / rebase_unit) * rebase_unit;
+        Written -= rebase;
+        EnvelopeWritten -= rebase;
+    }
+}
+
+void ImGuiPlotBuffer::InvalidateRange(int idx_begin, int idx_end)
+{
+    IM_ASSERT(idx_begin >= 0 && idx_begin <= idx_end && idx_end <= Count);
+    if (EnvelopeStep > 0)
+        PlotBufferComputeBuckets(this, Written - Count + idx_begin, Written - Count + idx_end);
+}
+
+void ImGuiPlotBuffer::UpdateEnvelope(int step)
+{
+    IM_ASSERT(step > 0);
+    const int buckets_count = Values.Size / step + 2;
+    int abs_begin = EnvelopeWritten;
+    if (step != EnvelopeStep || EnvelopeMin.Size != buckets_count)
+    {
+        EnvelopeStep = step;
+        EnvelopeMin.resize(buckets_count);
+        EnvelopeMax.resize(buckets_count);
+        abs_begin = Written - Count;
+    }
+    else if (EnvelopeWritten == Written)
+    {
+        return;
+    }
+
+    // New samples, then the oldest bucket which may have lost samples
+    PlotBufferComputeBuckets(this, abs_begin, Written);
+    if (Count > 0)
+        PlotBufferComputeBuckets(this, Written - Count, Written - Count + 1);
+    EnvelopeWritten = Written;
+}
+
+struct ImGuiPlotArrayGetterData
+{
+    const float* Values;
+    int Stride;
+
+    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
+};
+
+static float Plot_ArrayGetter(void* data, int idx)
+{
+    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
+    const float v = *(float*)(void*)((unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
+    return v;
+}
+
+static float Plot_BufferGetter(void* data, int idx)
+{
+    return ((ImGuiPlotBuffer*)data)->GetValue(idx);
+}
+
+// Reduce samples to one min/max pair per column. Returns the number of columns, which for a buffer is its number of buckets.
+static int PlotCalcEnvelope(float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int columns_count, float** out_min, float** out_max, int* out_step)
+{
+    if (values_getter == &Plot_BufferGetter)
+    {
+        // Copy the visible buckets from the cache of the buffer
+        ImGuiPlotBuffer* buf = (ImGuiPlotBuffer*)data;
+        const int step = (buf->GetCapacity() + columns_count - 1) / columns_count;
+        buf->UpdateEnvelope(step);
+        const int abs_oldest = buf->Written - buf->Count;
+        const int b0 = abs_oldest / step, b1 = (buf->Written - 1) / step;
+        const int count = b1 - b0 + 1;
+        *out_min = (float*)ImGui::MemAllocFrame((size_t)count * sizeof(float) * 2);
+        *out_max = *out_min + count;
+        for (int b = b0; b <= b1; b++)
+        {
+            (*out_min)[b - b0] = buf->EnvelopeMin[b % buf->EnvelopeMin.Size];
+            (*out_max)[b - b0] = buf->EnvelopeMax[b % buf->EnvelopeMax.Size];
+        }
+        *out_step = step;
+        return count;
+    }
+
+    const ImGuiPlotArrayGetterData* array_data = (values_getter == &Plot_ArrayGetter && ((ImGuiPlotArrayGetterData*)data)->Stride == sizeof(float)) ? (ImGuiPlotArrayGetterData*)data : NULL;
+    *out_min = (float*)ImGui::MemAllocFrame((size_t)columns_count * sizeof(float) * 2);
+    *out_max = *out_min + columns_count;
+    for (int c = 0; c < columns_count; c++)
+    {
+        const int i0 = (int)((double)values_count * c / columns_count);
+        const int i1 = (int)((double)values_count * (c + 1) / columns_count);
+        float v_min = FLT_MAX, v_max = -FLT_MAX;
+        if (array_data)
+        {
+            // Contiguous floats, in up to two parts because of 'values_offset'
+            int pos = (i0 + values_offset) % values_count;
+            const int n0 = ImMin(i1 - i0, values_count - pos);
+            PlotMinMax(array_data->Values + pos, n0, &v_min, &v_max);
+            PlotMinMax(array_data->Values, (i1 - i0) - n0, &v_min, &v_max);
+        }
+        else
+        {
+            for (int i = i0; i < i1; i++)
+            {
+                const float v = values_getter(data, (i + values_offset) % values_count);
+                v_min = ImMin(v_min, v);
+                v_max = ImMax(v_max, v);
+            }
+        }
+        (*out_min)[c] = v_min;
+        (*out_max)[c] = v_max;
+    }
+    *out_step = 0;
+    return columns_count;
+}
+
+void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiStyle& style = g.Style;
 
     const ImVec2 label_size = CalcTextSize(label, NULL, true);
     if (graph_size.x == 0.0f)
@@ -7119,16 +9295,32 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
     if (!ItemAdd(total_bb, NULL))
         return;
 
+    // With more samples than pixels, reduce them to a min/max envelope with one entry per pixel column
+    float* env_min = NULL;
+    float* env_max = NULL;
+    int env_count = 0, env_step = 0;
+    const int columns_count = ImMax((int)inner_bb.GetWidth(), 1);
+    if (values_count > columns_count * 2)
+        env_count = PlotCalcEnvelope(values_getter, data, values_count, values_offset, columns_count, &env_min, &env_max, &env_step);
+
     // Determine scale from values if not specified
     if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
         float v_min = FLT_MAX;
         float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)
+        if (env_count > 0)
         {
-            const float v = values_getter(data, i);
-            v_min = ImMin(v_min, v);
-            v_max = ImMax(v_max, v);
+            PlotMinMax(env_min, env_count, &v_min, &v_max);
+            PlotMinMax(env_max, env_count, &v_min, &v_max);
+        }
+        else
+        {
+            for (int i = 0; i < values_count; i++)
+            {
+                const float v = values_getter(data, i);
+                v_min = ImMin(v_min, v);
+                v_max = ImMax(v_max, v);
+            }
         }
         if (scale_min == FLT_MAX)
             scale_min = v_min;
@@ -7138,7 +9330,53 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
 
     RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
 
-    if (values_count > 0)
+    const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+    const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+
+    if (env_count > 0)
+    {
+        // Tooltip on hover, reporting the range of samples under the mouse
+        int c_hovered = -1;
+        if (IsHovered(inner_bb, 0))
+        {
+            const float t = ImClamp((g.IO.MousePos.x - inner_bb.Min.x) / (inner_bb.Max.x - inner_bb.Min.x), 0.0f, 0.9999f);
+            c_hovered = (int)(t * env_count);
+            int i0, i1;
+            if (env_step > 0)
+            {
+                // Buckets are aligned on absolute sample indices
+                const ImGuiPlotBuffer* buf = (const ImGuiPlotBuffer*)data;
+                const int abs_oldest = buf->Written - buf->Count;
+                i0 = ImMax((abs_oldest / env_step + c_hovered) * env_step, abs_oldest) - abs_oldest;
+                i1 = ImMin((abs_oldest / env_step + c_hovered + 1) * env_step, buf->Written) - abs_oldest;
+            }
+            else
+            {
+                i0 = (int)((double)values_count * c_hovered / env_count);
+                i1 = (int)((double)values_count * (c_hovered + 1) / env_count);
+            }
+            SetTooltip("%d..%d\nmin: %8.4g\nmax: %8.4g", i0, i1 - 1, env_min[c_hovered], env_max[c_hovered]);
+        }
+
+        // One rectangle per column. For lines, each column is extended to reach the previous one so the trace stays continuous.
+        const float scale_inv = (scale_max != scale_min) ? 1.0f / (scale_max - scale_min) : 0.0f;
+        const float col_w = inner_bb.GetWidth() / env_count;
+        for (int c = 0; c < env_count; c++)
+        {
+            float v_lo = env_min[c], v_hi = env_max[c];
+            if (plot_type == ImGuiPlotType_Lines && c > 0)
+            {
+                v_lo = ImMin(v_lo, env_max[c - 1]);
+                v_hi = ImMax(v_hi, env_min[c - 1]);
+            }
+            const float x0 = inner_bb.Min.x + col_w * c;
+            const float x1 = ImMax(inner_bb.Min.x + col_w * (c + 1), x0 + 1.0f);
+            const float y_hi = ImLerp(inner_bb.Max.y, inner_bb.Min.y, ImSaturate((v_hi - scale_min) * scale_inv));
+            const float y_lo = (plot_type == ImGuiPlotType_Lines) ? ImLerp(inner_bb.Max.y, inner_bb.Min.y, ImSaturate((v_lo - scale_min) * scale_inv)) : inner_bb.Max.y;
+            window->DrawList->AddRectFilled(ImVec2(x0, y_hi), ImVec2(x1, ImMax(y_lo, y_hi + 1.0f)), c == c_hovered ? col_hovered : col_base);
+        }
+    }
+    else if (values_count > 0)
     {
         int res_w = ImMin((int)graph_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
         int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
@@ -7166,9 +9404,6 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
         float t0 = 0.0f;
         ImVec2 tp0 = ImVec2( t0, 1.0f - ImSaturate((v0 - scale_min) / (scale_max - scale_min)) );    // Point in the normalized space of our target rectangle
 
-        const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
-        const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
-
         for (int n = 0; n < res_w; n++)
         {
             const float t1 = t0 + t_step;
@@ -7204,21 +9439,6 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
         RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
 }
 
-struct ImGuiPlotArrayGetterData
-{
-    const float* Values;
-    int Stride;
-
-    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
-};
-
-static float Plot_ArrayGetter(void* data, int idx)
-{
-    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
-    const float v = *(float*)(void*)((unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
-    return v;
-}
-
 void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
 {
     ImGuiPlotArrayGetterData data(values, stride);
@@ -7241,6 +9461,16 @@ void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data,
     PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
 }
 
+void ImGui::PlotLines(const char* label, ImGuiPlotBuffer* buffer, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    PlotEx(ImGuiPlotType_Lines, label, &Plot_BufferGetter, (void*)buffer, buffer->Count, 0, overlay_text, scale_min, scale_max, graph_size);
+}
+
+void ImGui::PlotHistogram(const char* label, ImGuiPlotBuffer* buffer, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    PlotEx(ImGuiPlotType_Histogram, label, &Plot_BufferGetter, (void*)buffer, buffer->Count, 0, overlay_text, scale_min, scale_max, graph_size);
+}
+
 // size_arg (for each axis) < 0.0f: align to end, 0.0f: auto, > 0.0f: specified size
 void ImGui::ProgressBar(float fraction, const ImVec2& size_arg, const char* overlay)
 {
@@ -7476,16 +9706,42 @@ static int     STB_TEXTEDIT_KEYTOTEXT(int key)
 static ImWchar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, STB_TEXTEDIT_STRING* obj, int line_start_idx)
 {
-    const ImWchar* text = obj->Text.Data;
-    const ImWchar* text_remaining = NULL;
-    const ImVec2 size = InputTextCalcTextSizeW(text + line_start_idx, text + obj->CurLenW, &text_remaining, NULL, true);
+    // Rows are lines, all queries go through the layout index
+    obj->UpdateLayout();
     r->x0 = 0.0f;
-    r->x1 = size.x;
-    r->baseline_y_delta = size.y;
+    r->baseline_y_delta = GImGui->FontSize;
     r->ymin = 0.0f;
-    r->ymax = size.y;
-    r->num_chars = (int)(text_remaining - (text + line_start_idx));
+    r->ymax = GImGui->FontSize;
+    if (line_start_idx >= obj->CurLenW)
+    {
+        r->x1 = 0.0f;
+        r->num_chars = 0;
+        return;
+    }
+    const int line = obj->GetLineFromChar(line_start_idx);
+    IM_ASSERT(obj->LineStarts[line] == line_start_idx);
+    const int line_end = (line + 1 < obj->LineStarts.Size) ? obj->LineStarts[line + 1] : obj->CurLenW;
+    r->x1 = obj->CharX[(line_end > line_start_idx && obj->Text[line_end - 1] == '\n') ? line_end - 1 : line_end];
+    r->num_chars = line_end - line_start_idx;
 }
+static int     STB_TEXTEDIT_LOCATEROW(STB_TEXTEDIT_STRING* obj, float y, float* out_base_y)
+{
+    obj->UpdateLayout();
+    const int line = (y <= 0.0f) ? 0 : (int)(y / GImGui->FontSize);
+    if (line >= obj->LineStarts.Size || obj->LineStarts[line] >= obj->CurLenW)
+        return obj->CurLenW;
+    *out_base_y = line * GImGui->FontSize;
+    return obj->LineStarts[line];
+}
+static int     STB_TEXTEDIT_FINDROW(STB_TEXTEDIT_STRING* obj, int n, int* out_prev_row_start, float* out_row_y)
+{
+    obj->UpdateLayout();
+    const int line = obj->GetLineFromChar(n);
+    *out_prev_row_start = obj->LineStarts[line > 0 ? line - 1 : 0];
+    *out_row_y = line * GImGui->FontSize;
+    return obj->LineStarts[line];
+}
+static float   STB_TEXTEDIT_GETX(STB_TEXTEDIT_STRING* obj, int line_start_idx, int char_idx)     { (void)line_start_idx; obj->UpdateLayout(); return obj->CharX[char_idx]; }
 
 static bool is_separator(unsigned int c)                                        { return ImCharIsSpace(c) || c==',' || c==';' || c=='(' || c==')' || c=='{' || c=='}' || c=='[' || c==']' || c=='|'; }
 static int  is_word_boundary_from_right(STB_TEXTEDIT_STRING* obj, int idx)      { return idx > 0 ? (is_separator( obj->Text[idx-1] ) && !is_separator( obj->Text[idx] ) ) : 1; }
@@ -7501,6 +9757,7 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 
 static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
 {
+    obj->InvalidateLayout(pos);
     ImWchar* dst = obj->Text.Data + pos;
 
     // We maintain our buffer length in both UTF-8 and wchar formats
@@ -7518,13 +9775,15 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
 {
     const int text_len = obj->CurLenW;
     IM_ASSERT(pos <= text_len);
-    if (new_text_len + text_len + 1 > obj->Text.Size)
-        return false;
-
     const int new_text_len_utf8 = ImTextCountUtf8BytesFromStr(new_text, new_text + new_text_len);
-    if (new_text_len_utf8 + obj->CurLenA + 1 > obj->BufSizeA)
+    if (!obj->BufResizable && new_text_len_utf8 + obj->CurLenA + 1 > obj->BufSizeA)
         return false;
 
+    // Our copy is sized to the text, grow it geometrically
+    if (new_text_len + text_len + 1 > obj->Text.Size)
+        obj->Text.resize(new_text_len + text_len + 1 + ImMax(text_len / 2, 32));
+
+    obj->InvalidateLayout(pos);
     ImWchar* text = obj->Text.Data;
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
@@ -7554,6 +9813,11 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
 #define STB_TEXTEDIT_K_WORDRIGHT    0x1000D // keyboard input to move cursor right one word
 #define STB_TEXTEDIT_K_SHIFT        0x20000
 
+// Row queries answered from the layout index (binary search) instead of laying out every row from the start of the text
+#define STB_TEXTEDIT_LOCATEROW      STB_TEXTEDIT_LOCATEROW
+#define STB_TEXTEDIT_FINDROW        STB_TEXTEDIT_FINDROW
+#define STB_TEXTEDIT_GETX           STB_TEXTEDIT_GETX
+
 #define STB_TEXTEDIT_IMPLEMENTATION
 #include "stb_textedit.h"
 
@@ -7566,6 +9830,66 @@ void ImGuiTextEditState::OnKeyPressed(int key)
     CursorAnimReset();
 }
 
+void ImGuiTextEditState::InvalidateLayout(int pos)
+{
+    // Lines starting before 'pos' are unaffected
+    LayoutDirty = true;
+    if (!LineStarts.empty())
+        LineStarts.resize(GetLineFromChar(pos) + 1);
+}
+
+void ImGuiTextEditState::UpdateLayout()
+{
+    ImGuiContext& g = *GImGui;
+    if (LayoutFont != g.Font || LayoutFontSize != g.FontSize)
+    {
+        LayoutFont = g.Font;
+        LayoutFontSize = g.FontSize;
+        LineStarts.resize(0);
+        LayoutDirty = true;
+    }
+    if (!LayoutDirty)
+        return;
+    LayoutDirty = false;
+
+    // Resume from the first line which was invalidated
+    if (LineStarts.empty())
+        LineStarts.push_back(0);
+    ImFont* font = g.Font;
+    const float scale = g.FontSize / font->FontSize;
+    CharX.resize(CurLenW + 1);
+    float x = 0.0f;
+    for (int i = LineStarts.back(); i < CurLenW; i++)
+    {
+        CharX[i] = x;
+        const unsigned int c = (unsigned int)Text[i];
+        if (c == '\n')
+        {
+            LineStarts.push_back(i + 1);
+            x = 0.0f;
+        }
+        else if (c != '\r')
+        {
+            x += font->GetCharAdvance((unsigned short)c) * scale;
+        }
+    }
+    CharX[CurLenW] = x;
+}
+
+int ImGuiTextEditState::GetLineFromChar(int n) const
+{
+    int lo = 0, hi = LineStarts.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (LineStarts[mid] <= n)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
 // Public API to manipulate UTF-8 text
 // We expose UTF-8 to the user (unlike the STB_TEXTEDIT_* functions which are manipulating wchar)
 // FIXME: The existence of this rarely exercised code path is a bit of a nuisance.
@@ -7591,7 +9915,17 @@ void ImGuiTextEditCallbackData::InsertChars(int pos, const char* new_text, const
 {
     const int new_text_len = new_text_end ? (int)(new_text_end - new_text) : (int)strlen(new_text);
     if (new_text_len + BufTextLen + 1 >= BufSize)
-        return;
+    {
+        if (!(Flags & ImGuiInputTextFlags_CallbackResize))
+            return;
+
+        // Buf is our internal copy while the widget is active, the user buffer is resized when we copy back
+        ImGuiTextEditState& edit_state = GImGui->InputTextState;
+        IM_ASSERT(Buf == edit_state.TempTextBuffer.Data);
+        edit_state.TempTextBuffer.resize(BufTextLen + new_text_len + 1 + ImMax(BufTextLen / 2, 32));
+        Buf = edit_state.TempTextBuffer.Data;
+        BufSize = edit_state.TempTextBuffer.Size;
+    }
 
     if (BufTextLen != pos)
         memmove(Buf + pos + new_text_len, Buf + pos, (size_t)(BufTextLen - pos));
@@ -7605,6 +9939,29 @@ void ImGuiTextEditCallbackData::InsertChars(int pos, const char* new_text, const
     BufTextLen += new_text_len;
 }
 
+// Ask the user to grow 'buf' so it can hold 'required_size' bytes. Returns false if the widget isn't resizable or the callback didn't comply.
+static bool InputTextResizeUserBuffer(char** p_buf, int* p_buf_size, int required_size, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
+{
+    if (!(flags & ImGuiInputTextFlags_CallbackResize))
+        return false;
+
+    ImGuiTextEditCallbackData callback_data;
+    memset(&callback_data, 0, sizeof(ImGuiTextEditCallbackData));
+    callback_data.EventFlag = ImGuiInputTextFlags_CallbackResize;
+    callback_data.Flags = flags;
+    callback_data.UserData = user_data;
+    callback_data.Buf = *p_buf;
+    callback_data.BufTextLen = required_size - 1;
+    callback_data.BufSize = required_size;
+    callback(&callback_data);
+    IM_ASSERT(callback_data.Buf != NULL && callback_data.BufSize >= required_size); // You need to provide a buffer of at least data->BufSize bytes
+    if (callback_data.Buf == NULL || callback_data.BufSize < required_size)
+        return false;
+    *p_buf = callback_data.Buf;
+    *p_buf_size = callback_data.BufSize;
+    return true;
+}
+
 // Return false to discard a character.
 static bool InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
 {
@@ -7670,6 +10027,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackHistory) && (flags & ImGuiInputTextFlags_Multiline))); // Can't use both together (they both use up/down keys)
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackCompletion) && (flags & ImGuiInputTextFlags_AllowTabInput))); // Can't use both together (they both use tab key)
+    IM_ASSERT(!(flags & ImGuiInputTextFlags_CallbackResize) || callback != NULL);
 
     ImGuiContext& g = *GImGui;
     const ImGuiIO& io = g.IO;
@@ -7747,13 +10105,16 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             // Start edition
             // Take a copy of the initial buffer value (both in original UTF-8 format and converted to wchar)
             // From the moment we focused we are ignoring the content of 'buf' (unless we are in read-only mode)
+            // Our copies are sized to the text, not to the capacity of 'buf' (grown on insertion).
             const int prev_len_w = edit_state.CurLenW;
-            edit_state.Text.resize(buf_size+1);        // wchar count <= UTF-8 count. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
-            edit_state.InitialText.resize(buf_size+1); // UTF-8. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
+            const int buf_len = (int)strlen(buf);
+            edit_state.Text.resize(buf_len+1);        // wchar count <= UTF-8 count. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
+            edit_state.InitialText.resize(buf_len+1); // UTF-8. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
             ImStrncpy(edit_state.InitialText.Data, buf, edit_state.InitialText.Size);
             const char* buf_end = NULL;
             edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
             edit_state.CurLenA = (int)(buf_end - buf); // We can't get the result from ImFormatString() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+            edit_state.InvalidateLayout(0);
             edit_state.CursorAnimReset();
 
             // Preserve cursor position and undo/redo stack if we come back to same widget
@@ -7796,14 +10157,16 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         if (!is_editable && !g.ActiveIdIsJustActivated)
         {
             // When read-only we always use the live data passed to the function
-            edit_state.Text.resize(buf_size+1);
+            edit_state.Text.resize((int)strlen(buf)+1);
             const char* buf_end = NULL;
             edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
             edit_state.CurLenA = (int)(buf_end - buf);
+            edit_state.InvalidateLayout(0);
             edit_state.CursorClamp();
         }
 
         edit_state.BufSizeA = buf_size;
+        edit_state.BufResizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
 
         // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
         // Down the line we should have a cleaner library-wide concept of Selected vs Active.
@@ -7936,7 +10299,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)ImGui::MemAlloc((clipboard_len+1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)ImGui::MemAllocFrame((clipboard_len+1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -7954,7 +10317,6 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     stb_textedit_paste(&edit_state, &edit_state.StbState, clipboard_filtered, clipboard_filtered_len);
                     edit_state.CursorFollow = true;
                 }
-                ImGui::MemFree(clipboard_filtered);
             }
         }
 
@@ -7963,6 +10325,9 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             // Restore initial value
             if (is_editable)
             {
+                const int initial_size = (int)strlen(edit_state.InitialText.Data) + 1;
+                if (initial_size > buf_size)
+                    InputTextResizeUserBuffer(&buf, &buf_size, initial_size, flags, callback, user_data);
                 ImStrncpy(buf, edit_state.InitialText.Data, buf_size);
                 value_changed = true;
             }
@@ -8017,7 +10382,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     callback_data.EventKey = event_key;
                     callback_data.Buf = edit_state.TempTextBuffer.Data;
                     callback_data.BufTextLen = edit_state.CurLenA;
-                    callback_data.BufSize = edit_state.BufSizeA;
+                    callback_data.BufSize = edit_state.BufResizable ? edit_state.TempTextBuffer.Size : edit_state.BufSizeA;
                     callback_data.BufDirty = false;
 
                     // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
@@ -8031,7 +10396,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
                     // Read back what user may have modified
                     IM_ASSERT(callback_data.Buf == edit_state.TempTextBuffer.Data);  // Invalid to modify those fields
-                    IM_ASSERT(callback_data.BufSize == edit_state.BufSizeA);
+                    IM_ASSERT(callback_data.BufSize == (edit_state.BufResizable ? edit_state.TempTextBuffer.Size : edit_state.BufSizeA));
                     IM_ASSERT(callback_data.Flags == flags);
                     if (callback_data.CursorPos != utf8_cursor_pos)            edit_state.StbState.cursor = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.CursorPos);
                     if (callback_data.SelectionStart != utf8_selection_start)  edit_state.StbState.select_start = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.SelectionStart);
@@ -8039,8 +10404,11 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     if (callback_data.BufDirty)
                     {
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
+                        if (edit_state.Text.Size < callback_data.BufTextLen + 1)
+                            edit_state.Text.resize(callback_data.BufTextLen + 1);
                         edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, callback_data.Buf, NULL);
                         edit_state.CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        edit_state.InvalidateLayout(0);
                         edit_state.CursorAnimReset();
                     }
                 }
@@ -8049,6 +10417,8 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             // Copy back to user buffer
             if (is_editable && strcmp(edit_state.TempTextBuffer.Data, buf) != 0)
             {
+                if (edit_state.CurLenA + 1 > buf_size)
+                    InputTextResizeUserBuffer(&buf, &buf_size, edit_state.CurLenA + 1, flags, callback, user_data);
                 ImStrncpy(buf, edit_state.TempTextBuffer.Data, buf_size);
                 value_changed = true;
             }
@@ -8080,169 +10450,597 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         ImVec2 cursor_offset, select_start_offset;
 
         {
-            // Count lines + find lines numbers straddling 'cursor' and 'select_start' position.
-            const ImWchar* searches_input_ptr[2];
-            searches_input_ptr[0] = text_begin + edit_state.StbState.cursor;
-            searches_input_ptr[1] = NULL;
-            int searches_remaining = 1;
-            int searches_result_line_number[2] = { -1, -999 };
+            // Find lines numbers straddling 'cursor' and 'select_start' position, using the layout index (only lines from the last edit point onward are re-measured)
+            edit_state.UpdateLayout();
+            const int cursor_pos = ImClamp(edit_state.StbState.cursor, 0, edit_state.CurLenW);
+            cursor_offset.x = edit_state.CharX[cursor_pos];
+            cursor_offset.y = (edit_state.GetLineFromChar(cursor_pos) + 1) * g.FontSize;
             if (edit_state.StbState.select_start != edit_state.StbState.select_end)
             {
-                searches_input_ptr[1] = text_begin + ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
-                searches_result_line_number[1] = -1;
-                searches_remaining++;
+                const int select_start_pos = ImClamp(ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end), 0, edit_state.CurLenW);
+                select_start_offset.x = edit_state.CharX[select_start_pos];
+                select_start_offset.y = (edit_state.GetLineFromChar(select_start_pos) + 1) * g.FontSize;
+            }
+
+            // Calculate text height
+            if (is_multiline)
+                text_size = ImVec2(size.x, edit_state.LineStarts.Size * g.FontSize);
+        }
+
+        // Scroll
+        if (edit_state.CursorFollow)
+        {
+            // Horizontal scroll in chunks of quarter width
+            if (!(flags & ImGuiInputTextFlags_NoHorizontalScroll))
+            {
+                const float scroll_increment_x = size.x * 0.25f;
+                if (cursor_offset.x < edit_state.ScrollX)
+                    edit_state.ScrollX = (float)(int)ImMax(0.0f, cursor_offset.x - scroll_increment_x);
+                else if (cursor_offset.x - size.x >= edit_state.ScrollX)
+                    edit_state.ScrollX = (float)(int)(cursor_offset.x - size.x + scroll_increment_x);
+            }
+            else
+            {
+                edit_state.ScrollX = 0.0f;
             }
 
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
+            // Vertical scroll
+            if (is_multiline)
+            {
+                float scroll_y = draw_window->Scroll.y;
+                if (cursor_offset.y - g.FontSize < scroll_y)
+                    scroll_y = ImMax(0.0f, cursor_offset.y - g.FontSize);
+                else if (cursor_offset.y - size.y >= scroll_y)
+                    scroll_y = cursor_offset.y - size.y;
+                draw_window->DC.CursorPos.y += (draw_window->Scroll.y - scroll_y);   // To avoid a frame of lag
+                draw_window->Scroll.y = scroll_y;
+                render_pos.y = draw_window->DC.CursorPos.y;
+            }
+        }
+        edit_state.CursorFollow = false;
+        const ImVec2 render_scroll = ImVec2(edit_state.ScrollX, 0.0f);
+
+        // Draw selection
+        if (edit_state.StbState.select_start != edit_state.StbState.select_end)
+        {
+            const ImWchar* text_selected_begin = text_begin + ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
+            const ImWchar* text_selected_end = text_begin + ImMax(edit_state.StbState.select_start, edit_state.StbState.select_end);
+
+            float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
+            float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
+            ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
+            ImVec2 rect_pos = render_pos + select_start_offset - render_scroll;
+            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            {
+                if (rect_pos.y > clip_rect.w + g.FontSize)
+                    break;
+                if (rect_pos.y < clip_rect.y)
                 {
-                    line_count++;
-                    if (searches_result_line_number[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_number[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_number[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_number[1] = line_count; if (--searches_remaining <= 0) break; }
+                    while (p < text_selected_end)
+                        if (*p++ == '\n')
+                            break;
                 }
-            line_count++;
-            if (searches_result_line_number[0] == -1) searches_result_line_number[0] = line_count;
-            if (searches_result_line_number[1] == -1) searches_result_line_number[1] = line_count;
+                else
+                {
+                    ImVec2 rect_size = InputTextCalcTextSizeW(p, text_selected_end, &p, NULL, true);
+                    if (rect_size.x <= 0.0f) rect_size.x = (float)(int)(g.Font->GetCharAdvance((unsigned short)' ') * 0.50f); // So we can see selected empty lines
+                    ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos +ImVec2(rect_size.x, bg_offy_dn));
+                    rect.Clip(clip_rect);
+                    if (rect.Overlaps(clip_rect))
+                        draw_window->DrawList->AddRectFilled(rect.Min, rect.Max, bg_color);
+                }
+                rect_pos.x = render_pos.x - render_scroll.x;
+                rect_pos.y += g.FontSize;
+            }
+        }
+
+        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos - render_scroll, GetColorU32(ImGuiCol_Text), buf_display, buf_display + edit_state.CurLenA, 0.0f, is_multiline ? NULL : &clip_rect);
+
+        // Draw blinking cursor
+        bool cursor_is_visible = (g.InputTextState.CursorAnim <= 0.0f) || fmodf(g.InputTextState.CursorAnim, 1.20f) <= 0.80f;
+        ImVec2 cursor_screen_pos = render_pos + cursor_offset - render_scroll;
+        ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y-g.FontSize+0.5f, cursor_screen_pos.x+1.0f, cursor_screen_pos.y-1.5f);
+        if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
+            draw_window->DrawList->AddLine(cursor_screen_rect.Min, cursor_screen_rect.GetBL(), GetColorU32(ImGuiCol_Text));
+
+        // Notify OS of text input position for advanced IME (-1 x offset so that Windows IME can cover our cursor. Bit of an extra nicety.)
+        if (is_editable)
+            g.OsImePosRequest = ImVec2(cursor_screen_pos.x - 1, cursor_screen_pos.y - g.FontSize);
+    }
+    else
+    {
+        // Render text only
+        const char* buf_end = NULL;
+        if (is_multiline)
+            text_size = ImVec2(size.x, InputTextCalcTextLenAndLineCount(buf_display, &buf_end) * g.FontSize); // We don't need width
+        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos, GetColorU32(ImGuiCol_Text), buf_display, buf_end, 0.0f, is_multiline ? NULL : &clip_rect);
+    }
+
+    if (is_multiline)
+    {
+        Dummy(text_size + ImVec2(0.0f, g.FontSize)); // Always add room to scroll an extra line
+        EndChildFrame();
+        EndGroup();
+    }
+
+    if (is_password)
+        PopFont();
+
+    // Log as text
+    if (g.LogEnabled && !is_password)
+        LogRenderedText(render_pos, buf_display, NULL);
+
+    if (label_size.x > 0)
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label);
+
+    if ((flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0)
+        return enter_pressed;
+    else
+        return value_changed;
+}
+
+bool ImGui::InputText(const char* label, char* buf, size_t buf_size, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
+{
+    IM_ASSERT(!(flags & ImGuiInputTextFlags_Multiline)); // call InputTextMultiline()
+    return InputTextEx(label, buf, (int)buf_size, ImVec2(0,0), flags, callback, user_data);
+}
+
+bool ImGui::InputTextMultiline(const char* label, char* buf, size_t buf_size, const ImVec2& size, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
+{
+    return InputTextEx(label, buf, (int)buf_size, size, flags | ImGuiInputTextFlags_Multiline, callback, user_data);
+}
+
+void ImGuiTextRopeEditState::ReplaceSelection(ImGuiTextRope* rope, const char* text, const char* text_end)
+{
+    const int pos = GetSelectionMin();
+    if (HasSelection())
+        rope->Erase(pos, GetSelectionMax() - pos);
+    rope->Insert(pos, text, text_end);
+    Cursor = SelectStart = pos + (int)(text_end - text);
+    PreferredX = -1.0f;
+    CursorFollow = true;
+    CursorAnimReset();
+}
+
+static int InputTextRopeMoveChar(const ImGuiTextRope* rope, int offset, int dir)
+{
+    const int len = rope->GetSize();
+    do { offset += dir; } while (offset > 0 && offset < len && (rope->GetChar(offset) & 0xC0) == 0x80); // Skip UTF-8 continuation bytes
+    return ImClamp(offset, 0, len);
+}
+
+// Decode the code point starting at 'offset'
+static unsigned int InputTextRopeDecodeChar(const ImGuiTextRope* rope, int offset)
+{
+    char buf[4];
+    int buf_len = 0;
+    for (; buf_len < 4 && offset + buf_len < rope->GetSize(); buf_len++)
+        buf[buf_len] = rope->GetChar(offset + buf_len);
+    unsigned int c = 0;
+    ImTextCharFromUtf8(&c, buf, buf + buf_len);
+    return c;
+}
+
+// Step by code point, so the cursor never lands within a multi-byte UTF-8 sequence
+static int InputTextRopeMoveWord(const ImGuiTextRope* rope, int offset, int dir)
+{
+    const int len = rope->GetSize();
+    offset = InputTextRopeMoveChar(rope, offset, dir);
+    while (offset > 0 && offset < len)
+    {
+        const unsigned int c_prev = InputTextRopeDecodeChar(rope, InputTextRopeMoveChar(rope, offset, -1));
+        const unsigned int c = InputTextRopeDecodeChar(rope, offset);
+        if (ImGuiStb::is_separator(c_prev) && !ImGuiStb::is_separator(c))
+            break;
+        offset = InputTextRopeMoveChar(rope, offset, dir);
+    }
+    return offset;
+}
 
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_number[0] * g.FontSize;
-            if (searches_result_line_number[1] >= 0)
+static float InputTextRopeCalcX(const char* line_begin, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    return g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, line_begin, text_end).x;
+}
+
+// Return the offset of the character boundary closest to 'x' on a line
+static int InputTextRopeLocateX(const ImGuiTextRope* rope, int line, float x)
+{
+    ImGuiContext& g = *GImGui;
+    const float scale = g.FontSize / g.Font->FontSize;
+    const char* line_end;
+    const char* line_begin = rope->GetLineText(line, &line_end);
+    const char* p = line_begin;
+    for (float line_x = 0.0f; p < line_end; )
+    {
+        unsigned int c;
+        const int c_len = ImTextCharFromUtf8(&c, p, line_end);
+        const float char_width = g.Font->GetCharAdvance((unsigned short)c) * scale;
+        if (x < line_x + char_width * 0.5f)
+            break;
+        line_x += char_width;
+        p += c_len;
+    }
+    return rope->GetLineStart(line) + (int)(p - line_begin);
+}
+
+static ImVec2 InputTextRopeCalcCursorOffset(const ImGuiTextRope* rope, int offset)
+{
+    const int line = rope->GetLineFromOffset(offset);
+    const char* line_end;
+    const char* line_begin = rope->GetLineText(line, &line_end);
+    return ImVec2(InputTextRopeCalcX(line_begin, line_begin + (offset - rope->GetLineStart(line))), (line + 1) * GImGui->FontSize);
+}
+
+// Edit a large text held in an ImGuiTextRope.
+// Unlike InputTextEx() we edit the UTF-8 storage in place: cursor/selection are byte offsets located with the rope line index, and only the lines intersecting the clip rectangle are measured and rendered.
+// FIXME: No undo/redo. The content width for horizontal scrolling only accounts for the widest line displayed so far.
+bool ImGui::InputTextMultiline(const char* label, ImGuiTextRope* rope, const ImVec2& size_arg, ImGuiInputTextFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    IM_ASSERT(!(flags & (ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory | ImGuiInputTextFlags_CallbackAlways | ImGuiInputTextFlags_CallbackCharFilter | ImGuiInputTextFlags_Password))); // Not supported
+    flags |= ImGuiInputTextFlags_Multiline;
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiIO& io = g.IO;
+    const ImGuiStyle& style = g.Style;
+    const bool is_editable = (flags & ImGuiInputTextFlags_ReadOnly) == 0;
+
+    BeginGroup(); // Open group before calling GetID() because groups tracks id created during their spawn
+    const ImGuiID id = window->GetID(label);
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    const ImVec2 size = CalcItemSize(size_arg, CalcItemWidth(), GetTextLineHeight() * 8.0f + style.FramePadding.y*2.0f); // Arbitrary default of 8 lines high
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + size);
+    if (!BeginChildFrame(id, frame_bb.GetSize(), ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        EndChildFrame();
+        EndGroup();
+        return false;
+    }
+    ImGuiWindow* draw_window = GetCurrentWindow();
+    const ImVec2 view_size = size - draw_window->ScrollbarSizes - style.FramePadding * 2.0f;
+    float* content_width = draw_window->StateStorage.GetFloatRef(id, 0.0f);
+
+    // NB: we are only allowed to access 'edit_state' if we are the active widget.
+    ImGuiTextRopeEditState& edit_state = g.InputTextRopeState;
+
+    const bool focus_requested = FocusableItemRegister(window, g.ActiveId == id, (flags & ImGuiInputTextFlags_AllowTabInput) == 0);
+    const bool hovered = IsHovered(frame_bb, id);
+    if (hovered)
+    {
+        SetHoveredID(id);
+        g.MouseCursor = ImGuiMouseCursor_TextInput;
+    }
+    const bool user_clicked = hovered && io.MouseClicked[0];
+    const bool user_scrolled = g.ActiveId == 0 && edit_state.Id == id && g.ActiveIdPreviousFrame == draw_window->GetIDNoKeepAlive("#SCROLLY");
+    if (focus_requested || user_clicked || user_scrolled)
+    {
+        if (g.ActiveId != id)
+        {
+            // Keep cursor and selection if we come back to the same widget
+            if (edit_state.Id != id)
             {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_number[1] * g.FontSize;
+                edit_state.Id = id;
+                edit_state.Cursor = edit_state.SelectStart = 0;
+                edit_state.PreferredX = -1.0f;
+            }
+            edit_state.CursorAnimReset();
+        }
+        SetActiveID(id, window);
+        FocusWindow(window);
+    }
+    else if (io.MouseClicked[0])
+    {
+        // Release focus when we click outside
+        if (g.ActiveId == id)
+            ClearActiveID();
+    }
+
+    bool value_changed = false;
+    if (g.ActiveId == id)
+    {
+        // The rope may have been modified by the application since last frame
+        edit_state.CursorClamp(rope->GetSize());
+
+        // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
+        g.ActiveIdAllowOverlap = !io.MouseDown[0];
+
+        // Mouse
+        const ImVec2 mouse_pos = io.MousePos - draw_window->DC.CursorPos;
+        const int mouse_line = ImClamp((int)(mouse_pos.y / g.FontSize), 0, rope->GetLinesCount() - 1);
+        if (hovered && io.MouseDoubleClicked[0])
+        {
+            const int offset = InputTextRopeLocateX(rope, mouse_line, mouse_pos.x);
+            edit_state.SelectStart = InputTextRopeMoveWord(rope, InputTextRopeMoveChar(rope, offset, +1), -1);
+            edit_state.Cursor = InputTextRopeMoveWord(rope, edit_state.SelectStart, +1);
+            edit_state.PreferredX = -1.0f;
+        }
+        else if (hovered && io.MouseClicked[0])
+        {
+            edit_state.Cursor = InputTextRopeLocateX(rope, mouse_line, mouse_pos.x);
+            if (!io.KeyShift)
+                edit_state.SelectStart = edit_state.Cursor;
+            edit_state.PreferredX = -1.0f;
+            edit_state.CursorAnimReset();
+        }
+        else if (io.MouseDown[0] && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+        {
+            edit_state.Cursor = InputTextRopeLocateX(rope, mouse_line, mouse_pos.x);
+            edit_state.PreferredX = -1.0f;
+            edit_state.CursorAnimReset();
+            edit_state.CursorFollow = true;
+        }
+
+        // Text input
+        if (io.InputCharacters[0])
+        {
+            // We ignore CTRL inputs, but need to allow CTRL+ALT as some keyboards (e.g. German) use AltGR - which is Alt+Ctrl - to input certain characters.
+            if (!(io.KeyCtrl && !io.KeyAlt) && is_editable)
+            {
+                char utf8_buf[IM_ARRAYSIZE(io.InputCharacters) * 4];
+                int utf8_len = 0;
+                for (int n = 0; n < IM_ARRAYSIZE(io.InputCharacters) && io.InputCharacters[n]; n++)
+                {
+                    unsigned int c = (unsigned int)io.InputCharacters[n];
+                    if (InputTextFilterCharacter(&c, flags, NULL, NULL))
+                        utf8_len += ImTextCharToUtf8(utf8_buf + utf8_len, IM_ARRAYSIZE(utf8_buf) - utf8_len, c);
+                }
+                if (utf8_len > 0)
+                {
+                    edit_state.ReplaceSelection(rope, utf8_buf, utf8_buf + utf8_len);
+                    value_changed = true;
+                }
+            }
+            memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
+        }
+
+        // Keys
+        const bool is_shortcut_key_only = (io.OSXBehaviors ? (io.KeySuper && !io.KeyCtrl) : (io.KeyCtrl && !io.KeySuper)) && !io.KeyAlt && !io.KeyShift; // OS X style: Shortcuts using Cmd/Super instead of Ctrl
+        const bool is_wordmove_key_down = io.OSXBehaviors ? io.KeyAlt : io.KeyCtrl;                     // OS X style: Text editing cursor movement using Alt instead of Ctrl
+        const bool is_startend_key_down = io.OSXBehaviors && io.KeySuper && !io.KeyCtrl && !io.KeyAlt;  // OS X style: Line/Text Start and End using Cmd+Arrows instead of Home/End
+        const int cursor = edit_state.Cursor;
+        const int page_lines = ImMax(1, (int)(view_size.y / g.FontSize) - 1);
+        int move_lines = 0;
+        int new_cursor = -1;
+        if (IsKeyPressedMap(ImGuiKey_LeftArrow))
+        {
+            if (edit_state.HasSelection() && !io.KeyShift && !is_wordmove_key_down && !is_startend_key_down) new_cursor = edit_state.GetSelectionMin();
+            else if (is_startend_key_down) new_cursor = rope->GetLineStart(rope->GetLineFromOffset(cursor));
+            else new_cursor = is_wordmove_key_down ? InputTextRopeMoveWord(rope, cursor, -1) : InputTextRopeMoveChar(rope, cursor, -1);
+        }
+        else if (IsKeyPressedMap(ImGuiKey_RightArrow))
+        {
+            if (edit_state.HasSelection() && !io.KeyShift && !is_wordmove_key_down && !is_startend_key_down) new_cursor = edit_state.GetSelectionMax();
+            else if (is_startend_key_down) { const int line = rope->GetLineFromOffset(cursor); const char* line_end; const char* line_begin = rope->GetLineText(line, &line_end); new_cursor = rope->GetLineStart(line) + (int)(line_end - line_begin); }
+            else new_cursor = is_wordmove_key_down ? InputTextRopeMoveWord(rope, cursor, +1) : InputTextRopeMoveChar(rope, cursor, +1);
+        }
+        else if (IsKeyPressedMap(ImGuiKey_UpArrow))     { if (io.KeyCtrl) SetWindowScrollY(draw_window, ImMax(draw_window->Scroll.y - g.FontSize, 0.0f)); else if (is_startend_key_down) new_cursor = 0; else move_lines = -1; }
+        else if (IsKeyPressedMap(ImGuiKey_DownArrow))   { if (io.KeyCtrl) SetWindowScrollY(draw_window, ImMin(draw_window->Scroll.y + g.FontSize, GetScrollMaxY())); else if (is_startend_key_down) new_cursor = rope->GetSize(); else move_lines = +1; }
+        else if (IsKeyPressedMap(ImGuiKey_PageUp))      { move_lines = -page_lines; }
+        else if (IsKeyPressedMap(ImGuiKey_PageDown))    { move_lines = +page_lines; }
+        else if (IsKeyPressedMap(ImGuiKey_Home))        { new_cursor = io.KeyCtrl ? 0 : rope->GetLineStart(rope->GetLineFromOffset(cursor)); }
+        else if (IsKeyPressedMap(ImGuiKey_End))
+        {
+            const int line = io.KeyCtrl ? rope->GetLinesCount() - 1 : rope->GetLineFromOffset(cursor);
+            const char* line_end;
+            const char* line_begin = rope->GetLineText(line, &line_end);
+            new_cursor = rope->GetLineStart(line) + (int)(line_end - line_begin);
+        }
+        else if ((IsKeyPressedMap(ImGuiKey_Delete) || IsKeyPressedMap(ImGuiKey_Backspace)) && is_editable)
+        {
+            if (!edit_state.HasSelection())
+            {
+                const bool forward = IsKeyPressedMap(ImGuiKey_Delete);
+                edit_state.SelectStart = forward ? (is_wordmove_key_down ? InputTextRopeMoveWord(rope, cursor, +1) : InputTextRopeMoveChar(rope, cursor, +1)) : (is_wordmove_key_down ? InputTextRopeMoveWord(rope, cursor, -1) : InputTextRopeMoveChar(rope, cursor, -1));
+            }
+            if (edit_state.HasSelection())
+            {
+                edit_state.ReplaceSelection(rope, "", "");
+                value_changed = true;
+            }
+        }
+        else if (IsKeyPressedMap(ImGuiKey_Enter))
+        {
+            const bool ctrl_enter_for_new_line = (flags & ImGuiInputTextFlags_CtrlEnterForNewLine) != 0;
+            unsigned int c = '\n';
+            if ((ctrl_enter_for_new_line && !io.KeyCtrl) || (!ctrl_enter_for_new_line && io.KeyCtrl))
+                ClearActiveID();
+            else if (is_editable && InputTextFilterCharacter(&c, flags, NULL, NULL))
+            {
+                edit_state.ReplaceSelection(rope, "\n", "\n" + 1);
+                value_changed = true;
+            }
+        }
+        else if ((flags & ImGuiInputTextFlags_AllowTabInput) && IsKeyPressedMap(ImGuiKey_Tab) && !io.KeyCtrl && !io.KeyShift && !io.KeyAlt && is_editable)
+        {
+            unsigned int c = '\t';
+            if (InputTextFilterCharacter(&c, flags, NULL, NULL))
+            {
+                edit_state.ReplaceSelection(rope, "\t", "\t" + 1);
+                value_changed = true;
+            }
+        }
+        else if (IsKeyPressedMap(ImGuiKey_Escape))
+        {
+            ClearActiveID();
+        }
+        else if (is_shortcut_key_only && IsKeyPressedMap(ImGuiKey_A))
+        {
+            edit_state.SelectStart = 0;
+            edit_state.Cursor = rope->GetSize();
+            edit_state.CursorFollow = true;
+        }
+        else if (is_shortcut_key_only && ((IsKeyPressedMap(ImGuiKey_X) && is_editable) || IsKeyPressedMap(ImGuiKey_C)) && edit_state.HasSelection())
+        {
+            // Cut, Copy
+            const int sel_min = edit_state.GetSelectionMin();
+            const int sel_len = edit_state.GetSelectionMax() - sel_min;
+            if (io.SetClipboardTextFn)
+            {
+                edit_state.TempTextBuffer.resize(sel_len + 1);
+                rope->CopyText(sel_min, sel_len, edit_state.TempTextBuffer.Data);
+                edit_state.TempTextBuffer[sel_len] = 0;
+                SetClipboardText(edit_state.TempTextBuffer.Data);
+            }
+            if (IsKeyPressedMap(ImGuiKey_X))
+            {
+                edit_state.ReplaceSelection(rope, "", "");
+                value_changed = true;
+            }
+        }
+        else if (is_shortcut_key_only && IsKeyPressedMap(ImGuiKey_V) && is_editable)
+        {
+            // Paste
+            if (const char* clipboard = GetClipboardText())
+            {
+                // Filter pasted buffer
+                const int clipboard_len = (int)strlen(clipboard);
+                char* clipboard_filtered = (char*)ImGui::MemAllocFrame((size_t)clipboard_len + 1);
+                int clipboard_filtered_len = 0;
+                for (const char* p = clipboard; *p; )
+                {
+                    unsigned int c;
+                    p += ImTextCharFromUtf8(&c, p, NULL);
+                    if (c == 0)
+                        break;
+                    if (c >= 0x10000 || !InputTextFilterCharacter(&c, flags, NULL, NULL))
+                        continue;
+                    clipboard_filtered_len += ImTextCharToUtf8(clipboard_filtered + clipboard_filtered_len, clipboard_len + 1 - clipboard_filtered_len, c);
+                }
+                if (clipboard_filtered_len > 0) // If everything was filtered, ignore the pasting operation
+                {
+                    edit_state.ReplaceSelection(rope, clipboard_filtered, clipboard_filtered + clipboard_filtered_len);
+                    value_changed = true;
+                }
             }
+        }
 
-            // Calculate text height
-            if (is_multiline)
-                text_size = ImVec2(size.x, line_count * g.FontSize);
+        if (move_lines != 0)
+        {
+            // Keep the x position while moving up/down
+            const int line = rope->GetLineFromOffset(cursor);
+            const int target_line = ImClamp(line + move_lines, 0, rope->GetLinesCount() - 1);
+            if (edit_state.PreferredX < 0.0f)
+                edit_state.PreferredX = InputTextRopeCalcCursorOffset(rope, cursor).x;
+            new_cursor = (target_line == line && move_lines < 0) ? 0 : (target_line == line && move_lines > 0) ? rope->GetSize() : InputTextRopeLocateX(rope, target_line, edit_state.PreferredX);
+        }
+        if (new_cursor >= 0)
+        {
+            edit_state.Cursor = new_cursor;
+            if (!io.KeyShift)
+                edit_state.SelectStart = new_cursor;
+            if (move_lines == 0)
+                edit_state.PreferredX = -1.0f;
+            edit_state.CursorFollow = true;
+            edit_state.CursorAnimReset();
         }
+    }
 
-        // Scroll
+    // Render
+    const bool is_currently_scrolling = (edit_state.Id == id && g.ActiveId == draw_window->GetIDNoKeepAlive("#SCROLLY"));
+    const bool show_cursor = (g.ActiveId == id) || is_currently_scrolling;
+    ImVec2 cursor_offset(0.0f, 0.0f);
+    if (show_cursor)
+    {
+        edit_state.CursorAnim += io.DeltaTime;
+        cursor_offset = InputTextRopeCalcCursorOffset(rope, edit_state.Cursor);
+
+        // Scroll to keep the cursor visible. Horizontal scroll in chunks of quarter width.
         if (edit_state.CursorFollow)
         {
-            // Horizontal scroll in chunks of quarter width
-            if (!(flags & ImGuiInputTextFlags_NoHorizontalScroll))
-            {
-                const float scroll_increment_x = size.x * 0.25f;
-                if (cursor_offset.x < edit_state.ScrollX)
-                    edit_state.ScrollX = (float)(int)ImMax(0.0f, cursor_offset.x - scroll_increment_x);
-                else if (cursor_offset.x - size.x >= edit_state.ScrollX)
-                    edit_state.ScrollX = (float)(int)(cursor_offset.x - size.x + scroll_increment_x);
-            }
-            else
-            {
-                edit_state.ScrollX = 0.0f;
-            }
-
-            // Vertical scroll
-            if (is_multiline)
-            {
-                float scroll_y = draw_window->Scroll.y;
-                if (cursor_offset.y - g.FontSize < scroll_y)
-                    scroll_y = ImMax(0.0f, cursor_offset.y - g.FontSize);
-                else if (cursor_offset.y - size.y >= scroll_y)
-                    scroll_y = cursor_offset.y - size.y;
-                draw_window->DC.CursorPos.y += (draw_window->Scroll.y - scroll_y);   // To avoid a frame of lag
-                draw_window->Scroll.y = scroll_y;
-                render_pos.y = draw_window->DC.CursorPos.y;
-            }
+            float scroll_x = draw_window->Scroll.x;
+            if (cursor_offset.x < scroll_x)
+                scroll_x = (float)(int)ImMax(0.0f, cursor_offset.x - view_size.x * 0.25f);
+            else if (cursor_offset.x - view_size.x >= scroll_x)
+                scroll_x = (float)(int)(cursor_offset.x - view_size.x + view_size.x * 0.25f);
+            float scroll_y = draw_window->Scroll.y;
+            if (cursor_offset.y - g.FontSize < scroll_y)
+                scroll_y = ImMax(0.0f, cursor_offset.y - g.FontSize);
+            else if (cursor_offset.y - view_size.y >= scroll_y)
+                scroll_y = cursor_offset.y - view_size.y;
+            draw_window->DC.CursorPos += (draw_window->Scroll - ImVec2(scroll_x, scroll_y));   // To avoid a frame of lag
+            draw_window->Scroll = ImVec2(scroll_x, scroll_y);
+            *content_width = ImMax(*content_width, cursor_offset.x + view_size.x * 0.25f);
         }
         edit_state.CursorFollow = false;
-        const ImVec2 render_scroll = ImVec2(edit_state.ScrollX, 0.0f);
+    }
 
-        // Draw selection
-        if (edit_state.StbState.select_start != edit_state.StbState.select_end)
+    // Only visit the lines intersecting the clip rectangle
+    const ImVec2 render_pos = draw_window->DC.CursorPos;
+    const int lines_count = rope->GetLinesCount();
+    const int line_first = ImClamp((int)((draw_window->ClipRect.Min.y - render_pos.y) / g.FontSize), 0, lines_count);
+    const int line_last = ImClamp((int)((draw_window->ClipRect.Max.y - render_pos.y) / g.FontSize) + 1, line_first, lines_count);
+    if (line_first < line_last)
+    {
+        const int sel_min = show_cursor ? edit_state.GetSelectionMin() : 0;
+        const int sel_max = show_cursor ? edit_state.GetSelectionMax() : 0;
+        const ImU32 text_col = GetColorU32(ImGuiCol_Text);
+        const ImU32 sel_col = GetColorU32(ImGuiCol_TextSelectedBg);
+
+        int chunk_idx = rope->FindChunkFromLine(line_first);
+        int line_offset = rope->GetLineStart(line_first);
+        const char* line_end;
+        const char* line_begin = rope->GetLineText(line_first, &line_end);
+        for (int line = line_first; line < line_last; line++)
         {
-            const ImWchar* text_selected_begin = text_begin + ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
-            const ImWchar* text_selected_end = text_begin + ImMax(edit_state.StbState.select_start, edit_state.StbState.select_end);
+            const ImVec2 line_pos(render_pos.x, render_pos.y + line * g.FontSize);
+            const int line_len = (int)(line_end - line_begin);
+            const float line_width = InputTextRopeCalcX(line_begin, line_end);
+            *content_width = ImMax(*content_width, line_width);
 
-            float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
-            float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
-            ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
-            ImVec2 rect_pos = render_pos + select_start_offset - render_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            // Draw selection
+            if (sel_min < sel_max && sel_min <= line_offset + line_len && sel_max > line_offset)
             {
-                if (rect_pos.y > clip_rect.w + g.FontSize)
-                    break;
-                if (rect_pos.y < clip_rect.y)
-                {
-                    while (p < text_selected_end)
-                        if (*p++ == '\n')
-                            break;
-                }
-                else
-                {
-                    ImVec2 rect_size = InputTextCalcTextSizeW(p, text_selected_end, &p, NULL, true);
-                    if (rect_size.x <= 0.0f) rect_size.x = (float)(int)(g.Font->GetCharAdvance((unsigned short)' ') * 0.50f); // So we can see selected empty lines
-                    ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos +ImVec2(rect_size.x, bg_offy_dn));
-                    rect.Clip(clip_rect);
-                    if (rect.Overlaps(clip_rect))
-                        draw_window->DrawList->AddRectFilled(rect.Min, rect.Max, bg_color);
-                }
-                rect_pos.x = render_pos.x - render_scroll.x;
-                rect_pos.y += g.FontSize;
+                const float x0 = (sel_min > line_offset) ? InputTextRopeCalcX(line_begin, line_begin + (sel_min - line_offset)) : 0.0f;
+                const float x1 = (sel_max <= line_offset + line_len) ? InputTextRopeCalcX(line_begin, line_begin + (sel_max - line_offset)) : line_width + (float)(int)(g.Font->GetCharAdvance((unsigned short)' ') * 0.50f); // So we can see selected new lines
+                draw_window->DrawList->AddRectFilled(line_pos + ImVec2(x0, 0.0f), line_pos + ImVec2(x1, g.FontSize), sel_col);
             }
-        }
+            draw_window->DrawList->AddText(g.Font, g.FontSize, line_pos, text_col, line_begin, line_end);
+            if (g.LogEnabled)
+                LogRenderedText(line_pos, line_begin, line_end);
 
-        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos - render_scroll, GetColorU32(ImGuiCol_Text), buf_display, buf_display + edit_state.CurLenA, 0.0f, is_multiline ? NULL : &clip_rect);
+            // Step to the next line, which starts either in the same chunk or at the beginning of the next one
+            if (line + 1 == line_last)
+                break;
+            const ImGuiTextRope::Chunk* chunk = &rope->Chunks[chunk_idx];
+            line_offset += line_len + 1;
+            if (line_end + 1 < chunk->Data + chunk->Size)
+                line_begin = line_end + 1;
+            else if (chunk_idx + 1 < rope->Chunks.Size)
+                line_begin = (chunk = &rope->Chunks[++chunk_idx])->Data;
+            else
+                line_begin = chunk->Data + chunk->Size;
+            line_end = (const char*)memchr(line_begin, '\n', (size_t)(chunk->Data + chunk->Size - line_begin));
+            if (!line_end)
+                line_end = chunk->Data + chunk->Size;
+        }
+    }
 
+    if (show_cursor)
+    {
         // Draw blinking cursor
-        bool cursor_is_visible = (g.InputTextState.CursorAnim <= 0.0f) || fmodf(g.InputTextState.CursorAnim, 1.20f) <= 0.80f;
-        ImVec2 cursor_screen_pos = render_pos + cursor_offset - render_scroll;
+        bool cursor_is_visible = (edit_state.CursorAnim <= 0.0f) || fmodf(edit_state.CursorAnim, 1.20f) <= 0.80f;
+        ImVec2 cursor_screen_pos = render_pos + cursor_offset;
         ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y-g.FontSize+0.5f, cursor_screen_pos.x+1.0f, cursor_screen_pos.y-1.5f);
-        if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
+        if (cursor_is_visible && cursor_screen_rect.Overlaps(draw_window->ClipRect))
             draw_window->DrawList->AddLine(cursor_screen_rect.Min, cursor_screen_rect.GetBL(), GetColorU32(ImGuiCol_Text));
 
         // Notify OS of text input position for advanced IME (-1 x offset so that Windows IME can cover our cursor. Bit of an extra nicety.)
         if (is_editable)
             g.OsImePosRequest = ImVec2(cursor_screen_pos.x - 1, cursor_screen_pos.y - g.FontSize);
     }
-    else
-    {
-        // Render text only
-        const char* buf_end = NULL;
-        if (is_multiline)
-            text_size = ImVec2(size.x, InputTextCalcTextLenAndLineCount(buf_display, &buf_end) * g.FontSize); // We don't need width
-        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos, GetColorU32(ImGuiCol_Text), buf_display, buf_end, 0.0f, is_multiline ? NULL : &clip_rect);
-    }
-
-    if (is_multiline)
-    {
-        Dummy(text_size + ImVec2(0.0f, g.FontSize)); // Always add room to scroll an extra line
-        EndChildFrame();
-        EndGroup();
-    }
-
-    if (is_password)
-        PopFont();
 
-    // Log as text
-    if (g.LogEnabled && !is_password)
-        LogRenderedText(render_pos, buf_display, NULL);
+    Dummy(ImVec2(*content_width, (lines_count + 1) * g.FontSize)); // Always add room to scroll an extra line
+    EndChildFrame();
+    EndGroup();
 
     if (label_size.x > 0)
         RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label);
 
-    if ((flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0)
-        return enter_pressed;
-    else
-        return value_changed;
-}
-
-bool ImGui::InputText(const char* label, char* buf, size_t buf_size, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
-{
-    IM_ASSERT(!(flags & ImGuiInputTextFlags_Multiline)); // call InputTextMultiline()
-    return InputTextEx(label, buf, (int)buf_size, ImVec2(0,0), flags, callback, user_data);
-}
-
-bool ImGui::InputTextMultiline(const char* label, char* buf, size_t buf_size, const ImVec2& size, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
-{
-    return InputTextEx(label, buf, (int)buf_size, size, flags | ImGuiInputTextFlags_Multiline, callback, user_data);
+    return value_changed;
 }
 
 // NB: scalar_format here must be a simple "%xx" format string with no prefix/suffix (unlike the Drag/Slider functions "display_format" argument)
@@ -9518,6 +12316,175 @@ void ImGui::Columns(int columns_count, const char* id, bool border)
     }
 }
 
+void ImGuiGridCallbackData::SetCellText(int row, int column, const char* text, const char* text_end)
+{
+    IM_ASSERT(row >= RowBegin && row < RowEnd && column >= ColumnBegin && column < ColumnEnd);
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int offset = TextBuf.Size;
+    TextBuf.resize(offset + (int)(text_end - text) + 1);
+    memcpy(TextBuf.Data + offset, text, (size_t)(text_end - text));
+    TextBuf[TextBuf.Size - 1] = 0;
+    TextOffsets[(row - RowBegin) * (ColumnEnd - ColumnBegin) + (column - ColumnBegin)] = offset;
+}
+
+void ImGuiGridCallbackData::SetCellTextf(int row, int column, const char* fmt, ...)
+{
+    ImGuiContext& g = *GImGui;
+    va_list args;
+    va_start(args, fmt);
+    const int len = ImFormatStringV(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), fmt, args);
+    va_end(args);
+    SetCellText(row, column, g.TempBuffer, g.TempBuffer + len);
+}
+
+// Index of the column containing 'x' (relative to the left of the grid), clamped to [column_min, column_max]
+static int GridFindColumn(const float* columns_x, int column_min, int column_max, float x)
+{
+    while (column_min < column_max)
+    {
+        const int mid = (column_min + column_max + 1) >> 1;
+        if (columns_x[mid] <= x)
+            column_min = mid;
+        else
+            column_max = mid - 1;
+    }
+    return column_min;
+}
+
+// Request then draw the cells [row_begin,row_end) x [column_begin,column_end). 'pos' is the screen position of the top-left corner of 'row_begin' in column 0.
+static void GridRenderCells(ImGuiWindow* window, ImGuiGridCallback cells_callback, void* user_data, int row_begin, int row_end, int column_begin, int column_end, const float* columns_x, float row_height, ImVec2 pos, const ImRect& clip_rect, ImU32 bg_col, int hovered_row, int hovered_column)
+{
+    if (row_begin >= row_end || column_begin >= column_end || clip_rect.Min.x >= clip_rect.Max.x || clip_rect.Min.y >= clip_rect.Max.y)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    ImGuiGridCallbackData& data = g.GridCallbackData;
+    data.UserData = user_data;
+    data.RowBegin = row_begin;
+    data.RowEnd = row_end;
+    data.ColumnBegin = column_begin;
+    data.ColumnEnd = column_end;
+    data.TextBuf.resize(0);
+    data.TextOffsets.resize((row_end - row_begin) * (column_end - column_begin));
+    memset(data.TextOffsets.Data, 0xFF, (size_t)data.TextOffsets.Size * sizeof(int));
+    cells_callback(&data);
+
+    ImDrawList* draw_list = window->DrawList;
+    draw_list->PushClipRect(clip_rect.Min, clip_rect.Max, true);
+    const float x0 = pos.x + columns_x[column_begin], x1 = pos.x + columns_x[column_end];
+    const float y1 = pos.y + (row_end - row_begin) * row_height;
+    if (bg_col != 0)
+        draw_list->AddRectFilled(ImVec2(x0, pos.y), ImVec2(x1, y1), bg_col);
+    if (hovered_row >= row_begin && hovered_row < row_end && hovered_column >= column_begin && hovered_column < column_end)
+    {
+        const float hy = pos.y + (hovered_row - row_begin) * row_height;
+        draw_list->AddRectFilled(ImVec2(pos.x + columns_x[hovered_column], hy), ImVec2(pos.x + columns_x[hovered_column + 1], hy + row_height), ImGui::GetColorU32(ImGuiCol_HeaderHovered));
+    }
+
+    const float pad_x = g.Style.ItemInnerSpacing.x;
+    const float pad_y = (row_height - g.FontSize) * 0.5f;
+    for (int row = row_begin; row < row_end; row++)
+    {
+        const float cell_y = pos.y + (row - row_begin) * row_height;
+        for (int column = column_begin; column < column_end; column++)
+            if (const char* text = data.GetCellText(row, column))
+            {
+                const ImVec2 cell_min(pos.x + columns_x[column] + pad_x, cell_y + pad_y);
+                const ImVec2 cell_max(pos.x + columns_x[column + 1] - pad_x, cell_y + row_height);
+                ImGui::RenderTextClipped(cell_min, cell_max, text, NULL, NULL, ImVec2(0.0f, 0.0f), &clip_rect);
+            }
+    }
+
+    // Column separators
+    const ImU32 col_column = ImGui::GetColorU32(ImGuiCol_Column);
+    for (int column = column_begin + 1; column <= column_end; column++)
+    {
+        const float x = (float)(int)(pos.x + columns_x[column]) - 1.0f;
+        draw_list->AddLine(ImVec2(x, pos.y), ImVec2(x, y1), col_column);
+    }
+    draw_list->PopClipRect();
+}
+
+bool ImGui::Grid(const char* str_id, ImGuiGridCallback cells_callback, void* user_data, int rows_count, int columns_count, const float* columns_width, int frozen_rows, int frozen_columns, const ImVec2& size_arg, int* out_clicked_row, int* out_clicked_column)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(cells_callback != NULL && rows_count >= 0 && columns_count >= 0);
+    frozen_rows = ImClamp(frozen_rows, 0, rows_count);
+    frozen_columns = ImClamp(frozen_columns, 0, columns_count);
+
+    // Position of each column from the left of the grid
+    float* columns_x = (float*)MemAllocFrame((size_t)(columns_count + 1) * sizeof(float));
+    columns_x[0] = 0.0f;
+    for (int column = 0; column < columns_count; column++)
+        columns_x[column + 1] = columns_x[column] + (columns_width ? columns_width[column] : g.FontSize * 8.0f);
+    const float row_height = GetTextLineHeightWithSpacing();
+    const ImVec2 frozen_size(columns_x[frozen_columns], frozen_rows * row_height);
+
+    // The child window provides scrolling over the size of the whole grid, but we never submit items for it
+    SetNextWindowContentSize(ImVec2(columns_x[columns_count], rows_count * row_height));
+    PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+    if (!BeginChild(str_id, size_arg, true, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        EndChild();
+        PopStyleVar();
+        return false;
+    }
+
+    // Rows/columns are located from the scroll offset, so the cost only depends on the number of visible cells.
+    // The first visible row is computed in double precision to stay accurate for millions of rows.
+    ImGuiWindow* window = GetCurrentWindow();
+    const ImRect view = window->ClipRect;
+    const ImVec2 origin = window->DC.CursorStartPos + window->Scroll;  // Top-left corner of the grid on screen, unscrolled
+    const ImVec2 body_min = origin + frozen_size;
+    const double scroll_rows = (double)window->Scroll.y / row_height;
+    const int row_begin = ImMin(frozen_rows + (int)scroll_rows, rows_count);
+    const float row_begin_y = body_min.y - (float)((scroll_rows - (int)scroll_rows) * row_height);
+    const int row_end = ImMin(row_begin + (int)((view.Max.y - row_begin_y) / row_height) + 1, rows_count);
+    const float scroll_x = window->Scroll.x;
+    const int column_begin = (frozen_columns < columns_count) ? GridFindColumn(columns_x, frozen_columns, columns_count - 1, frozen_size.x + scroll_x) : columns_count;
+    const int column_end = (frozen_columns < columns_count) ? GridFindColumn(columns_x, column_begin, columns_count - 1, view.Max.x - origin.x + scroll_x) + 1 : columns_count;
+
+    // Hovered cell
+    int hovered_row = -1, hovered_column = -1;
+    const ImVec2 mouse_pos = g.IO.MousePos;
+    if (IsWindowHovered() && view.Contains(mouse_pos))
+    {
+        if (mouse_pos.y < body_min.y)
+            hovered_row = (int)((mouse_pos.y - origin.y) / row_height);
+        else
+            hovered_row = row_begin + (int)((mouse_pos.y - row_begin_y) / row_height);
+        const float mx = (mouse_pos.x < body_min.x) ? (mouse_pos.x - origin.x) : (mouse_pos.x - origin.x + scroll_x);
+        hovered_column = (columns_count > 0 && mx < columns_x[columns_count]) ? GridFindColumn(columns_x, 0, columns_count - 1, mx) : -1;
+        if (hovered_row >= rows_count || hovered_column < 0)
+            hovered_row = hovered_column = -1;
+    }
+
+    // Scrolling cells, frozen columns, frozen rows, then the frozen corner
+    const ImU32 header_bg_col = GetColorU32(ImGuiCol_Header);
+    GridRenderCells(window, cells_callback, user_data, row_begin, row_end, column_begin, column_end, columns_x, row_height, ImVec2(origin.x - scroll_x, row_begin_y), ImRect(body_min, view.Max), 0, hovered_row, hovered_column);
+    GridRenderCells(window, cells_callback, user_data, row_begin, row_end, 0, frozen_columns, columns_x, row_height, ImVec2(origin.x, row_begin_y), ImRect(ImVec2(view.Min.x, body_min.y), ImVec2(ImMin(body_min.x, view.Max.x), view.Max.y)), 0, hovered_row, hovered_column);
+    GridRenderCells(window, cells_callback, user_data, 0, frozen_rows, column_begin, column_end, columns_x, row_height, ImVec2(origin.x - scroll_x, origin.y), ImRect(ImVec2(body_min.x, view.Min.y), ImVec2(view.Max.x, ImMin(body_min.y, view.Max.y))), header_bg_col, hovered_row, hovered_column);
+    GridRenderCells(window, cells_callback, user_data, 0, frozen_rows, 0, frozen_columns, columns_x, row_height, origin, ImRect(view.Min, ImMin(body_min, view.Max)), header_bg_col, hovered_row, hovered_column);
+
+    // Separators between the frozen and scrolling parts
+    const ImU32 border_col = GetColorU32(ImGuiCol_Border);
+    if (frozen_rows > 0)
+        window->DrawList->AddLine(ImVec2(view.Min.x, body_min.y - 1.0f), ImVec2(ImMin(origin.x + columns_x[columns_count] - scroll_x, view.Max.x), body_min.y - 1.0f), border_col);
+    if (frozen_columns > 0)
+        window->DrawList->AddLine(ImVec2(body_min.x - 1.0f, view.Min.y), ImVec2(body_min.x - 1.0f, ImMin(row_begin_y + (row_end - row_begin) * row_height, view.Max.y)), border_col);
+
+    const bool clicked = (hovered_row >= 0 && IsMouseClicked(0));
+    if (clicked)
+    {
+        if (out_clicked_row) *out_clicked_row = hovered_row;
+        if (out_clicked_column) *out_clicked_column = hovered_column;
+    }
+    EndChild();
+    PopStyleVar();
+    return clicked;
+}
+
 void ImGui::Indent(float indent_w)
 {
     ImGuiContext& g = *GImGui;
@@ -9614,12 +12581,93 @@ void ImGui::ValueColor(const char* prefix, ImU32 v)
 // PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
 
-#if defined(_WIN32) && !defined(_WINDOWS_) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCS))
+// Always needed on Windows by ImTimeNow() (QueryPerformanceCounter), ImFileReplace() and ImThreadYield(). Keep it lean and without min/max macros.
+#if defined(_WIN32) && !defined(_WINDOWS_)
 #undef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <windows.h>
 #endif
 
+// Replace dst_filename with src_filename atomically (as far as the file system allows)
+#if defined(_WIN32)
+
+static bool ImFileReplace(const char* src_filename, const char* dst_filename)
+{
+    return MoveFileExA(src_filename, dst_filename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+static bool ImFileReplace(const char* src_filename, const char* dst_filename)
+{
+    return rename(src_filename, dst_filename) == 0;
+}
+
+#endif
+
+// Yield the processor to another thread
+#if defined(_WIN32)
+
+void ImThreadYield()
+{
+    SwitchToThread();
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#include <sched.h>
+void ImThreadYield()
+{
+    sched_yield();
+}
+
+#else
+
+void ImThreadYield()
+{
+}
+
+#endif
+
+// Monotonic clock
+#if defined(_WIN32)
+
+double ImTimeNow()
+{
+    static IM_THREAD_LOCAL LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+#elif defined(__APPLE__)
+
+#include <mach/mach_time.h>
+double ImTimeNow()
+{
+    static IM_THREAD_LOCAL mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+    return (double)mach_absolute_time() * (double)timebase.numer / (double)timebase.denom * 1e-9;
+}
+
+#else
+
+#include <time.h>
+double ImTimeNow()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#endif
+
 // Win32 API clipboard implementation
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCS)
 
@@ -9629,22 +12677,30 @@ void ImGui::ValueColor(const char* prefix, ImU32 v)
 
 static const char* GetClipboardTextFn_DefaultImpl(void*)
 {
-    static ImVector<char> buf_local;
-    buf_local.clear();
+    // The returned text is stored in the context, so each context/thread owns its copy
+    ImGuiContext& g = *GImGui;
+    if (g.PrivateClipboard)
+    {
+        ImGui::MemFree(g.PrivateClipboard);
+        g.PrivateClipboard = NULL;
+    }
     if (!OpenClipboard(NULL))
         return NULL;
     HANDLE wbuf_handle = GetClipboardData(CF_UNICODETEXT);
     if (wbuf_handle == NULL)
+    {
+        CloseClipboard();
         return NULL;
+    }
     if (ImWchar* wbuf_global = (ImWchar*)GlobalLock(wbuf_handle))
     {
         int buf_len = ImTextCountUtf8BytesFromStr(wbuf_global, NULL) + 1;
-        buf_local.resize(buf_len);
-        ImTextStrToUtf8(buf_local.Data, buf_len, wbuf_global, NULL);
+        g.PrivateClipboard = (char*)ImGui::MemAlloc((size_t)buf_len);
+        ImTextStrToUtf8(g.PrivateClipboard, buf_len, wbuf_global, NULL);
     }
     GlobalUnlock(wbuf_handle);
     CloseClipboard();
-    return buf_local.Data;
+    return g.PrivateClipboard;
 }
 
 static void SetClipboardTextFn_DefaultImpl(void*, const char* text)
@@ -9727,8 +12783,10 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("ImGui %s", ImGui::GetVersion());
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
-        ImGui::Text("%d allocations", ImGui::GetIO().MetricsAllocs);
-        static bool show_clip_rects = true;
+        if (ImGui::GetIO().RenderDrawListsTrackChanges)
+            ImGui::Text("%d/%d draw lists changed last frame", GImGui->RenderDrawData.CmdListsChangedCount, GImGui->RenderDrawData.CmdListsCount);
+        ImGui::Text("%d allocations, %d allocations (%d bytes) last frame, %d KB pooled", ImGui::GetIO().MetricsAllocs, ImGui::GetIO().MetricsFrameAllocs, ImGui::GetIO().MetricsFrameAllocsBytes, ImGui::GetIO().MetricsPoolBytes / 1024);
+        static IM_THREAD_LOCAL bool show_clip_rects = true;
         ImGui::Checkbox("Show clipping rectangles when hovering a ImDrawCmd", &show_clip_rects);
         ImGui::Separator();
 
@@ -9736,7 +12794,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         {
             static void NodeDrawList(ImDrawList* draw_list, const char* label)
             {
-                bool node_open = ImGui::TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->CmdBuffer.Size);
+                bool node_open = ImGui::TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d quads, %d cmds, %d KB retained", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->QuadBuffer.Size, draw_list->CmdBuffer.Size, (draw_list->GetRetainedBytes() + 1023) / 1024);
                 if (draw_list == ImGui::GetWindowDrawList())
                 {
                     ImGui::SameLine();
@@ -9749,14 +12807,19 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
                 ImDrawList* overlay_draw_list = &GImGui->OverlayDrawList;   // Render additional visuals into the top-most draw list
                 overlay_draw_list->PushClipRectFullScreen();
-                int elem_offset = 0;
-                for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); elem_offset += pcmd->ElemCount, pcmd++)
+                for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); pcmd++)
                 {
+                    const int elem_offset = (int)pcmd->IdxOffset;
                     if (pcmd->UserCallback)
                     {
                         ImGui::BulletText("Callback %p, user_data %p", pcmd->UserCallback, pcmd->UserCallbackData);
                         continue;
                     }
+                    if (pcmd->QuadCount > 0)
+                    {
+                        ImGui::BulletText("Draw %-4d quads, tex = %p, clip_rect = (%.0f,%.0f)..(%.0f,%.0f)", pcmd->QuadCount, pcmd->TextureId, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+                        continue;
+                    }
                     ImDrawIdx* idx_buffer = (draw_list->IdxBuffer.Size > 0) ? draw_list->IdxBuffer.Data : NULL;
                     bool pcmd_node_open = ImGui::TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "Draw %-4d %s vtx, tex = %p, clip_rect = (%.0f,%.0f)..(%.0f,%.0f)", pcmd->ElemCount, draw_list->IdxBuffer.Size > 0 ? "indexed" : "non-indexed", pcmd->TextureId, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
                     if (show_clip_rects && ImGui::IsItemHovered())
@@ -9803,7 +12866,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
             static void NodeWindow(ImGuiWindow* window, const char* label)
             {
-                if (!ImGui::TreeNode(window, "%s '%s', %d @ 0x%p", label, window->Name, window->Active || window->WasActive, window))
+                if (!ImGui::TreeNode(window, "%s '%s', %d @ 0x%p, %d KB retained", label, window->Name, window->Active || window->WasActive, window, (window->GetRetainedBytes() + 1023) / 1024))
                     return;
                 NodeDrawList(window->DrawList, "DrawList");
                 ImGui::BulletText("Pos: (%.1f,%.1f)", window->Pos.x, window->Pos.y);
@@ -9814,6 +12877,117 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 ImGui::BulletText("Storage: %d bytes", window->StateStorage.Data.Size * (int)sizeof(ImGuiStorage::Pair));
                 ImGui::TreePop();
             }
+
+            struct ProfileScopeTotal
+            {
+                const char* Name;
+                int         Calls;
+                double      Inclusive, Exclusive;
+            };
+
+            static int ProfileScopeTotalComparer(const void* lhs, const void* rhs)
+            {
+                const double d = ((const ProfileScopeTotal*)rhs)->Exclusive - ((const ProfileScopeTotal*)lhs)->Exclusive;
+                return (d > 0.0) ? +1 : (d < 0.0) ? -1 : 0;
+            }
+
+            static float GetProfileFrameTime(void* data, int idx)
+            {
+                const ImGuiProfiler* prof = (const ImGuiProfiler*)data;
+                const int frames_count = (prof->FramesWritten < IM_PROFILER_FRAMES_COUNT) ? (int)prof->FramesWritten : IM_PROFILER_FRAMES_COUNT;
+                const ImGuiProfileFrame& frame = prof->Frames[(int)((prof->FramesWritten - frames_count + idx) & (IM_PROFILER_FRAMES_COUNT - 1))];
+                return (float)((frame.EndTime - frame.StartTime) * 1000.0);
+            }
+
+            static void NodeProfiler(ImGuiProfiler& prof)
+            {
+                ImGui::Checkbox("Record", &ImGui::GetIO().ProfilerEnabled);
+                ImGui::SameLine();
+                if (ImGui::Button("Save trace to imgui_trace.json"))
+                    ImGui::SaveProfileTrace("imgui_trace.json");
+                const int frames_count = (prof.FramesWritten < IM_PROFILER_FRAMES_COUNT) ? (int)prof.FramesWritten : IM_PROFILER_FRAMES_COUNT;
+                if (frames_count == 0)
+                    return;
+
+                // Frame times, click to select a frame. The selection is kept in the window storage, as contexts may run on different threads.
+                const ImGuiID frame_ago_id = ImGui::GetID("FramesAgo");
+                int frame_ago = ImGui::GetStateStorage()->GetInt(frame_ago_id, 0);
+                ImGui::PlotHistogram("##FrameTimes", GetProfileFrameTime, &prof, frames_count, 0, "Frame time (ms), click to select", 0.0f, FLT_MAX, ImVec2(0, 60));
+                if (ImGui::IsItemClicked())
+                    frame_ago = frames_count - 1 - (int)((ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x * frames_count);
+                ImGui::SliderInt("Frames ago", &frame_ago, 0, frames_count - 1);
+                frame_ago = ImClamp(frame_ago, 0, frames_count - 1);
+                ImGui::GetStateStorage()->SetInt(frame_ago_id, frame_ago);
+                const ImGuiProfileFrame& frame = prof.Frames[(int)((prof.FramesWritten - 1 - frame_ago) & (IM_PROFILER_FRAMES_COUNT - 1))];
+                const double frame_time = frame.EndTime - frame.StartTime;
+                ImGui::Text("Frame %d: %.3f ms, %d scopes", frame.FrameCount, frame_time * 1000.0, (int)(frame.EventsEnd - frame.EventsBegin));
+                if (frame.EventsBegin != frame.EventsEnd && !prof.IsEventValid(frame.EventsBegin))
+                {
+                    ImGui::TextDisabled("Scopes of this frame have been overwritten.");
+                    return;
+                }
+
+                // Flame graph
+                const float row_height = ImGui::GetTextLineHeightWithSpacing();
+                int max_depth = 0;
+                for (unsigned int n = frame.EventsBegin; n != frame.EventsEnd; n++)
+                    max_depth = ImMax(max_depth, prof.GetEvent(n).Depth);
+                const ImVec2 graph_pos = ImGui::GetCursorScreenPos();
+                const float graph_width = ImGui::GetContentRegionAvailWidth();
+                ImGui::InvisibleButton("##FlameGraph", ImVec2(graph_width, (max_depth + 1) * row_height));
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                const double time_scale = (frame_time > 0.0) ? graph_width / frame_time : 0.0;
+                for (unsigned int n = frame.EventsBegin; n != frame.EventsEnd; n++)
+                {
+                    const ImGuiProfileEvent& ev = prof.GetEvent(n);
+                    ImVec2 min(graph_pos.x + (float)((ev.StartTime - frame.StartTime) * time_scale), graph_pos.y + ev.Depth * row_height);
+                    ImVec2 max(ImMax(graph_pos.x + (float)((ev.EndTime - frame.StartTime) * time_scale), min.x + 1.0f), min.y + row_height - 1.0f);
+                    draw_list->AddRectFilled(min, max, ImColor::HSV((ev.Id & 0xFF) / 255.0f, 0.5f, 0.6f));
+                    if (max.x - min.x > row_height)
+                    {
+                        draw_list->PushClipRect(min, max, true);
+                        draw_list->AddText(ImVec2(min.x + 2.0f, min.y), ImGui::GetColorU32(ImGuiCol_Text), ev.Name);
+                        draw_list->PopClipRect();
+                    }
+                    if (ImGui::IsMouseHoveringRect(min, max))
+                        ImGui::SetTooltip("%s\n%.3f ms (exclusive %.3f ms)", ev.Name, (ev.EndTime - ev.StartTime) * 1000.0, (ev.EndTime - ev.StartTime - ev.ChildTime) * 1000.0);
+                }
+
+                // Per-scope breakdown, sorted by exclusive time
+                ImGuiStorage totals_map;
+                ImVector<ProfileScopeTotal> totals;
+                for (unsigned int n = frame.EventsBegin; n != frame.EventsEnd; n++)
+                {
+                    const ImGuiProfileEvent& ev = prof.GetEvent(n);
+                    int* p_idx = totals_map.GetIntRef(ev.Id, -1);
+                    if (*p_idx == -1)
+                    {
+                        *p_idx = totals.Size;
+                        ProfileScopeTotal total = { ev.Name, 0, 0.0, 0.0 };
+                        totals.push_back(total);
+                    }
+                    ProfileScopeTotal& total = totals[*p_idx];
+                    total.Calls++;
+                    total.Inclusive += ev.EndTime - ev.StartTime;
+                    total.Exclusive += ev.EndTime - ev.StartTime - ev.ChildTime;
+                }
+                if (totals.Size > 1)
+                    qsort(totals.Data, (size_t)totals.Size, sizeof(ProfileScopeTotal), ProfileScopeTotalComparer);
+                ImGui::Columns(4, "##ProfileTotals");
+                ImGui::Text("Scope"); ImGui::NextColumn();
+                ImGui::Text("Calls"); ImGui::NextColumn();
+                ImGui::Text("Inclusive (ms)"); ImGui::NextColumn();
+                ImGui::Text("Exclusive (ms)"); ImGui::NextColumn();
+                ImGui::Separator();
+                for (int i = 0; i < totals.Size; i++)
+                {
+                    ImGui::TextUnformatted(totals[i].Name); ImGui::NextColumn();
+                    ImGui::Text("%d", totals[i].Calls); ImGui::NextColumn();
+                    ImGui::Text("%.3f", totals[i].Inclusive * 1000.0); ImGui::NextColumn();
+                    ImGui::Text("%.3f", totals[i].Exclusive * 1000.0); ImGui::NextColumn();
+                }
+                ImGui::Columns(1);
+            }
         };
 
         ImGuiContext& g = *GImGui;                // Access private state
@@ -9824,6 +12998,11 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 Funcs::NodeDrawList(g.RenderDrawLists[0][i], "DrawList");
             ImGui::TreePop();
         }
+        if (ImGui::TreeNode("Profiler"))
+        {
+            Funcs::NodeProfiler(g.Profiler);
+            ImGui::TreePop();
+        }
         if (ImGui::TreeNode("Popups", "Open Popups Stack (%d)", g.OpenPopupStack.Size))
         {
             for (int i = 0; i < g.OpenPopupStack.Size; i++)
@@ -45,21 +45,30 @@
 struct ImDrawChannel;               // Temporary storage for outputting drawing commands out of order, used by ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call)
 struct ImDrawData;                  // All draw command lists required to render the frame
+struct ImDrawDataEncoder;           // Encode ImDrawData into a compact binary stream, for rendering on another machine
+struct ImDrawDataDecoder;           // Decode that stream back into ImDrawData
+struct ImDrawDataSnapshot;          // Owned copy of ImDrawData, to render a frame on another thread while the next one is built
 struct ImDrawList;                  // A single draw command list (generally one per window)
+struct ImDrawQuad;                  // An axis-aligned textured rectangle recorded as a single instance (36 bytes), see io.DrawListsUseQuads
 struct ImDrawVert;                  // A single vertex (20 bytes by default, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF font loader
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
+struct ImImageAtlas;                // Runtime data for small user images packed into a single texture
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiOnceUponAFrame;         // Simple helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiStorage;                // Simple custom key value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextFilter;             // Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+struct ImGuiTextFilterCache;        // Cache the results of a text filter over a large list of items
 struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
+struct ImGuiTextRope;               // Chunked text storage with a line index, for editing very large texts with InputTextMultiline()
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeConstraintCallbackData;// Structure used to constraint window size in custom ways when using custom ImGuiSizeConstraintCallback (rare/advanced use)
+struct ImGuiGridCallbackData;       // Shared state of ImGui::Grid() when requesting the text of the visible cells
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiPlotBuffer;             // Ring buffer of samples with a cached min/max envelope, for plotting large or streaming data
 struct ImGuiContext;                // ImGui context (opaque)
 
 // Typedefs and Enumerations (declared as int for compatibility and to not pollute the top of this file)
@@ -79,6 +88,7 @@ typedef int ImGuiSelectableFlags;   // flags for Selectable()               // e
 typedef int ImGuiTreeNodeFlags;     // flags for TreeNode*(), Collapsing*() // enum ImGuiTreeNodeFlags_
 typedef int (*ImGuiTextEditCallback)(ImGuiTextEditCallbackData *data);
 typedef void (*ImGuiSizeConstraintCallback)(ImGuiSizeConstraintCallbackData* data);
+typedef void (*ImGuiGridCallback)(ImGuiGridCallbackData* data);
 
 // Others helpers at bottom of the file:
 // class ImVector<>                 // Lightweight std::vector like class.
@@ -140,6 +150,8 @@ namespace ImGui
     IMGUI_API float         GetWindowHeight();
     IMGUI_API bool          IsWindowCollapsed();
     IMGUI_API void          SetWindowFontScale(float scale);                                    // per-window font scale. Adjust IO.FontGlobalScale if you want to scale all windows
+    IMGUI_API int           GetWindowRetainedBytes();                                           // heap memory held by the current window (window, draw list, ID stack, storage, layout stacks), including unused capacity
+    IMGUI_API int           GetWindowRetainedBytes(const char* name);                           // same for a named window. 0 if the window doesn't exist or was freed (see io.WindowsGcFrames)
 
     IMGUI_API void          SetNextWindowPos(const ImVec2& pos, ImGuiSetCond cond = 0);         // set next window position. call before Begin()
     IMGUI_API void          SetNextWindowPosCenter(ImGuiSetCond cond = 0);                      // set next window position to be centered on screen. call before Begin()
@@ -229,6 +241,11 @@ namespace ImGui
     IMGUI_API float         GetColumnWidth(int column_index = -1);                              // column width (== GetColumnOffset(GetColumnIndex()+1) - GetColumnOffset(GetColumnOffset())
     IMGUI_API int           GetColumnsCount();                                                  // number of columns (what was passed to Columns())
 
+    // Grid
+    // Virtualized grid of text cells for very large tables. Rows and columns are clipped against the visible area and only the visible cells are requested from 'cells_callback' (in up to 4 batches: frozen corner, frozen rows, frozen columns, scrolling cells) and drawn.
+    // The first 'frozen_rows' rows and 'frozen_columns' columns stay in place when scrolling (e.g. headers and key columns). Pass columns_width=NULL to use a default width. Returns true when a cell is clicked.
+    IMGUI_API bool          Grid(const char* str_id, ImGuiGridCallback cells_callback, void* user_data, int rows_count, int columns_count, const float* columns_width = NULL, int frozen_rows = 0, int frozen_columns = 0, const ImVec2& size = ImVec2(0,0), int* out_clicked_row = NULL, int* out_clicked_column = NULL);
+
     // ID scopes
     // If you are creating widgets in a loop you most likely want to push a unique identifier so ImGui can differentiate them.
     // You can also use the "##foobar" syntax within widget label to distinguish them from each others. Read "A primer on the use of labels/IDs" in the FAQ for more details.
@@ -276,6 +293,8 @@ namespace ImGui
     IMGUI_API void          PlotLines(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
     IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float));
     IMGUI_API void          PlotHistogram(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
+    IMGUI_API void          PlotLines(const char* label, ImGuiPlotBuffer* buffer, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));                   // use the envelope cached in 'buffer'
+    IMGUI_API void          PlotHistogram(const char* label, ImGuiPlotBuffer* buffer, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
     IMGUI_API void          ProgressBar(float fraction, const ImVec2& size_arg = ImVec2(-1,0), const char* overlay = NULL);
 
     // Widgets: Drags (tip: ctrl+click on a drag box to input with keyboard. manually input values aren't clamped, can go off-bounds)
@@ -294,6 +313,7 @@ namespace ImGui
     // Widgets: Input with Keyboard
     IMGUI_API bool          InputText(const char* label, char* buf, size_t buf_size, ImGuiInputTextFlags flags = 0, ImGuiTextEditCallback callback = NULL, void* user_data = NULL);
     IMGUI_API bool          InputTextMultiline(const char* label, char* buf, size_t buf_size, const ImVec2& size = ImVec2(0,0), ImGuiInputTextFlags flags = 0, ImGuiTextEditCallback callback = NULL, void* user_data = NULL);
+    IMGUI_API bool          InputTextMultiline(const char* label, ImGuiTextRope* rope, const ImVec2& size = ImVec2(0,0), ImGuiInputTextFlags flags = 0); // edit multi-megabyte texts in place: only visible lines are laid out, edits only touch the chunk(s) they overlap. no undo, no callbacks. supports ReadOnly, AllowTabInput, CtrlEnterForNewLine and character filters.
     IMGUI_API bool          InputFloat(const char* label, float* v, float step = 0.0f, float step_fast = 0.0f, int decimal_precision = -1, ImGuiInputTextFlags extra_flags = 0);
     IMGUI_API bool          InputFloat2(const char* label, float v[2], int decimal_precision = -1, ImGuiInputTextFlags extra_flags = 0);
     IMGUI_API bool          InputFloat3(const char* label, float v[3], int decimal_precision = -1, ImGuiInputTextFlags extra_flags = 0);
@@ -383,7 +403,8 @@ namespace ImGui
     IMGUI_API void          LogToTTY(int max_depth = -1);                                       // start logging to tty
     IMGUI_API void          LogToFile(int max_depth = -1, const char* filename = NULL);         // start logging to file
     IMGUI_API void          LogToClipboard(int max_depth = -1);                                 // start logging to OS clipboard
-    IMGUI_API void          LogFinish();                                                        // stop logging (close file, etc.)
+    IMGUI_API void          LogToCallback(void (*write_fn)(void* user_data, const char* data, int size), void* user_data, int max_depth = -1); // start logging to a callback (e.g. socket, pipe). called with batches of text, possibly from the thread running io.FileWriteAsyncFn jobs
+    IMGUI_API void          LogFinish();                                                        // stop logging (flush buffered text, close file, etc.)
     IMGUI_API void          LogButtons();                                                       // helper to display buttons for logging to tty/file/clipboard
     IMGUI_API void          LogText(const char* fmt, ...) IM_PRINTFARGS(1);                     // pass text data straight to log (without being displayed)
 
@@ -413,6 +434,14 @@ namespace ImGui
     IMGUI_API bool          IsPosHoveringAnyWindow(const ImVec2& pos);                          // is given position hovering any active imgui window
     IMGUI_API float         GetTime();
     IMGUI_API int           GetFrameCount();
+    IMGUI_API void          PushProfileScope(const char* name);                                 // open a named timing scope, recorded when io.ProfilerEnabled is set. NewFrame(), Begin()/End() pairs, EndFrame(), Render() and the render callback are recorded automatically.
+    IMGUI_API void          PopProfileScope();
+    IMGUI_API bool          SaveProfileTrace(const char* filename);                             // write recorded timings in Chrome trace event format (open with chrome://tracing). return false on error.
+    IMGUI_API bool          BeginInputRecording(const char* filename);                          // write the inputs read by every following NewFrame() (DeltaTime, DisplaySize, mouse, keys, characters) to a compact binary file. return false on error.
+    IMGUI_API void          EndInputRecording();
+    IMGUI_API bool          BeginInputReplay(const char* filename, float fixed_delta_time = 0.0f); // feed a recording to the following NewFrame() calls, overriding the io inputs you set. fixed_delta_time > 0.0f replaces the recorded DeltaTime. return false on error.
+    IMGUI_API bool          IsInputReplaying();                                                 // true until NewFrame() consumed the last recorded frame
+    IMGUI_API void          EndInputReplay();
     IMGUI_API const char*   GetStyleColName(ImGuiCol idx);
     IMGUI_API ImVec2        CalcItemRectClosestPoint(const ImVec2& pos, bool on_edge = false, float outward = +0.0f);   // utility to find the closest point the last item bounding rectangle edge. useful to visually link items
     IMGUI_API ImVec2        CalcTextSize(const char* text, const char* text_end = NULL, bool hide_text_after_double_hash = false, float wrap_width = -1.0f);
@@ -451,6 +480,8 @@ namespace ImGui
     // Helpers functions to access functions pointers in ImGui::GetIO()
     IMGUI_API void*         MemAlloc(size_t sz);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API void*         MemAllocFrame(size_t sz);                                           // allocate transient memory from the per-frame arena. valid until the next call to NewFrame(). never call MemFree() on it.
+    IMGUI_API void          MemTrim();                                                          // release unused pool chunks back to io.MemFreeFn (when io.MemUsePools is set)
     IMGUI_API const char*   GetClipboardText();
     IMGUI_API void          SetClipboardText(const char* text);
 
@@ -495,6 +526,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_AlwaysVerticalScrollbar= 1 << 14,  // Always show vertical scrollbar (even if ContentSize.y < Size.y)
     ImGuiWindowFlags_AlwaysHorizontalScrollbar=1<< 15,  // Always show horizontal scrollbar (even if ContentSize.x < Size.x)
     ImGuiWindowFlags_AlwaysUseWindowPadding = 1 << 16,  // Ensure child windows without border uses style.WindowPadding (ignored by default for non-bordered child windows, because more convenient)
+    ImGuiWindowFlags_NoOffscreenSkip        = 1 << 17,  // Keep submitting items when the window is entirely outside of the display (or scrolled out of its parent). Use for windows whose contents have side effects.
     // [Internal]
     ImGuiWindowFlags_ChildWindow            = 1 << 20,  // Don't use! For internal use by BeginChild()
     ImGuiWindowFlags_ChildWindowAutoFitX    = 1 << 21,  // Don't use! For internal use by BeginChild()
@@ -526,6 +558,7 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_AlwaysInsertMode    = 1 << 13,  // Insert mode
     ImGuiInputTextFlags_ReadOnly            = 1 << 14,  // Read-only mode
     ImGuiInputTextFlags_Password            = 1 << 15,  // Password mode, display all characters as '*'
+    ImGuiInputTextFlags_CallbackResize      = 1 << 16,  // Call user function when the text doesn't fit in 'buf_size' anymore. Set data->Buf to a buffer of at least data->BufSize bytes (keeping the contents). Text isn't limited by 'buf_size' anymore.
     // [Internal]
     ImGuiInputTextFlags_Multiline           = 1 << 20   // For internal use by InputTextMultiline()
 };
@@ -708,6 +741,7 @@ struct ImGuiStyle
     ImVec2      DisplayWindowPadding;       // Window positions are clamped to be visible within the display area by at least this amount. Only covers regular windows.
     ImVec2      DisplaySafeAreaPadding;     // If you cannot see the edge of your screen (e.g. on a TV) increase the safe area padding. Covers popups/tooltips as well regular windows.
     bool        AntiAliasedLines;           // Enable anti-aliasing on lines/borders. Disable if you are really tight on CPU/GPU.
+    bool        AntiAliasedLinesUseTex;     // Draw anti-aliased lines of integer thickness (up to IM_DRAWLIST_TEX_LINES_WIDTH_MAX) as a textured strip sampling ImFontAtlas::TexUvLines, with 2 vertices per point instead of 3 or 4. Your renderer must sample the font texture with bilinear filtering.
     bool        AntiAliasedShapes;          // Enable anti-aliasing on filled shapes (rounded rectangles, circles, etc.)
     float       CurveTessellationTol;       // Tessellation tolerance. Decrease for highly tessellated curves (higher quality, more polygons), increase to reduce quality.
     ImVec4      Colors[ImGuiCol_COUNT];
@@ -727,6 +761,7 @@ struct ImGuiIO
     float         DeltaTime;                // = 1.0f/60.0f         // Time elapsed since last frame, in seconds.
     float         IniSavingRate;            // = 5.0f               // Maximum time between saving positions/sizes to .ini file, in seconds.
     const char*   IniFilename;              // = "imgui.ini"        // Path to .ini file. NULL to disable .ini saving.
+    const char*   IniBinaryFilename;        // = NULL               // Path to a binary settings journal. When set, periodic saves only append the windows which changed (compacting through a temporary file + rename from time to time), and IniFilename is only imported once if the journal doesn't exist yet and exported on Shutdown().
     const char*   LogFilename;              // = "imgui_log.txt"    // Path to .log file (default parameter to ImGui::LogToFile when no file is specified).
     float         MouseDoubleClickTime;     // = 0.30f              // Time for a double-click, in seconds.
     float         MouseDoubleClickMaxDist;  // = 6.0f               // Distance threshold to stay in to validate a double-click, in pixels.
@@ -746,6 +781,11 @@ struct ImGuiIO
 
     // Advanced/subtle behaviors
     bool          OSXBehaviors;             // = defined(__APPLE__) // OS X style: Text editing cursor movement using Alt instead of Ctrl, Shortcuts using Cmd/Super instead of Ctrl, Line/Text Start and End using Cmd+Arrows instead of Home/End, Double click selects by word instead of selecting whole text, Multi-selection in lists uses Cmd/Super instead of Ctrl
+    bool          DrawListsUseQuads;        // = false              // Record axis-aligned filled rectangles, images and glyphs as ImDrawQuad instances in ImDrawList::QuadBuffer (36 bytes each instead of 4 vertices + 6 indices = 92 bytes). Render() expands them to triangles unless RenderDrawListsUseQuads is set. Takes effect on the next Begin() of each window.
+    bool          ProfilerEnabled;          // = false              // Record timings of NewFrame(), Begin()/End() pairs, EndFrame(), Render() and your RenderDrawListsFn() into a ring buffer. Browse in ShowMetricsWindow(), export with SaveProfileTrace(). Takes effect on the next NewFrame().
+    int           WindowsGcFrames;          // = 0                  // Free the windows (with their draw list, ID stack, storage and layout stacks) which haven't been submitted for this many frames. Their position/size/collapsed state is kept in the .ini settings and restored if they are submitted again. 0 to disable.
+    float         WindowsGcTime;            // = 0.0f               // Same, in seconds. When both WindowsGcFrames and WindowsGcTime are set, a window must be inactive for both before being freed.
+    bool          WindowsGcKeepStorage;     // = false              // Keep the storage of freed windows (tree nodes open state, etc. see GetStateStorage()) and give it back when they are submitted again. Costs a few bytes per stored value instead of the whole window.
 
     //------------------------------------------------------------------
     // User Functions
@@ -755,6 +795,8 @@ struct ImGuiIO
     // Alternatively you can keep this to NULL and call GetDrawData() after Render() to get the same pointer.
     // See example applications if you are unsure of how to implement this.
     void        (*RenderDrawListsFn)(ImDrawData* data);
+    bool        RenderDrawListsUseQuads;    // Set if your rendering function draws the ImDrawCmd::QuadCount instances from ImDrawList::QuadBuffer (e.g. with instancing). Otherwise Render() expands the quads recorded with DrawListsUseQuads to triangles. (default to false)
+    bool        RenderDrawListsTrackChanges; // Set if your rendering function keeps the buffers of each ImDrawList on the GPU between frames. Render() then hashes the vertices/indices/quads of each list and updates ImDrawList::ContentVersion when they changed, so you only upload those. (default to false)
 
     // Optional: access OS clipboard
     // (default to use native Win32 clipboard on Windows, otherwise uses a private clipboard. Override to access OS clipboard on other architectures)
@@ -766,6 +808,12 @@ struct ImGuiIO
     // (default to posix malloc/free)
     void*       (*MemAllocFn)(size_t sz);
     void        (*MemFreeFn)(void* ptr);
+    bool        MemUsePools;                // Serve small allocations (<= 4 KB) from per-context size-class pools carved out of large chunks, to reduce heap traffic and fragmentation over long runs. Chunks are obtained from MemAllocFn(). (default to false)
+
+    // Optional: run file writes (binary settings journal, buffered logging) outside of the UI thread, e.g. by pushing a task to your worker thread.
+    // Call job_fn(job_data) exactly once from any thread. Jobs only touch the file system, the logging callback and MemFreeFn(). At most one job of each kind is in flight, LogFinish() and Shutdown() wait for them to complete and write the last buffer synchronously.
+    // (default to NULL: writes are done synchronously)
+    void        (*FileWriteAsyncFn)(void (*job_fn)(void* job_data), void* job_data);
 
     // Optional: notify OS Input Method Editor of the screen position of your cursor for text input position (e.g. when using Japanese/Chinese IME in Windows)
     // (default to use native imm32 api on Windows)
@@ -801,6 +849,9 @@ struct ImGuiIO
     bool        WantTextInput;              // Some text input widget is active, which will read input characters from the InputCharacters array. Use to activate on screen keyboard if your system needs one
     float       Framerate;                  // Application framerate estimation, in frame per second. Solely for convenience. Rolling average estimation based on IO.DeltaTime over 120 frames
     int         MetricsAllocs;              // Number of active memory allocations
+    int         MetricsFrameAllocs;         // Number of memory allocations during the last frame (including MemAllocFrame() calls)
+    int         MetricsFrameAllocsBytes;    // Number of bytes allocated during the last frame (including MemAllocFrame() calls)
+    int         MetricsPoolBytes;           // Bytes held by the size-class pools (when io.MemUsePools is set) and the frame arena
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
     int         MetricsActiveWindows;       // Number of visible root windows (exclude child windows)
@@ -922,6 +973,7 @@ struct ImGuiTextFilter
     };
 
     char                InputBuf[256];
+    char                InputBufLower[256]; // Lower-case copy of InputBuf made by Build(), Filters ranges map to it at the same offsets
     ImVector<TextRange> Filters;
     int                 CountGrep;
 
@@ -934,6 +986,24 @@ struct ImGuiTextFilter
     IMGUI_API void      Build();
 };
 
+// Helper: Cache the results of an ImGuiTextFilter over a list of items, for lists too large to be filtered every frame.
+// Call Update() every frame then iterate Indices (e.g. with ImGuiListClipper). Only items appended to the source since the last update are tested,
+// and when the filter text grows (e.g. while typing) only the items which previously passed are tested again. Call InvalidateItem() when an item text changed.
+struct ImGuiTextFilterCache
+{
+    char                FilterBuf[256];     // Filter text the cache was computed with
+    int                 ItemsCount;         // Number of items tested so far
+    ImVector<int>       Indices;            // Indices of the items passing the filter, in increasing order
+    ImVector<ImU32>     Bits;               // One bit per item tested, set when passing the filter
+    ImVector<int>       InvalidatedItems;
+
+    ImGuiTextFilterCache() { Clear(); }
+    void                Clear() { FilterBuf[0] = 0; ItemsCount = 0; Indices.resize(0); Bits.resize(0); InvalidatedItems.resize(0); }
+    bool                PassFilter(int idx) const { return idx < ItemsCount && (Bits[idx >> 5] & (1u << (idx & 31))) != 0; }
+    void                InvalidateItem(int idx) { if (idx < ItemsCount) InvalidatedItems.push_back(idx); }
+    IMGUI_API const ImVector<int>& Update(const ImGuiTextFilter& filter, int items_count, bool (*items_getter)(void* data, int idx, const char** out_text), void* data);
+};
+
 // Helper: Text buffer for logging/accumulating text
 struct ImGuiTextBuffer
 {
@@ -951,6 +1021,48 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendv(const char* fmt, va_list args);
 };
 
+// Helper: Chunked UTF-8 text storage with a line index, edited in place by InputTextMultiline(label, ImGuiTextRope*, ...)
+// The text is split into chunks of whole lines (every chunk but the last one ends with '\n'), each chunk holding about IM_TEXTROPE_CHUNK_SIZE bytes unless a single line is longer.
+// Prefix sums of chunk sizes and line counts make offset/line lookups a binary search + a scan within one chunk. Edits only move the bytes of the chunks they touch.
+// All offsets are in bytes.
+#ifndef IM_TEXTROPE_CHUNK_SIZE
+#define IM_TEXTROPE_CHUNK_SIZE  4096
+#endif
+struct ImGuiTextRope
+{
+    struct Chunk
+    {
+        char*           Data;
+        int             Size;
+        int             Capacity;
+        int             LinesCount;     // Number of '\n' in the chunk
+    };
+    ImVector<Chunk>     Chunks;
+    ImVector<int>       ChunksOffset;   // Byte offset of each chunk, with the total size at [Chunks.Size]
+    ImVector<int>       ChunksLine;     // Index of the line starting each chunk, with the total number of '\n' at [Chunks.Size]
+
+    IMGUI_API ImGuiTextRope(const char* text = NULL, const char* text_end = NULL);
+    IMGUI_API ~ImGuiTextRope();
+    IMGUI_API void      Clear();
+    IMGUI_API void      SetText(const char* text, const char* text_end = NULL);
+    IMGUI_API void      Insert(int offset, const char* text, const char* text_end = NULL);
+    IMGUI_API void      Erase(int offset, int size);
+    IMGUI_API int       CopyText(int offset, int size, char* out_buf) const;                // Copy up to 'size' bytes (not zero-terminated), return number of bytes copied
+    int                 GetSize() const             { return ChunksOffset.back(); }
+    int                 GetLinesCount() const       { return ChunksLine.back() + 1; }
+    IMGUI_API char      GetChar(int offset) const;
+    IMGUI_API int       GetLineStart(int line) const;
+    IMGUI_API int       GetLineFromOffset(int offset) const;
+    IMGUI_API const char* GetLineText(int line, const char** out_line_end) const;           // Contiguous text of a line, out_line_end points to its '\n' or to the end of the text
+    IMGUI_API int       FindChunkFromOffset(int offset) const;
+    IMGUI_API int       FindChunkFromLine(int line) const;
+
+    // Internal helpers
+    IMGUI_API void      InsertChunks(int chunk_idx, const char* text, const char* text_end);
+    IMGUI_API void      SplitChunk(int chunk_idx);
+    IMGUI_API void      UpdateIndex(int chunk_idx);
+};
+
 // Helper: Simple Key->value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1), store color edit options.
@@ -1008,12 +1120,15 @@ struct ImGuiTextEditCallbackData
     // CharFilter event:
     ImWchar             EventChar;      // Character input                      // Read-write (replace character or set to zero)
 
+    // Resize event:
+    // Buf is your current buffer, BufSize the requested capacity in bytes. Grow your buffer (preserving its contents) and set Buf to it.
+
     // Completion,History,Always events:
     // If you modify the buffer contents make sure you update 'BufTextLen' and set 'BufDirty' to true.
     ImGuiKey            EventKey;       // Key pressed (Up/Down/TAB)            // Read-only
-    char*               Buf;            // Current text buffer                  // Read-write (pointed data only, can't replace the actual pointer)
+    char*               Buf;            // Current text buffer                  // Read-write (pointed data only, can't replace the actual pointer, except in Resize event)
     int                 BufTextLen;     // Current text length in bytes         // Read-write
-    int                 BufSize;        // Maximum text length in bytes         // Read-only
+    int                 BufSize;        // Maximum text length in bytes         // Read-only (Resize event: required size, write if you allocate more)
     bool                BufDirty;       // Set if you modify Buf/BufTextLen!!   // Write
     int                 CursorPos;      //                                      // Read-write
     int                 SelectionStart; //                                      // Read-write (== to SelectionEnd when no selection)
@@ -1025,6 +1140,25 @@ struct ImGuiTextEditCallbackData
     bool    HasSelection() const { return SelectionStart != SelectionEnd; }
 };
 
+// Shared state of Grid(), passed to the cells callback. Provide the text of the cells in [RowBegin,RowEnd) x [ColumnBegin,ColumnEnd) with SetCellText()/SetCellTextf().
+// Cells left unset are empty. The text is copied so it doesn't need to persist.
+struct ImGuiGridCallbackData
+{
+    void*               UserData;       // What user passed to Grid()           // Read-only
+    int                 RowBegin;       // Requested rows                       // Read-only
+    int                 RowEnd;
+    int                 ColumnBegin;    // Requested columns                    // Read-only
+    int                 ColumnEnd;
+
+    // [Internal]
+    ImVector<char>      TextBuf;        // Text of the requested cells, zero-terminated
+    ImVector<int>       TextOffsets;    // Offset of the text of each requested cell in TextBuf (row-major), -1 when unset
+
+    IMGUI_API void      SetCellText(int row, int column, const char* text, const char* text_end = NULL);
+    IMGUI_API void      SetCellTextf(int row, int column, const char* fmt, ...) IM_PRINTFARGS(4);
+    const char*         GetCellText(int row, int column) const { int offset = TextOffsets[(row - RowBegin) * (ColumnEnd - ColumnBegin) + (column - ColumnBegin)]; return offset >= 0 ? TextBuf.Data + offset : NULL; }
+};
+
 // Resizing callback data to apply custom constraint. As enabled by SetNextWindowSizeConstraints(). Callback is called during the next Begin().
 // NB: For basic min/max size constraint on each axis you don't need to use the callback! The SetNextWindowSizeConstraints() parameters are enough.
 struct ImGuiSizeConstraintCallbackData
@@ -1105,6 +1239,31 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Ring buffer of samples for plotting large or streaming data with PlotLines()/PlotHistogram().
+// Plots with more samples than pixels are drawn as one min/max pair per pixel column. With a buffer, those pairs are cached in buckets aligned on
+// the sample count, and only the buckets touched by AddValue()/AddValues() or InvalidateRange() are recomputed, so streaming costs O(new samples) per frame.
+struct ImGuiPlotBuffer
+{
+    ImVector<float>     Values;             // Ring storage, Values.Size is the capacity
+    int                 Offset;             // Index of the oldest sample in Values
+    int                 Count;              // Number of samples stored
+    int                 Written;            // Number of samples added so far (rebased when large), sample #idx has the absolute index Written-Count+idx
+    int                 EnvelopeStep;       // Number of samples per bucket, 0 when the envelope needs a full rebuild
+    int                 EnvelopeWritten;    // Value of Written when the envelope was last updated
+    ImVector<float>     EnvelopeMin;        // Bucket of absolute index 'b' is stored at [b % EnvelopeMin.Size]
+    ImVector<float>     EnvelopeMax;
+
+    ImGuiPlotBuffer(int capacity = 0)   { Offset = Count = Written = EnvelopeStep = EnvelopeWritten = 0; if (capacity > 0) SetCapacity(capacity); }
+    void                Clear()         { Offset = Count = Written = EnvelopeStep = EnvelopeWritten = 0; }
+    int                 GetCapacity() const { return Values.Size; }
+    float               GetValue(int idx) const { IM_ASSERT(idx >= 0 && idx < Count); idx += Offset; return Values.Data[idx >= Values.Size ? idx - Values.Size : idx]; } // #0 is the oldest sample
+    IMGUI_API void      SetCapacity(int capacity);                          // Clear and resize storage
+    IMGUI_API void      AddValue(float v);                                  // Append a sample, dropping the oldest one when full
+    IMGUI_API void      AddValues(const float* values, int values_count);
+    IMGUI_API void      InvalidateRange(int idx_begin, int idx_end);        // Call after modifying samples [idx_begin,idx_end) in place
+    IMGUI_API void      UpdateEnvelope(int step);                           // Bring the envelope up to date for 'step' samples per bucket. Called by PlotLines()/PlotHistogram().
+};
+
 //-----------------------------------------------------------------------------
 // Draw List
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -1116,16 +1275,24 @@ struct ImGuiListClipper
 // The expected behavior from your rendering function is 'if (cmd.UserCallback != NULL) cmd.UserCallback(parent_list, cmd); else RenderTriangles()'
 typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* cmd);
 
+// Thickest anti-aliased line drawn from the line profiles baked in the font atlas (see ImGuiStyle::AntiAliasedLinesUseTex)
+#ifndef IM_DRAWLIST_TEX_LINES_WIDTH_MAX
+#define IM_DRAWLIST_TEX_LINES_WIDTH_MAX     31
+#endif
+
 // Typically, 1 command = 1 gpu draw call (unless command is a callback)
 struct ImDrawCmd
 {
     unsigned int    ElemCount;              // Number of indices (multiple of 3) to be rendered as triangles. Vertices are stored in the callee ImDrawList's vtx_buffer[] array, indices in idx_buffer[].
+    unsigned int    IdxOffset;              // Start offset in the callee ImDrawList's idx_buffer[] (or vtx_buffer[] after DeIndexAllBuffers()). Always equal to the sum of the previous ElemCount.
+    unsigned int    QuadCount;              // Number of ImDrawQuad to be rendered from the callee ImDrawList's QuadBuffer[], only when io.RenderDrawListsUseQuads is set. A command has either triangles (ElemCount) or quads.
+    unsigned int    QuadOffset;             // Start offset in the callee ImDrawList's QuadBuffer[]
     ImVec4          ClipRect;               // Clipping rectangle (x1, y1, x2, y2)
     ImTextureID     TextureId;              // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     ImDrawCallback  UserCallback;           // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;       // The draw callback code can access this.
 
-    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; }
+    ImDrawCmd() { ElemCount = 0; IdxOffset = 0; QuadCount = QuadOffset = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; }
 };
 
 // Vertex index (override with '#define ImDrawIdx unsigned int' inside in imconfig.h)
@@ -1148,12 +1315,21 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Axis-aligned textured rectangle, rendered as the 2 triangles (Min, (Max.x,Min.y), Max) and (Min, Max, (Min.x,Max.y)) with matching UV
+struct ImDrawQuad
+{
+    ImVec2  Min, Max;
+    ImVec2  UvMin, UvMax;
+    ImU32   Col;
+};
+
 // Draw channels are used by the Columns API to "split" the render list into different channels while building, so items of each column can be batched together.
 // You can also use them to simulate drawing layers and submit primitives in a different order than how they will be rendered.
 struct ImDrawChannel
 {
     ImVector<ImDrawCmd>     CmdBuffer;
     ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImDrawQuad>    QuadBuffer;
 };
 
 // Draw command list
@@ -1168,6 +1344,9 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Commands. Typically 1 command = 1 gpu draw call.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawQuad>    QuadBuffer;         // Quad instances, when UseQuads is set. Each command consume ImDrawCmd::QuadCount of those. Expanded to VtxBuffer/IdxBuffer by Render() unless io.RenderDrawListsUseQuads is set.
+    bool                    UseQuads;           // Record AddRectFilled() without rounding, AddImage() and text as ImDrawQuad. Set by ImGui from io.DrawListsUseQuads for window draw lists.
+    unsigned int            ContentVersion;     // When io.RenderDrawListsTrackChanges is set: updated by Render() when VtxBuffer/IdxBuffer/QuadBuffer differ from the last time this list was rendered. Versions are unique within the context, so (list pointer, version) identifies the content even if a list is destroyed and another one allocated at the same address.
 
     // [Internal, used while building lists]
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
@@ -1180,8 +1359,11 @@ struct ImDrawList
     int                     _ChannelsCurrent;   // [Internal] current channel number (0)
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
+    int                     _CmdPeak, _IdxPeak, _VtxPeak, _QuadPeak; // [Internal] decaying high-water marks of the buffer sizes, reserved by Clear()
+    int                     _TrimFrames;        // [Internal] number of consecutive Clear() calls where the retained capacity was far above the high-water marks
+    ImU32                   _ContentHash;       // [Internal] hash of the content at the last ContentVersion update
 
-    ImDrawList()  { _OwnerName = NULL; Clear(); }
+    ImDrawList()  { UseQuads = false; ContentVersion = 0; _ContentHash = 0; _OwnerName = NULL; _CmdPeak = _IdxPeak = _VtxPeak = _QuadPeak = _TrimFrames = 0; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  PushClipRect(ImVec2 clip_rect_min, ImVec2 clip_rect_max, bool intersect_with_current_clip_rect = false);  // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
     IMGUI_API void  PushClipRectFullScreen();
@@ -1231,15 +1413,21 @@ struct ImDrawList
 
     // Internal helpers
     // NB: all primitives needs to be reserved via PrimReserve() beforehand!
-    IMGUI_API void  Clear();
+    IMGUI_API void  Clear();                                                    // Also reserves the recent high-water marks, and shrinks buffers which stayed far above them for IMGUI_DRAWLIST_TRIM_FRAMES calls
     IMGUI_API void  ClearFreeMemory();
+    IMGUI_API int   GetRetainedBytes() const;                                   // Heap memory held by the buffers, including unused capacity and channels
     IMGUI_API void  PrimReserve(int idx_count, int vtx_count);
+    IMGUI_API void  PrimUnreserve(int idx_count, int vtx_count);                // Give back the end of the last reservation, once _VtxWritePtr/_IdxWritePtr stopped short of it
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
     inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                 { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
+    IMGUI_API ImDrawQuad* PrimReserveQuads(int quad_count);                     // Reserve quads in QuadBuffer for the current command (see UseQuads), returns the first one
+    IMGUI_API void  PrimUnreserveQuads(int quad_count);                         // Give back the end of the last quads reservation
+    IMGUI_API void  PrimQuad(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col);  // Axis aligned rectangle as a single ImDrawQuad, a: upper-left, c: lower-right
+    IMGUI_API void  ExpandQuads();                                              // Convert QuadBuffer to vertices and indices in place of their commands. Called by Render() unless io.RenderDrawListsUseQuads is set
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
 };
@@ -1252,13 +1440,96 @@ struct ImDrawData
     int             CmdListsCount;
     int             TotalVtxCount;          // For convenience, sum of all cmd_lists vtx_buffer.Size
     int             TotalIdxCount;          // For convenience, sum of all cmd_lists idx_buffer.Size
+    int             CmdListsChangedCount;   // Number of cmd_lists whose ContentVersion changed this frame (only when io.RenderDrawListsTrackChanges is set)
 
     // Functions
-    ImDrawData() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; }
+    ImDrawData() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = CmdListsChangedCount = 0; }
     IMGUI_API void DeIndexAllBuffers();               // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void ScaleClipRects(const ImVec2& sc);  // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
+// Owned copy of a frame's ImDrawData, so a render thread can submit frame N while the UI thread builds frame N+1. See examples/threaded_example.
+// - Capture() moves the command/index/vertex/quad buffers out of the frame's draw lists and gives them the buffers of the previous capture in exchange, so nothing is copied and nothing is allocated once warmed up. The source ImDrawData is invalid afterwards.
+// - Keep a pool of 2 or 3 snapshots. Capture on the UI thread after Render(), hand the snapshot to the render thread, and only capture into it again once the render thread is done with it.
+// - The render thread may modify the snapshot (e.g. ScaleClipRects()) but must not call ImGui functions: use DisplaySize rather than io.DisplaySize. UserCallback commands are called from the render thread.
+// - Captured lists keep the ContentVersion of their source (see io.RenderDrawListsTrackChanges). To skip uploads, key your GPU buffers on CmdListsSource[n], which is the same in every snapshot of the pool.
+struct ImDrawDataSnapshot
+{
+    ImDrawData                  DrawData;       // Valid after Capture()
+    ImVec2                      DisplaySize;    // io.DisplaySize at the time of Capture()
+    ImVector<ImDrawList*>       Lists;          // Owned draw lists, recycled between captures
+    ImVector<const ImDrawList*> ListsSource;    // Source of each of Lists[] at the last capture, NULL if unused
+    ImVector<ImDrawList*>       CmdLists;       // DrawData.CmdLists points here
+    ImVector<const ImDrawList*> CmdListsSource; // Draw list each of CmdLists[] was captured from. Only use it as a key, its content belongs to the UI thread.
+
+    IMGUI_API ImDrawDataSnapshot();
+    IMGUI_API ~ImDrawDataSnapshot();
+    IMGUI_API void  Capture(ImDrawData* draw_data); // Call on the UI thread after ImGui::Render(), with ImGui::GetDrawData() (leave io.RenderDrawListsFn to NULL)
+    IMGUI_API void  Clear();                        // Free the owned draw lists
+};
+
+// Compact binary stream of ImDrawData, to run the UI logic on one machine (e.g. a headless server) and render it on another (e.g. a thin client). See examples/remote_example.
+// - Each draw list is sent as a XOR delta against the same draw list in the previous frame (so unchanged vertices encode as zeroes), then the frame is compressed with stb_compress().
+// - Textures referenced by ImDrawCmd::TextureId (e.g. the font atlas) are registered with SetTexture() and only sent when their content changes.
+// - Frames depend on the previous one: transport them in order and without loss, and call Reset() on the encoder when a new decoder starts listening.
+// - Both sides need the same ImDrawIdx/ImDrawVert layout and endianness. UserCallback commands can't be sent and are skipped.
+struct ImDrawDataStreamList                 // [Internal] state kept for one draw list between frames
+{
+    ImGuiID                 Key;            // Hash of the owner window name
+    ImVector<unsigned char> Cmds;           // Previous frame, as serialized (encoder: commands, indices and vertices. decoder: commands only, indices and vertices are in List)
+    ImVector<unsigned char> Idx;
+    ImVector<unsigned char> Vtx;
+    ImDrawList*             List;           // Decoder only
+
+    ImDrawDataStreamList()  { Key = 0; List = NULL; }
+};
+
+struct ImDrawDataStreamTexture
+{
+    ImTextureID             TexID;          // ID used by ImDrawCmd::TextureId on the encoding side
+    int                     Width, Height;
+    int                     BytesPerPixel;  // 1 (alpha) or 4 (RGBA)
+    ImVector<unsigned char> Pixels;
+    ImU32                   Hash;           // Encoder only
+    bool                    Pending;        // Encoder only: to be sent with the next frame
+    int                     Version;        // Decoder only: incremented each time new pixels are received, so you know when to upload them again
+
+    ImDrawDataStreamTexture() { TexID = NULL; Width = Height = BytesPerPixel = 0; Hash = 0; Pending = false; Version = 0; }
+};
+
+struct ImDrawDataEncoder
+{
+    ImVector<ImDrawDataStreamList*>     Lists;
+    ImVector<ImDrawDataStreamTexture*>  Textures;
+    ImVector<unsigned char>             Payload;        // Last frame before compression
+    unsigned int                        FrameCount;
+    int                                 LastDrawDataBytes;  // Size of the cmds/indices/vertices of the last frame's ImDrawData, for statistics
+    int                                 LastPayloadBytes;   // Size of the last frame after delta encoding and before compression, for statistics
+
+    IMGUI_API ImDrawDataEncoder();
+    IMGUI_API ~ImDrawDataEncoder();
+    IMGUI_API void  SetTexture(ImTextureID tex_id, const unsigned char* pixels, int width, int height, int bytes_per_pixel);  // Register or update a texture. The pixels are copied and sent with the next frame if they changed.
+    IMGUI_API void  EncodeFrame(const ImDrawData* draw_data, const ImVec2& display_size, ImVector<unsigned char>* out);     // Replace the content of 'out' with the encoded frame. Send it along with its size.
+    IMGUI_API void  Reset();                                                                                                  // Make the next frame self-contained (all textures, no delta)
+};
+
+struct ImDrawDataDecoder
+{
+    ImDrawData                          DrawData;       // Valid after DecodeFrame() returned true. Textures IDs are those of the encoding side: map them with FindTexture().
+    ImVec2                              DisplaySize;
+    ImVector<ImDrawDataStreamList*>     Lists;
+    ImVector<ImDrawList*>               CmdLists;
+    ImVector<ImDrawDataStreamTexture*>  Textures;
+    ImVector<unsigned char>             Payload;
+    unsigned int                        FrameCount;
+
+    IMGUI_API ImDrawDataDecoder();
+    IMGUI_API ~ImDrawDataDecoder();
+    IMGUI_API bool  DecodeFrame(const unsigned char* data, int data_size);  // Return false if the frame is truncated, corrupted or doesn't follow the previously decoded one. Safe on untrusted data.
+    IMGUI_API const ImDrawDataStreamTexture* FindTexture(ImTextureID tex_id) const;
+    IMGUI_API void  Clear();
+};
+
 struct ImFontConfig
 {
     void*           FontData;                   //          // TTF data
@@ -1331,6 +1602,7 @@ struct ImFontAtlas
     int                         TexHeight;          // Texture height calculated during Build().
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
+    ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // Texture coordinates (u0, v, u1, v) across the baked anti-aliased line profile for each integer line width. The profile includes the 1 pixel fringe on both sides.
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
 
     // Private
@@ -1339,6 +1611,46 @@ struct ImFontAtlas
     IMGUI_API void              RenderCustomTexData(int pass, void* rects);
 };
 
+// Pack small user images (icons, thumbnails) into a single texture at runtime, so that consecutive images batch into a single draw call like glyphs do.
+// - AddImage() copies RGBA pixels into the atlas and returns a handle. Call GetImage() each time you draw an image, its UV change when the atlas is repacked.
+// - When full, the atlas is repacked and grows up to TexMaxSize. Space freed by RemoveImage() is reclaimed by the next repack.
+// - Backend: before rendering, if TexDirty is set, (re)create the texture if TexResized is set, otherwise upload the TexDirtyX0,Y0,X1,Y1 region of TexPixelsRGBA32. Then call ClearDirty().
+struct ImImageAtlas
+{
+    IMGUI_API ImImageAtlas();
+    IMGUI_API ~ImImageAtlas();
+    IMGUI_API int               AddImage(const unsigned char* pixels_rgba, int width, int height);     // Return a handle, or -1 if the image can't fit in a TexMaxSize texture
+    IMGUI_API void              UpdateImage(int handle, const unsigned char* pixels_rgba);             // Replace the pixels of an image (same size)
+    IMGUI_API void              RemoveImage(int handle);                                               // The handle may be reused by the next AddImage()
+    IMGUI_API bool              GetImage(int handle, ImTextureID* out_tex_id, ImVec2* out_uv0, ImVec2* out_uv1) const;  // Pass the outputs to ImGui::Image(), ImageButton() or ImDrawList::AddImage()
+    IMGUI_API void              Clear();
+    void                        ClearDirty()        { TexDirty = TexResized = false; }
+
+    struct Image
+    {
+        int                     X, Y;               // Position in the texture, excluding padding
+        int                     Width, Height;
+        bool                    Used;
+    };
+
+    // Members
+    ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems, like ImFontAtlas::TexID
+    unsigned char*              TexPixelsRGBA32;    // 4 bytes per pixel. Total size = TexWidth * TexHeight * 4
+    int                         TexWidth;
+    int                         TexHeight;
+    int                         TexMaxSize;         // = 4096       // Maximum width and height of the texture
+    int                         Padding;            // = 1          // Transparent pixels around each image, so bilinear filtering doesn't bleed between images
+    bool                        TexDirty;           // Pixels changed since the last ClearDirty()
+    bool                        TexResized;         // Size changed since the last ClearDirty(): recreate the texture
+    int                         TexDirtyX0, TexDirtyY0, TexDirtyX1, TexDirtyY1;     // Region to upload when TexDirty is set
+
+    // Private
+    ImVector<Image>             Images;             // Indexed by handle
+    int                         FreedArea;          // Pixels of removed images, reclaimed by the next repack
+    void*                       PackContext;        // stbrp_context followed by its nodes
+    IMGUI_API bool              Repack(int tex_width, int tex_height);
+};
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
@@ -529,6 +529,47 @@ void ImGui::ShowTestWindow(bool* p_open)
             ImGui::TreePop();
         }
 
+        if (ImGui::TreeNode("Resizable Text Input"))
+        {
+            // The buffer starts small and is grown by the callback when the text doesn't fit anymore
+            struct Funcs
+            {
+                static int ResizeCallback(ImGuiTextEditCallbackData* data)
+                {
+                    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+                    {
+                        ImVector<char>* my_str = (ImVector<char>*)data->UserData;
+                        IM_ASSERT(my_str->begin() == data->Buf);
+                        my_str->resize(data->BufSize);
+                        data->Buf = my_str->begin();
+                    }
+                    return 0;
+                }
+            };
+            static ImVector<char> my_str;
+            if (my_str.empty())
+                my_str.push_back(0);
+            ImGui::InputTextMultiline("##resizable", my_str.begin(), my_str.size(), ImVec2(-1.0f, ImGui::GetTextLineHeight() * 8), ImGuiInputTextFlags_CallbackResize, Funcs::ResizeCallback, (void*)&my_str);
+            ImGui::Text("Capacity: %d bytes", my_str.capacity());
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("Multi-line Text Input (large text)"))
+        {
+            static ImGuiTextRope rope("Use ImGuiTextRope to edit multi-megabyte texts.\nClick the button above to generate a large text.\n");
+            if (ImGui::Button("Generate 100000 lines"))
+            {
+                ImGuiTextBuffer buf;
+                for (int n = 0; n < 100000; n++)
+                    buf.append("%06d: The quick brown fox jumps over the lazy dog.\n", n);
+                rope.SetText(buf.begin(), buf.end());
+            }
+            ImGui::SameLine();
+            ImGui::Text("%d bytes, %d lines", rope.GetSize(), rope.GetLinesCount());
+            ImGui::InputTextMultiline("##rope", &rope, ImVec2(-1.0f, ImGui::GetTextLineHeight() * 16), ImGuiInputTextFlags_AllowTabInput);
+            ImGui::TreePop();
+        }
+
         static bool a=false;
         if (ImGui::Button("Button")) { printf("Clicked\n"); a ^= 1; }
         if (a)
@@ -807,6 +848,21 @@ void ImGui::ShowTestWindow(bool* p_open)
         ImGui::PlotHistogram("Histogram", func, NULL, display_count, 0, NULL, -1.0f, 1.0f, ImVec2(0,80));
         ImGui::Separator();
 
+        // Stream a large amount of samples into a ring buffer. Only the new samples are processed every frame.
+        static ImGuiPlotBuffer stream(1000000);
+        if (animate)
+        {
+            static float phase = 0.0f;
+            float samples[2000];
+            for (int n = 0; n < IM_ARRAYSIZE(samples); n++, phase += 0.0005f)
+                samples[n] = sinf(phase) * 0.8f + sinf(phase * 37.0f) * 0.2f;
+            stream.AddValues(samples, IM_ARRAYSIZE(samples));
+        }
+        char stream_overlay[32];
+        sprintf(stream_overlay, "%d samples", stream.Count);
+        ImGui::PlotLines("Stream", &stream, stream_overlay, -1.0f, 1.0f, ImVec2(0,80));
+        ImGui::Separator();
+
         // Animate a simple progress bar
         static float progress = 0.0f, progress_dir = 1.0f;
         if (animate)
@@ -1484,6 +1540,29 @@ void ImGui::ShowTestWindow(bool* p_open)
             ImGui::Separator();
             ImGui::TreePop();
         }
+
+        if (ImGui::TreeNode("Grid (large)"))
+        {
+            // Only the visible cells are requested. Row 0 and column 0 stay in place when scrolling.
+            struct Funcs
+            {
+                static void GetCells(ImGuiGridCallbackData* data)
+                {
+                    for (int row = data->RowBegin; row < data->RowEnd; row++)
+                        for (int column = data->ColumnBegin; column < data->ColumnEnd; column++)
+                        {
+                            if (row == 0 && column == 0) data->SetCellText(row, column, "#");
+                            else if (row == 0)           data->SetCellTextf(row, column, "Col %d", column);
+                            else if (column == 0)        data->SetCellTextf(row, column, "%d", row);
+                            else                         data->SetCellTextf(row, column, "%.2f", (float)((row * 7 + column * 13) % 1000) * 0.1f);
+                        }
+                }
+            };
+            static int clicked_row = -1, clicked_column = -1;
+            ImGui::Text("2000000 rows x 40 columns. Clicked: %d,%d", clicked_row, clicked_column);
+            ImGui::Grid("##grid", Funcs::GetCells, NULL, 2000000, 40, NULL, 1, 1, ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 12), &clicked_row, &clicked_column);
+            ImGui::TreePop();
+        }
     }
 
     if (ImGui::CollapsingHeader("Filtering"))
@@ -1638,6 +1717,8 @@ void ImGui::ShowStyleEditor(ImGuiStyle* ref)
     if (ImGui::TreeNode("Rendering"))
     {
         ImGui::Checkbox("Anti-aliased lines", &style.AntiAliasedLines);
+        ImGui::SameLine(); ImGui::Checkbox("Use texture", &style.AntiAliasedLinesUseTex);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Draw thin lines by sampling a line profile baked in the font atlas.\nRequires bilinear filtering in your renderer.");
         ImGui::Checkbox("Anti-aliased shapes", &style.AntiAliasedShapes);
         ImGui::PushItemWidth(100);
         ImGui::DragFloat("Curve Tessellation Tolerance", &style.CurveTessellationTol, 0.02f, 0.10f, FLT_MAX, NULL, 2.0f);
@@ -4,7 +4,9 @@
 // Contains implementation for
 // - ImDrawList
 // - ImDrawData
+// - ImDrawDataEncoder, ImDrawDataDecoder
 // - ImFontAtlas
+// - ImImageAtlas
 // - ImFont
 // - Default font data
 
@@ -120,11 +122,73 @@ using namespace IMGUI_STB_NAMESPACE;
 
 static const ImVec4 GNullClipRect(-8192.0f, -8192.0f, +8192.0f, +8192.0f); // Large values that are easy to encode in a few bits+shift
 
+#define IM_DRAWLIST_TRIM_MIN_BYTES      (16 * 1024)     // Don't bother shrinking draw lists retaining less than this
+
+// Move the high-water mark toward the last size, losing 1/32 of the gap per frame: a one-off peak fades out in a few seconds
+static inline int DecayPeak(int peak, int size)
+{
+    return (size >= peak) ? size : peak - ((peak - size + 31) >> 5);
+}
+
+template<typename T>
+static void ShrinkVector(ImVector<T>& v, int capacity)
+{
+    IM_ASSERT(v.Size == 0);
+    v.clear();
+    v.reserve(capacity);
+}
+
+int ImDrawList::GetRetainedBytes() const
+{
+    int bytes = CmdBuffer.Capacity * (int)sizeof(ImDrawCmd) + IdxBuffer.Capacity * (int)sizeof(ImDrawIdx) + VtxBuffer.Capacity * (int)sizeof(ImDrawVert) + QuadBuffer.Capacity * (int)sizeof(ImDrawQuad);
+    bytes += _ClipRectStack.Capacity * (int)sizeof(ImVec4) + _TextureIdStack.Capacity * (int)sizeof(ImTextureID) + _Path.Capacity * (int)sizeof(ImVec2);
+    bytes += _Channels.Capacity * (int)sizeof(ImDrawChannel);
+    for (int i = 0; i < _Channels.Size; i++)
+        bytes += _Channels[i].CmdBuffer.Capacity * (int)sizeof(ImDrawCmd) + _Channels[i].IdxBuffer.Capacity * (int)sizeof(ImDrawIdx) + _Channels[i].QuadBuffer.Capacity * (int)sizeof(ImDrawQuad);
+    return bytes;
+}
+
 void ImDrawList::Clear()
 {
+    // Track what the last frame used. We reserve it upfront so a typical frame doesn't go through several reallocations while growing,
+    // and if we keep holding far more than that (e.g. after a one-off huge plot) for IMGUI_DRAWLIST_TRIM_FRAMES frames, we release the excess.
+    _CmdPeak = DecayPeak(_CmdPeak, CmdBuffer.Size);
+    _IdxPeak = DecayPeak(_IdxPeak, IdxBuffer.Size);
+    _VtxPeak = DecayPeak(_VtxPeak, VtxBuffer.Size);
+    _QuadPeak = DecayPeak(_QuadPeak, QuadBuffer.Size);
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
+    QuadBuffer.resize(0);
+    if (IMGUI_DRAWLIST_TRIM_FRAMES > 0)
+    {
+        const int peak_bytes = _CmdPeak * (int)sizeof(ImDrawCmd) + _IdxPeak * (int)sizeof(ImDrawIdx) + _VtxPeak * (int)sizeof(ImDrawVert) + _QuadPeak * (int)sizeof(ImDrawQuad);
+        const int retained_bytes = GetRetainedBytes();
+        if (retained_bytes > peak_bytes * 4 && retained_bytes - peak_bytes > IM_DRAWLIST_TRIM_MIN_BYTES)
+            _TrimFrames++;
+        else
+            _TrimFrames = 0;
+        if (_TrimFrames >= IMGUI_DRAWLIST_TRIM_FRAMES)
+        {
+            ShrinkVector(CmdBuffer, _CmdPeak);
+            ShrinkVector(IdxBuffer, _IdxPeak);
+            ShrinkVector(VtxBuffer, _VtxPeak);
+            ShrinkVector(QuadBuffer, _QuadPeak);
+            _Path.clear();
+            for (int i = 0; i < _Channels.Size; i++)
+            {
+                _Channels[i].CmdBuffer.clear();
+                _Channels[i].IdxBuffer.clear();
+                _Channels[i].QuadBuffer.clear();
+            }
+            _Channels.clear();
+            _TrimFrames = 0;
+        }
+    }
+    CmdBuffer.reserve(_CmdPeak);
+    IdxBuffer.reserve(_IdxPeak);
+    VtxBuffer.reserve(_VtxPeak);
+    QuadBuffer.reserve(_QuadPeak);
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
@@ -141,6 +205,7 @@ void ImDrawList::ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    QuadBuffer.clear();
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
@@ -151,11 +216,12 @@ void ImDrawList::ClearFreeMemory()
     _ChannelsCount = 1;
     for (int i = 0; i < _Channels.Size; i++)
     {
-        if (i == 0) memset(&_Channels[0], 0, sizeof(_Channels[0]));  // channel 0 is a copy of CmdBuffer/IdxBuffer, don't destruct again
         _Channels[i].CmdBuffer.clear();
         _Channels[i].IdxBuffer.clear();
+        _Channels[i].QuadBuffer.clear();
     }
     _Channels.clear();
+    _CmdPeak = _IdxPeak = _VtxPeak = _QuadPeak = _TrimFrames = 0;
 }
 
 // Use macros because C++ is a terrible language, we want guaranteed inline, no code in header, and no overhead in Debug mode
@@ -167,6 +233,8 @@ void ImDrawList::AddDrawCmd()
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
+    draw_cmd.IdxOffset = (unsigned int)IdxBuffer.Size;
+    draw_cmd.QuadOffset = (unsigned int)QuadBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -175,7 +243,7 @@ void ImDrawList::AddDrawCmd()
 void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 {
     ImDrawCmd* current_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
-    if (!current_cmd || current_cmd->ElemCount != 0 || current_cmd->UserCallback != NULL)
+    if (!current_cmd || current_cmd->ElemCount != 0 || current_cmd->QuadCount != 0 || current_cmd->UserCallback != NULL)
     {
         AddDrawCmd();
         current_cmd = &CmdBuffer.back();
@@ -193,15 +261,15 @@ void ImDrawList::UpdateClipRect()
     // If current command is used with different settings we need to add a new command
     const ImVec4 curr_clip_rect = GetCurrentClipRect();
     ImDrawCmd* curr_cmd = CmdBuffer.Size > 0 ? &CmdBuffer.Data[CmdBuffer.Size-1] : NULL;
-    if (!curr_cmd || (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) != 0) || curr_cmd->UserCallback != NULL)
+    if (!curr_cmd || ((curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0) && memcmp(&curr_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) != 0) || curr_cmd->UserCallback != NULL)
     {
         AddDrawCmd();
         return;
     }
 
-    // Try to merge with previous command if it matches, else use current command
+    // Try to merge with previous command if it matches (and its indices end where ours start), else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->UserCallback == NULL && prev_cmd->IdxOffset + prev_cmd->ElemCount == curr_cmd->IdxOffset)
         CmdBuffer.pop_back();
     else
         curr_cmd->ClipRect = curr_clip_rect;
@@ -212,15 +280,15 @@ void ImDrawList::UpdateTextureID()
     // If current command is used with different settings we need to add a new command
     const ImTextureID curr_texture_id = GetCurrentTextureId();
     ImDrawCmd* curr_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
-    if (!curr_cmd || (curr_cmd->ElemCount != 0 && curr_cmd->TextureId != curr_texture_id) || curr_cmd->UserCallback != NULL)
+    if (!curr_cmd || ((curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0) && curr_cmd->TextureId != curr_texture_id) || curr_cmd->UserCallback != NULL)
     {
         AddDrawCmd();
         return;
     }
 
-    // Try to merge with previous command if it matches, else use current command
+    // Try to merge with previous command if it matches (and its indices end where ours start), else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL && prev_cmd->IdxOffset + prev_cmd->ElemCount == curr_cmd->IdxOffset)
         CmdBuffer.pop_back();
     else
         curr_cmd->TextureId = curr_texture_id;
@@ -282,22 +350,22 @@ void ImDrawList::ChannelsSplit(int channels_count)
         _Channels.resize(channels_count);
     _ChannelsCount = channels_count;
 
-    // _Channels[] (24 bytes each) hold storage that we'll swap with this->_CmdBuffer/_IdxBuffer
-    // The content of _Channels[0] at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
-    // When we switch to the next channel, we'll copy _CmdBuffer/_IdxBuffer into _Channels[0] and then _Channels[1] into _CmdBuffer/_IdxBuffer
-    memset(&_Channels[0], 0, sizeof(ImDrawChannel));
-    for (int i = 1; i < channels_count; i++)
+    // _Channels[] hold storage that we'll swap with this->_CmdBuffer/_IdxBuffer/_QuadBuffer
+    // The content of _Channels[0] at this point doesn't matter: it only holds the (empty) buffers swapped out when we last switched back to channel 0.
+    // When we switch to the next channel, we'll swap _CmdBuffer/_IdxBuffer/_QuadBuffer with _Channels[0] and then with _Channels[1], so no buffer is ever owned twice
+    for (int i = 0; i < channels_count; i++)
     {
         if (i >= old_channels_count)
         {
             IM_PLACEMENT_NEW(&_Channels[i]) ImDrawChannel();
         }
-        else
+        else if (i > 0)
         {
             _Channels[i].CmdBuffer.resize(0);
             _Channels[i].IdxBuffer.resize(0);
+            _Channels[i].QuadBuffer.resize(0);
         }
-        if (_Channels[i].CmdBuffer.Size == 0)
+        if (i > 0 && _Channels[i].CmdBuffer.Size == 0)
         {
             ImDrawCmd draw_cmd;
             draw_cmd.ClipRect = _ClipRectStack.back();
@@ -314,29 +382,43 @@ void ImDrawList::ChannelsMerge()
         return;
 
     ChannelsSetCurrent(0);
-    if (CmdBuffer.Size && CmdBuffer.back().ElemCount == 0)
+    if (CmdBuffer.Size && CmdBuffer.back().ElemCount == 0 && CmdBuffer.back().QuadCount == 0)
         CmdBuffer.pop_back();
 
-    int new_cmd_buffer_count = 0, new_idx_buffer_count = 0;
+    int new_cmd_buffer_count = 0, new_idx_buffer_count = 0, new_quad_buffer_count = 0;
     for (int i = 1; i < _ChannelsCount; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch.CmdBuffer.Size && ch.CmdBuffer.back().ElemCount == 0)
+        if (ch.CmdBuffer.Size && ch.CmdBuffer.back().ElemCount == 0 && ch.CmdBuffer.back().QuadCount == 0)
             ch.CmdBuffer.pop_back();
         new_cmd_buffer_count += ch.CmdBuffer.Size;
         new_idx_buffer_count += ch.IdxBuffer.Size;
+        new_quad_buffer_count += ch.QuadBuffer.Size;
     }
     CmdBuffer.resize(CmdBuffer.Size + new_cmd_buffer_count);
-    IdxBuffer.resize(IdxBuffer.Size + new_idx_buffer_count);
-
     ImDrawCmd* cmd_write = CmdBuffer.Data + CmdBuffer.Size - new_cmd_buffer_count;
+
+    IdxBuffer.resize(IdxBuffer.Size + new_idx_buffer_count);
     _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size - new_idx_buffer_count;
     for (int i = 1; i < _ChannelsCount; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
+        const unsigned int idx_offset = (unsigned int)(_IdxWritePtr - IdxBuffer.Data);
+        if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); for (int n = 0; n < sz; n++) cmd_write[n].IdxOffset += idx_offset; cmd_write += sz; }
         if (int sz = ch.IdxBuffer.Size) { memcpy(_IdxWritePtr, ch.IdxBuffer.Data, sz * sizeof(ImDrawIdx)); _IdxWritePtr += sz; }
     }
+    if (new_quad_buffer_count > 0)
+    {
+        ImDrawCmd* cmd = CmdBuffer.Data + CmdBuffer.Size - new_cmd_buffer_count;
+        int quad_offset = QuadBuffer.Size;
+        QuadBuffer.resize(quad_offset + new_quad_buffer_count);
+        for (int i = 1; i < _ChannelsCount; i++)
+        {
+            ImDrawChannel& ch = _Channels[i];
+            for (int n = 0; n < ch.CmdBuffer.Size; n++, cmd++) cmd->QuadOffset += (unsigned int)quad_offset;
+            if (int sz = ch.QuadBuffer.Size) { memcpy(QuadBuffer.Data + quad_offset, ch.QuadBuffer.Data, sz * sizeof(ImDrawQuad)); quad_offset += sz; }
+        }
+    }
     AddDrawCmd();
     _ChannelsCount = 1;
 }
@@ -345,17 +427,22 @@ void ImDrawList::ChannelsSetCurrent(int idx)
 {
     IM_ASSERT(idx < _ChannelsCount);
     if (_ChannelsCurrent == idx) return;
-    memcpy(&_Channels.Data[_ChannelsCurrent].CmdBuffer, &CmdBuffer, sizeof(CmdBuffer)); // copy 12 bytes, four times
-    memcpy(&_Channels.Data[_ChannelsCurrent].IdxBuffer, &IdxBuffer, sizeof(IdxBuffer));
+    _Channels.Data[_ChannelsCurrent].CmdBuffer.swap(CmdBuffer); // swap 12 bytes, six times
+    _Channels.Data[_ChannelsCurrent].IdxBuffer.swap(IdxBuffer);
+    _Channels.Data[_ChannelsCurrent].QuadBuffer.swap(QuadBuffer);
     _ChannelsCurrent = idx;
-    memcpy(&CmdBuffer, &_Channels.Data[_ChannelsCurrent].CmdBuffer, sizeof(CmdBuffer));
-    memcpy(&IdxBuffer, &_Channels.Data[_ChannelsCurrent].IdxBuffer, sizeof(IdxBuffer));
+    CmdBuffer.swap(_Channels.Data[_ChannelsCurrent].CmdBuffer);
+    IdxBuffer.swap(_Channels.Data[_ChannelsCurrent].IdxBuffer);
+    QuadBuffer.swap(_Channels.Data[_ChannelsCurrent].QuadBuffer);
     _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
 }
 
 // NB: this can be called with negative count for removing primitives (as long as the result does not underflow)
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    if (idx_count > 0 && CmdBuffer.Data[CmdBuffer.Size-1].QuadCount != 0)
+        AddDrawCmd();   // A command holds either triangles or quads
+
     ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
     draw_cmd.ElemCount += idx_count;
 
@@ -368,6 +455,112 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_size;
 }
 
+void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
+{
+    ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
+    draw_cmd.ElemCount -= idx_count;
+    VtxBuffer.resize(VtxBuffer.Size - vtx_count);
+    IdxBuffer.resize(IdxBuffer.Size - idx_count);
+}
+
+ImDrawQuad* ImDrawList::PrimReserveQuads(int quad_count)
+{
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    if (curr_cmd->ElemCount != 0 || curr_cmd->QuadOffset + curr_cmd->QuadCount != (unsigned int)QuadBuffer.Size)
+    {
+        AddDrawCmd();
+        curr_cmd = &CmdBuffer.Data[CmdBuffer.Size-1];
+    }
+    curr_cmd->QuadCount += quad_count;
+    const int quad_buffer_size = QuadBuffer.Size;
+    QuadBuffer.resize(quad_buffer_size + quad_count);
+    return QuadBuffer.Data + quad_buffer_size;
+}
+
+void ImDrawList::PrimUnreserveQuads(int quad_count)
+{
+    CmdBuffer.Data[CmdBuffer.Size-1].QuadCount -= quad_count;
+    QuadBuffer.resize(QuadBuffer.Size - quad_count);
+}
+
+void ImDrawList::PrimQuad(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
+{
+    ImDrawQuad* quad = PrimReserveQuads(1);
+    quad->Min = a; quad->Max = c; quad->UvMin = uv_a; quad->UvMax = uv_c; quad->Col = col;
+}
+
+// Expand the quads of each command to 4 vertices + 6 indices, as PrimRectUV() would have written them.
+// The vertices go at the end of VtxBuffer. Quad indices are inserted in place between the commands' indices, so adjacent commands can be merged back.
+void ImDrawList::ExpandQuads()
+{
+    IM_ASSERT(_ChannelsCount == 1);
+    if (QuadBuffer.Size == 0)
+        return;
+
+    const int quad_count = QuadBuffer.Size;
+    const unsigned int vtx_base = (unsigned int)VtxBuffer.Size;
+    VtxBuffer.resize(VtxBuffer.Size + quad_count * 4);
+    ImDrawVert* vtx_write = VtxBuffer.Data + vtx_base;
+    for (int n = 0; n < quad_count; n++, vtx_write += 4)
+    {
+        const ImDrawQuad& quad = QuadBuffer.Data[n];
+        vtx_write[0].pos = quad.Min;                        vtx_write[0].uv = quad.UvMin;                           vtx_write[0].col = quad.Col;
+        vtx_write[1].pos = ImVec2(quad.Max.x, quad.Min.y);  vtx_write[1].uv = ImVec2(quad.UvMax.x, quad.UvMin.y);   vtx_write[1].col = quad.Col;
+        vtx_write[2].pos = quad.Max;                        vtx_write[2].uv = quad.UvMax;                           vtx_write[2].col = quad.Col;
+        vtx_write[3].pos = ImVec2(quad.Min.x, quad.Max.y);  vtx_write[3].uv = ImVec2(quad.UvMin.x, quad.UvMax.y);   vtx_write[3].col = quad.Col;
+    }
+
+    // Back to front, so each range only moves over ranges which were already moved
+    IdxBuffer.resize(IdxBuffer.Size + quad_count * 6);
+    unsigned int idx_write_offset = (unsigned int)IdxBuffer.Size;
+    for (int cmd_i = CmdBuffer.Size - 1; cmd_i >= 0; cmd_i--)
+    {
+        ImDrawCmd& cmd = CmdBuffer.Data[cmd_i];
+        if (cmd.QuadCount != 0)
+        {
+            cmd.ElemCount = cmd.QuadCount * 6;
+            idx_write_offset -= cmd.ElemCount;
+            ImDrawIdx* idx_write = IdxBuffer.Data + idx_write_offset;
+            for (unsigned int idx = vtx_base + cmd.QuadOffset * 4, idx_last = idx + cmd.QuadCount * 4; idx < idx_last; idx += 4, idx_write += 6)
+            {
+                idx_write[0] = (ImDrawIdx)idx; idx_write[1] = (ImDrawIdx)(idx+1); idx_write[2] = (ImDrawIdx)(idx+2);
+                idx_write[3] = (ImDrawIdx)idx; idx_write[4] = (ImDrawIdx)(idx+2); idx_write[5] = (ImDrawIdx)(idx+3);
+            }
+        }
+        else if (cmd.ElemCount != 0)
+        {
+            idx_write_offset -= cmd.ElemCount;
+            memmove(IdxBuffer.Data + idx_write_offset, IdxBuffer.Data + cmd.IdxOffset, cmd.ElemCount * sizeof(ImDrawIdx));
+        }
+        cmd.IdxOffset = idx_write_offset;
+        cmd.QuadCount = cmd.QuadOffset = 0;
+    }
+    IM_ASSERT(idx_write_offset == 0);
+
+    // Merge the commands which were only split by switching between triangles and quads
+    int cmd_write = 0;
+    for (int cmd_i = 0; cmd_i < CmdBuffer.Size; cmd_i++)
+    {
+        const ImDrawCmd& cmd = CmdBuffer.Data[cmd_i];
+        if (cmd_write > 0)
+        {
+            ImDrawCmd& prev_cmd = CmdBuffer.Data[cmd_write-1];
+            if (prev_cmd.UserCallback == NULL && cmd.UserCallback == NULL && prev_cmd.TextureId == cmd.TextureId && memcmp(&prev_cmd.ClipRect, &cmd.ClipRect, sizeof(ImVec4)) == 0 && prev_cmd.IdxOffset + prev_cmd.ElemCount == cmd.IdxOffset)
+            {
+                prev_cmd.ElemCount += cmd.ElemCount;
+                continue;
+            }
+        }
+        CmdBuffer.Data[cmd_write++] = cmd;
+    }
+    CmdBuffer.resize(cmd_write);
+
+    QuadBuffer.resize(0);
+    _VtxCurrentIdx = (unsigned int)VtxBuffer.Size;
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
@@ -434,12 +627,17 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const float AA_SIZE = 1.0f;
         const ImU32 col_trans = col & IM_COL32(255,255,255,0);
 
-        const int idx_count = thick_line ? count*18 : count*12;
-        const int vtx_count = thick_line ? points_count*4 : points_count*3;
+        // Lines of integer thickness can sample the line profiles baked in the font atlas: a single strip of 2 vertices per point, the fringe comes from the texture
+        const int integer_thickness = (int)thickness;
+        const bool use_texture = GImGui->Style.AntiAliasedLinesUseTex && GImGui->FontTexUvLines != NULL && integer_thickness >= 1 && integer_thickness <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX && (float)integer_thickness == thickness;
+        const float half_draw_size = use_texture ? thickness * 0.5f + AA_SIZE : AA_SIZE;
+
+        const int idx_count = use_texture ? count*6 : thick_line ? count*18 : count*12;
+        const int vtx_count = use_texture ? points_count*2 : thick_line ? points_count*4 : points_count*3;
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2));
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((thick_line && !use_texture) ? 5 : 3) * sizeof(ImVec2));
         ImVec2* temp_points = temp_normals + points_count;
 
         for (int i1 = 0; i1 < count; i1++)
@@ -453,14 +651,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         if (!closed)
             temp_normals[points_count-1] = temp_normals[points_count-2];
 
-        if (!thick_line)
+        if (use_texture || !thick_line)
         {
             if (!closed)
             {
-                temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
-                temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
+                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
+                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
+                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
+                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
@@ -468,7 +666,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             for (int i1 = 0; i1 < count; i1++)
             {
                 const int i2 = (i1+1) == points_count ? 0 : i1+1;
-                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
+                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1 + (use_texture ? 2 : 3);
 
                 // Average normals
                 ImVec2 dm = (temp_normals[i1] + temp_normals[i2]) * 0.5f;
@@ -479,27 +677,50 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     if (scale > 100.0f) scale = 100.0f;
                     dm *= scale;
                 }
-                dm *= AA_SIZE;
+                dm *= half_draw_size;
                 temp_points[i2*2+0] = points[i2] + dm;
                 temp_points[i2*2+1] = points[i2] - dm;
 
                 // Add indexes
-                _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
-                _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
-                _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
-                _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
-                _IdxWritePtr += 12;
+                if (use_texture)
+                {
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+1);
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx2+1); _IdxWritePtr[4] = (ImDrawIdx)(idx1+1); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
+                    _IdxWritePtr += 6;
+                }
+                else
+                {
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
+                    _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
+                    _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
+                    _IdxWritePtr += 12;
+                }
 
                 idx1 = idx2;
             }
 
             // Add vertexes
-            for (int i = 0; i < points_count; i++)
+            if (use_texture)
             {
-                _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-                _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
-                _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
-                _VtxWritePtr += 3;
+                const ImVec4 tex_uvs = GImGui->FontTexUvLines[integer_thickness];
+                const ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y), tex_uv1(tex_uvs.z, tex_uvs.w);
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos = temp_points[i*2+0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr[1].pos = temp_points[i*2+1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col;
+                    _VtxWritePtr += 2;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+                    _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+                    _VtxWritePtr += 3;
+                }
             }
         }
         else
@@ -680,19 +901,15 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 
 void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int amax)
 {
-    static ImVec2 circle_vtx[12];
-    static bool circle_vtx_builds = false;
-    const int circle_vtx_count = IM_ARRAYSIZE(circle_vtx);
-    if (!circle_vtx_builds)
+    // cos/sin of i*30 degrees. Constant (instead of lazily built) so that draw lists can be filled from several threads.
+    static const ImVec2 circle_vtx[12] =
     {
-        for (int i = 0; i < circle_vtx_count; i++)
-        {
-            const float a = ((float)i / (float)circle_vtx_count) * 2*IM_PI;
-            circle_vtx[i].x = cosf(a);
-            circle_vtx[i].y = sinf(a);
-        }
-        circle_vtx_builds = true;
-    }
+        ImVec2( 1.000000000f,  0.000000000f), ImVec2( 0.866025404f,  0.500000000f), ImVec2( 0.500000000f,  0.866025404f),
+        ImVec2( 0.000000000f,  1.000000000f), ImVec2(-0.500000000f,  0.866025404f), ImVec2(-0.866025404f,  0.500000000f),
+        ImVec2(-1.000000000f,  0.000000000f), ImVec2(-0.866025404f, -0.500000000f), ImVec2(-0.500000000f, -0.866025404f),
+        ImVec2( 0.000000000f, -1.000000000f), ImVec2( 0.500000000f, -0.866025404f), ImVec2( 0.866025404f, -0.500000000f),
+    };
+    const int circle_vtx_count = IM_ARRAYSIZE(circle_vtx);
 
     if (amin > amax) return;
     if (radius == 0.0f)
@@ -825,6 +1042,10 @@ void ImDrawList::AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, floa
         PathRect(a, b, rounding, rounding_corners_flags);
         PathFill(col);
     }
+    else if (UseQuads)
+    {
+        PrimQuad(a, b, GImGui->FontTexUvWhitePixel, GImGui->FontTexUvWhitePixel, col);
+    }
     else
     {
         PrimReserve(6, 4);
@@ -968,8 +1189,15 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& a, const Im
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimRectUV(a, b, uv0, uv1, col);
+    if (UseQuads)
+    {
+        PrimQuad(a, b, uv0, uv1, col);
+    }
+    else
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(a, b, uv0, uv1, col);
+    }
 
     if (push_texture_id)
         PopTextureID();
@@ -987,11 +1215,22 @@ void ImDrawData::DeIndexAllBuffers()
     for (int i = 0; i < CmdListsCount; i++)
     {
         ImDrawList* cmd_list = CmdLists[i];
+        cmd_list->ExpandQuads();
         if (cmd_list->IdxBuffer.empty())
             continue;
-        new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
-        for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
+        int new_vtx_count = 0;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            new_vtx_count += (int)cmd_list->CmdBuffer[cmd_i].ElemCount;
+        new_vtx_buffer.resize(new_vtx_count);
+        ImDrawVert* vtx_write = new_vtx_buffer.Data;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            pcmd->IdxOffset = (unsigned int)(vtx_write - new_vtx_buffer.Data);
+            for (unsigned int j = 0; j < pcmd->ElemCount; j++)
+                *vtx_write++ = cmd_list->VtxBuffer[idx[j]];
+        }
         cmd_list->VtxBuffer.swap(new_vtx_buffer);
         cmd_list->IdxBuffer.resize(0);
         TotalVtxCount += cmd_list->VtxBuffer.Size;
@@ -1012,6 +1251,598 @@ void ImDrawData::ScaleClipRects(const ImVec2& scale)
     }
 }
 
+//-----------------------------------------------------------------------------
+// ImDrawDataSnapshot
+//-----------------------------------------------------------------------------
+
+ImDrawDataSnapshot::ImDrawDataSnapshot()
+{
+    DisplaySize = ImVec2(0.0f, 0.0f);
+}
+
+ImDrawDataSnapshot::~ImDrawDataSnapshot()
+{
+    Clear();
+}
+
+void ImDrawDataSnapshot::Clear()
+{
+    for (int i = 0; i < Lists.Size; i++)
+    {
+        Lists[i]->~ImDrawList();
+        ImGui::MemFree(Lists[i]);
+    }
+    Lists.clear();
+    ListsSource.clear();
+    CmdLists.clear();
+    CmdListsSource.clear();
+    DrawData = ImDrawData();
+}
+
+// Swap the buffers of 'src' with ours, then leave 'src' empty and ready for the next frame.
+// The peaks of 'src' are raised to the sizes we took, so its next Clear() reserves what this frame used.
+static void MoveDrawListContent(ImDrawList* dst, ImDrawList* src)
+{
+    dst->CmdBuffer.swap(src->CmdBuffer);
+    dst->IdxBuffer.swap(src->IdxBuffer);
+    dst->VtxBuffer.swap(src->VtxBuffer);
+    dst->QuadBuffer.swap(src->QuadBuffer);
+    dst->UseQuads = src->UseQuads;
+    dst->ContentVersion = src->ContentVersion;
+    dst->_OwnerName = src->_OwnerName;
+    dst->_VtxCurrentIdx = (unsigned int)dst->VtxBuffer.Size;
+    dst->_VtxWritePtr = dst->VtxBuffer.Data + dst->VtxBuffer.Size;
+    dst->_IdxWritePtr = dst->IdxBuffer.Data + dst->IdxBuffer.Size;
+
+    src->_CmdPeak = ImMax(src->_CmdPeak, dst->CmdBuffer.Size);
+    src->_IdxPeak = ImMax(src->_IdxPeak, dst->IdxBuffer.Size);
+    src->_VtxPeak = ImMax(src->_VtxPeak, dst->VtxBuffer.Size);
+    src->_QuadPeak = ImMax(src->_QuadPeak, dst->QuadBuffer.Size);
+    src->CmdBuffer.resize(0);
+    src->IdxBuffer.resize(0);
+    src->VtxBuffer.resize(0);
+    src->QuadBuffer.resize(0);
+    src->_VtxCurrentIdx = 0;
+    src->_VtxWritePtr = NULL;
+    src->_IdxWritePtr = NULL;
+}
+
+void ImDrawDataSnapshot::Capture(ImDrawData* draw_data)
+{
+    IM_ASSERT(draw_data != NULL && draw_data->Valid);
+
+    // Give each source list the snapshot list it was captured into last time, then the remaining ones to the new sources
+    CmdLists.resize(draw_data->CmdListsCount);
+    for (int i = 0; i < CmdLists.Size; i++)
+        CmdLists[i] = NULL;
+    for (int list_n = 0; list_n < Lists.Size; list_n++)
+    {
+        int i = 0;
+        while (i < draw_data->CmdListsCount && draw_data->CmdLists[i] != ListsSource[list_n])
+            i++;
+        if (i < draw_data->CmdListsCount)
+            CmdLists[i] = Lists[list_n];
+        else
+            ListsSource[list_n] = NULL;
+    }
+    int free_n = 0;
+    for (int i = 0; i < CmdLists.Size; i++)
+    {
+        if (CmdLists[i] != NULL)
+            continue;
+        while (free_n < Lists.Size && ListsSource[free_n] != NULL)
+            free_n++;
+        if (free_n == Lists.Size)
+        {
+            ImDrawList* list = (ImDrawList*)ImGui::MemAlloc(sizeof(ImDrawList));
+            IM_PLACEMENT_NEW(list) ImDrawList();
+            Lists.push_back(list);
+            ListsSource.push_back(NULL);
+        }
+        ListsSource[free_n] = draw_data->CmdLists[i];
+        CmdLists[i] = Lists[free_n];
+    }
+
+    CmdListsSource.resize(CmdLists.Size);
+    for (int i = 0; i < CmdLists.Size; i++)
+    {
+        CmdListsSource[i] = draw_data->CmdLists[i];
+        MoveDrawListContent(CmdLists[i], draw_data->CmdLists[i]);
+    }
+
+    DrawData.Valid = true;
+    DrawData.CmdLists = CmdLists.Data;
+    DrawData.CmdListsCount = CmdLists.Size;
+    DrawData.TotalVtxCount = draw_data->TotalVtxCount;
+    DrawData.TotalIdxCount = draw_data->TotalIdxCount;
+    DrawData.CmdListsChangedCount = draw_data->CmdListsChangedCount;
+    DisplaySize = ImGui::GetIO().DisplaySize;
+    draw_data->Valid = false;
+}
+
+//-----------------------------------------------------------------------------
+// ImDrawDataEncoder, ImDrawDataDecoder
+//-----------------------------------------------------------------------------
+
+// Frames are compressed with stb_compress() and decompressed with stb_decompress_checked(), implemented along with stb_decompress() at the end of this file
+static unsigned int stb_decompress_length_checked(const unsigned char *input, unsigned int input_size);
+static unsigned int stb_decompress_checked(unsigned char *output, unsigned int output_size, const unsigned char *input, unsigned int input_size);
+static unsigned int stb_compress(unsigned char *out, unsigned char *input, unsigned int length);
+
+#define IM_DRAWDATA_STREAM_VERSION      1
+#define IM_DRAWDATA_STREAM_KEYFRAME     0x01
+#define IM_DRAWDATA_STREAM_MAX_SIZE     (256 * 1024 * 1024)    // Sanity check on the decompressed size announced by a frame
+
+// A command as serialized in the stream
+struct ImDrawDataStreamCmd
+{
+    unsigned int    ElemCount;
+    unsigned int    IdxOffset;
+    ImVec4          ClipRect;
+    unsigned char   TextureId[8];
+
+    ImDrawDataStreamCmd() { ElemCount = IdxOffset = 0; memset(TextureId, 0, sizeof(TextureId)); }
+};
+
+static void StreamWrite(ImVector<unsigned char>& buf, const void* data, int size)
+{
+    const int off = buf.Size;
+    buf.resize(off + size);
+    memcpy(buf.Data + off, data, (size_t)size);
+}
+
+static void StreamWriteU32(ImVector<unsigned char>& buf, unsigned int v)
+{
+    StreamWrite(buf, &v, 4);
+}
+
+static void StreamWriteTexID(ImVector<unsigned char>& buf, ImTextureID tex_id)
+{
+    unsigned char bytes[8];
+    memset(bytes, 0, sizeof(bytes));
+    memcpy(bytes, &tex_id, sizeof(tex_id));
+    StreamWrite(buf, bytes, sizeof(bytes));
+}
+
+// Append 'curr' XORed with 'prev' (padded with zeroes), so bytes that didn't change since the previous frame are sent as zeroes
+static void StreamWriteDelta(ImVector<unsigned char>& buf, const unsigned char* curr, int curr_size, const ImVector<unsigned char>& prev)
+{
+    const int off = buf.Size;
+    buf.resize(off + curr_size);
+    unsigned char* out = buf.Data + off;
+    const int common = ImMin(curr_size, prev.Size);
+    for (int i = 0; i < common; i++)
+        out[i] = curr[i] ^ prev.Data[i];
+    memcpy(out + common, curr + common, (size_t)(curr_size - common));
+}
+
+// XOR 'size' bytes of 'delta' into 'data', which holds 'prev_size' bytes of the previous frame
+static void StreamApplyDelta(unsigned char* data, int prev_size, const unsigned char* delta, int size)
+{
+    const int common = ImMin(size, prev_size);
+    for (int i = 0; i < common; i++)
+        data[i] ^= delta[i];
+    memcpy(data + common, delta + common, (size_t)(size - common));
+}
+
+static void StreamCopy(ImVector<unsigned char>& dst, const void* src, int size)
+{
+    dst.resize(size);
+    if (size > 0)
+        memcpy(dst.Data, src, (size_t)size);
+}
+
+// Stream states are held by pointer, so ImVector never copies their buffers around
+static int FindStreamList(const ImVector<ImDrawDataStreamList*>& lists, ImGuiID key, int hint)
+{
+    if (hint < lists.Size && lists[hint] && lists[hint]->Key == key)
+        return hint;
+    for (int i = 0; i < lists.Size; i++)
+        if (lists[i] && lists[i]->Key == key)
+            return i;
+    return -1;
+}
+
+static void DestroyStreamList(ImDrawDataStreamList* list)
+{
+    if (list == NULL)
+        return;
+    if (list->List)
+    {
+        list->List->~ImDrawList();
+        ImGui::MemFree(list->List);
+    }
+    list->~ImDrawDataStreamList();
+    ImGui::MemFree(list);
+}
+
+static void DestroyStreamLists(ImVector<ImDrawDataStreamList*>& lists)
+{
+    for (int i = 0; i < lists.Size; i++)
+        DestroyStreamList(lists[i]);
+    lists.clear();
+}
+
+// Match this frame's draw lists with the states kept from the previous frame. Unmatched states are destroyed, new ones start empty.
+static void UpdateStreamLists(ImVector<ImDrawDataStreamList*>& lists, const ImGuiID* keys, int keys_count)
+{
+    ImVector<ImDrawDataStreamList*> new_lists;
+    new_lists.resize(keys_count);
+    for (int i = 0; i < keys_count; i++)
+    {
+        const int prev_i = FindStreamList(lists, keys[i], i);
+        if (prev_i >= 0)
+        {
+            // Take ownership of the previous state
+            new_lists[i] = lists[prev_i];
+            lists[prev_i] = NULL;
+        }
+        else
+        {
+            new_lists[i] = (ImDrawDataStreamList*)ImGui::MemAlloc(sizeof(ImDrawDataStreamList));
+            IM_PLACEMENT_NEW(new_lists[i]) ImDrawDataStreamList();
+            new_lists[i]->Key = keys[i];
+        }
+    }
+    DestroyStreamLists(lists);
+    lists.swap(new_lists);
+}
+
+static ImDrawDataStreamTexture* FindStreamTexture(const ImVector<ImDrawDataStreamTexture*>& textures, ImTextureID tex_id)
+{
+    for (int i = 0; i < textures.Size; i++)
+        if (textures[i]->TexID == tex_id)
+            return textures[i];
+    return NULL;
+}
+
+static ImDrawDataStreamTexture* AddStreamTexture(ImVector<ImDrawDataStreamTexture*>& textures, ImTextureID tex_id)
+{
+    ImDrawDataStreamTexture* tex = (ImDrawDataStreamTexture*)ImGui::MemAlloc(sizeof(ImDrawDataStreamTexture));
+    IM_PLACEMENT_NEW(tex) ImDrawDataStreamTexture();
+    tex->TexID = tex_id;
+    textures.push_back(tex);
+    return tex;
+}
+
+static void DestroyStreamTextures(ImVector<ImDrawDataStreamTexture*>& textures)
+{
+    for (int i = 0; i < textures.Size; i++)
+    {
+        textures[i]->~ImDrawDataStreamTexture();
+        ImGui::MemFree(textures[i]);
+    }
+    textures.clear();
+}
+
+ImDrawDataEncoder::ImDrawDataEncoder()
+{
+    IM_ASSERT(sizeof(ImTextureID) <= 8);
+    FrameCount = 0;
+    LastDrawDataBytes = LastPayloadBytes = 0;
+}
+
+ImDrawDataEncoder::~ImDrawDataEncoder()
+{
+    DestroyStreamLists(Lists);
+    DestroyStreamTextures(Textures);
+}
+
+void ImDrawDataEncoder::SetTexture(ImTextureID tex_id, const unsigned char* pixels, int width, int height, int bytes_per_pixel)
+{
+    IM_ASSERT(pixels != NULL && width > 0 && height > 0 && (bytes_per_pixel == 1 || bytes_per_pixel == 4));
+    ImDrawDataStreamTexture* tex = FindStreamTexture(Textures, tex_id);
+    if (tex == NULL)
+        tex = AddStreamTexture(Textures, tex_id);
+
+    const int size = width * height * bytes_per_pixel;
+    const ImU32 hash = ImHash(pixels, size, 0);
+    if (tex->Width == width && tex->Height == height && tex->BytesPerPixel == bytes_per_pixel && tex->Hash == hash && tex->Pixels.Size == size && memcmp(tex->Pixels.Data, pixels, (size_t)size) == 0)
+        return;
+    tex->Width = width;
+    tex->Height = height;
+    tex->BytesPerPixel = bytes_per_pixel;
+    tex->Hash = hash;
+    StreamCopy(tex->Pixels, pixels, size);
+    tex->Pending = true;
+}
+
+void ImDrawDataEncoder::Reset()
+{
+    DestroyStreamLists(Lists);
+    for (int i = 0; i < Textures.Size; i++)
+        Textures[i]->Pending = true;
+    FrameCount = 0;
+}
+
+void ImDrawDataEncoder::EncodeFrame(const ImDrawData* draw_data, const ImVec2& display_size, ImVector<unsigned char>* out)
+{
+    IM_ASSERT(draw_data != NULL && out != NULL);
+
+    // Identify each draw list by its owner window, so deltas are computed against the same window even when the order of the lists changes
+    const int lists_count = draw_data->Valid ? draw_data->CmdListsCount : 0;
+    ImVector<ImGuiID> keys;
+    keys.resize(lists_count);
+    for (int i = 0; i < lists_count; i++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[i];
+        ImGuiID key = cmd_list->_OwnerName ? ImHash(cmd_list->_OwnerName, 0, 0) : ImHash(&i, sizeof(i), 0);
+        for (int j = 0; j < i; j++)
+            if (keys[j] == key)
+            {
+                key = ImHash(&key, sizeof(key), key + 1);
+                j = -1;
+            }
+        keys[i] = key;
+    }
+    UpdateStreamLists(Lists, keys.Data, lists_count);
+
+    // Header
+    const unsigned short flags = (FrameCount == 0) ? IM_DRAWDATA_STREAM_KEYFRAME : 0;
+    Payload.resize(0);
+    StreamWriteU32(Payload, IM_DRAWDATA_STREAM_VERSION);
+    const unsigned char sizes[2] = { (unsigned char)sizeof(ImDrawIdx), (unsigned char)sizeof(ImDrawVert) };
+    StreamWrite(Payload, sizes, 2);
+    StreamWrite(Payload, &flags, 2);
+    StreamWriteU32(Payload, FrameCount);
+    StreamWrite(Payload, &display_size, sizeof(ImVec2));
+
+    // Textures
+    int pending_count = 0;
+    for (int i = 0; i < Textures.Size; i++)
+        pending_count += Textures[i]->Pending ? 1 : 0;
+    StreamWriteU32(Payload, (unsigned int)pending_count);
+    for (int i = 0; i < Textures.Size; i++)
+    {
+        ImDrawDataStreamTexture& tex = *Textures[i];
+        if (!tex.Pending)
+            continue;
+        StreamWriteTexID(Payload, tex.TexID);
+        StreamWriteU32(Payload, (unsigned int)tex.Width);
+        StreamWriteU32(Payload, (unsigned int)tex.Height);
+        StreamWriteU32(Payload, (unsigned int)tex.BytesPerPixel);
+        StreamWrite(Payload, tex.Pixels.Data, tex.Pixels.Size);
+        tex.Pending = false;
+    }
+
+    // Draw lists
+    LastDrawDataBytes = 0;
+    StreamWriteU32(Payload, (unsigned int)lists_count);
+    ImVector<unsigned char> cmds, idx;
+    for (int i = 0; i < lists_count; i++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[i];
+        ImDrawDataStreamList& state = *Lists[i];
+        IM_ASSERT(cmd_list->QuadBuffer.Size == 0);  // Quads are not streamed: leave io.RenderDrawListsUseQuads unset on the encoding side
+
+        // Only the indices drawn by the commands are sent, one range after the other
+        cmds.resize(0);
+        idx.resize(0);
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+                continue;
+            IM_ASSERT(pcmd->IdxOffset + pcmd->ElemCount <= (unsigned int)cmd_list->IdxBuffer.Size);
+            ImDrawDataStreamCmd cmd;
+            cmd.ElemCount = pcmd->ElemCount;
+            cmd.IdxOffset = (unsigned int)(idx.Size / (int)sizeof(ImDrawIdx));
+            cmd.ClipRect = pcmd->ClipRect;
+            memcpy(cmd.TextureId, &pcmd->TextureId, sizeof(pcmd->TextureId));
+            StreamWrite(cmds, &cmd, sizeof(cmd));
+            StreamWrite(idx, cmd_list->IdxBuffer.Data + pcmd->IdxOffset, (int)pcmd->ElemCount * (int)sizeof(ImDrawIdx));
+        }
+        const int vtx_bytes = cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        StreamWriteU32(Payload, state.Key);
+        StreamWriteU32(Payload, (unsigned int)(cmds.Size / (int)sizeof(ImDrawDataStreamCmd)));
+        StreamWriteU32(Payload, (unsigned int)(idx.Size / (int)sizeof(ImDrawIdx)));
+        StreamWriteU32(Payload, (unsigned int)cmd_list->VtxBuffer.Size);
+        StreamWriteDelta(Payload, cmds.Data, cmds.Size, state.Cmds);
+        StreamWriteDelta(Payload, idx.Data, idx.Size, state.Idx);
+        StreamWriteDelta(Payload, (const unsigned char*)cmd_list->VtxBuffer.Data, vtx_bytes, state.Vtx);
+        state.Cmds.swap(cmds);
+        state.Idx.swap(idx);
+        StreamCopy(state.Vtx, cmd_list->VtxBuffer.Data, vtx_bytes);
+        LastDrawDataBytes += cmd_list->CmdBuffer.Size * (int)sizeof(ImDrawCmd) + cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx) + vtx_bytes;
+    }
+    LastPayloadBytes = Payload.Size;
+
+    out->resize(Payload.Size + Payload.Size / 4 + 512);
+    const unsigned int out_size = stb_compress(out->Data, Payload.Data, (unsigned int)Payload.Size);
+    IM_ASSERT((int)out_size <= out->Size);
+    out->resize((int)out_size);
+    FrameCount++;
+}
+
+// Bounds-checked reads over a decompressed frame
+struct ImDrawDataStreamReader
+{
+    const unsigned char*    Ptr;
+    const unsigned char*    End;
+
+    ImDrawDataStreamReader(const unsigned char* data, int size) { Ptr = data; End = data + size; }
+    bool                    CanRead(unsigned int size) const    { return size <= (unsigned int)(End - Ptr); }
+    const unsigned char*    Read(unsigned int size)             { if (!CanRead(size)) { Fail(); return NULL; } const unsigned char* p = Ptr; Ptr += size; return p; }
+    unsigned int            ReadU32()                           { const unsigned char* p = Read(4); unsigned int v = 0; if (p) memcpy(&v, p, 4); return v; }
+    void                    Fail()                              { Ptr = End + 1; }
+    bool                    Failed() const                      { return Ptr > End; }
+};
+
+ImDrawDataDecoder::ImDrawDataDecoder()
+{
+    IM_ASSERT(sizeof(ImTextureID) <= 8);
+    DisplaySize = ImVec2(0.0f, 0.0f);
+    FrameCount = 0;
+}
+
+ImDrawDataDecoder::~ImDrawDataDecoder()
+{
+    Clear();
+}
+
+void ImDrawDataDecoder::Clear()
+{
+    DestroyStreamLists(Lists);
+    CmdLists.clear();
+    DestroyStreamTextures(Textures);
+    Payload.clear();
+    DrawData = ImDrawData();
+    FrameCount = 0;
+}
+
+const ImDrawDataStreamTexture* ImDrawDataDecoder::FindTexture(ImTextureID tex_id) const
+{
+    return FindStreamTexture(Textures, tex_id);
+}
+
+bool ImDrawDataDecoder::DecodeFrame(const unsigned char* data, int data_size)
+{
+    // Decompress
+    if (data == NULL || data_size < 16 + 6)
+        return false;
+    const unsigned int payload_size = stb_decompress_length_checked(data, (unsigned int)data_size);
+    if (payload_size > IM_DRAWDATA_STREAM_MAX_SIZE)
+        return false;
+    Payload.resize((int)payload_size);
+    if (stb_decompress_checked(Payload.Data, payload_size, data, (unsigned int)data_size) != payload_size)
+        return false;
+
+    // Header
+    DrawData.Valid = false;
+    ImDrawDataStreamReader r(Payload.Data, Payload.Size);
+    const unsigned int version = r.ReadU32();
+    const unsigned char* sizes = r.Read(4);
+    const unsigned int frame_index = r.ReadU32();
+    const unsigned char* display_size = r.Read(sizeof(ImVec2));
+    if (r.Failed() || version != IM_DRAWDATA_STREAM_VERSION || sizes[0] != sizeof(ImDrawIdx) || sizes[1] != sizeof(ImDrawVert))
+        return false;
+    unsigned short flags;
+    memcpy(&flags, sizes + 2, 2);
+    if (!(flags & IM_DRAWDATA_STREAM_KEYFRAME) && (Lists.Size + Textures.Size == 0 || frame_index != FrameCount))
+        return false;   // Missed a frame, wait for the next keyframe
+    memcpy(&DisplaySize, display_size, sizeof(ImVec2));
+
+    // Past this point a malformed frame leaves us with partially updated state, which we discard
+    if (flags & IM_DRAWDATA_STREAM_KEYFRAME)
+        for (int i = 0; i < Lists.Size; i++)
+        {
+            Lists[i]->Cmds.resize(0);
+            if (Lists[i]->List)
+                Lists[i]->List->Clear();
+        }
+
+    // Textures
+    const unsigned int textures_count = r.ReadU32();
+    for (unsigned int n = 0; n < textures_count && !r.Failed(); n++)
+    {
+        const unsigned char* id_bytes = r.Read(8);
+        const unsigned int w = r.ReadU32(), h = r.ReadU32(), bpp = r.ReadU32();
+        if (r.Failed() || w == 0 || h == 0 || (bpp != 1 && bpp != 4) || w > 16384 || h > 16384 || !r.CanRead(w * h * bpp))
+        {
+            r.Fail();
+            break;
+        }
+        ImTextureID tex_id;
+        memcpy(&tex_id, id_bytes, sizeof(tex_id));
+        ImDrawDataStreamTexture* tex = FindStreamTexture(Textures, tex_id);
+        if (tex == NULL)
+            tex = AddStreamTexture(Textures, tex_id);
+        tex->Width = (int)w;
+        tex->Height = (int)h;
+        tex->BytesPerPixel = (int)bpp;
+        StreamCopy(tex->Pixels, r.Read(w * h * bpp), (int)(w * h * bpp));
+        tex->Version++;
+    }
+
+    // Draw lists
+    const unsigned int lists_count = r.ReadU32();
+    if (r.Failed() || !r.CanRead(lists_count * 16))
+    {
+        Clear();
+        return false;
+    }
+    ImVector<ImGuiID> keys;
+    keys.resize((int)lists_count);
+    ImDrawDataStreamReader keys_reader = r;
+    for (unsigned int i = 0; i < lists_count; i++)
+    {
+        keys[i] = keys_reader.ReadU32();
+        const unsigned int cmd_count = keys_reader.ReadU32(), idx_count = keys_reader.ReadU32(), vtx_count = keys_reader.ReadU32();
+        if (cmd_count > payload_size / sizeof(ImDrawDataStreamCmd) || idx_count > payload_size / sizeof(ImDrawIdx) || vtx_count > payload_size / sizeof(ImDrawVert))
+            keys_reader.Fail();
+        if (keys_reader.Failed())
+            break;
+        keys_reader.Read(cmd_count * (unsigned int)sizeof(ImDrawDataStreamCmd));
+        keys_reader.Read(idx_count * (unsigned int)sizeof(ImDrawIdx));
+        keys_reader.Read(vtx_count * (unsigned int)sizeof(ImDrawVert));
+    }
+    if (keys_reader.Failed())
+    {
+        Clear();
+        return false;
+    }
+    UpdateStreamLists(Lists, keys.Data, (int)lists_count);
+
+    DrawData.TotalIdxCount = DrawData.TotalVtxCount = 0;
+    CmdLists.resize((int)lists_count);
+    for (unsigned int i = 0; i < lists_count; i++)
+    {
+        ImDrawDataStreamList& state = *Lists[i];
+        if (state.List == NULL)
+        {
+            state.List = (ImDrawList*)ImGui::MemAlloc(sizeof(ImDrawList));
+            IM_PLACEMENT_NEW(state.List) ImDrawList();
+        }
+        ImDrawList* cmd_list = state.List;
+        CmdLists[i] = cmd_list;
+
+        r.ReadU32();
+        const int cmd_count = (int)r.ReadU32(), idx_count = (int)r.ReadU32(), vtx_count = (int)r.ReadU32();
+        const int cmds_bytes = cmd_count * (int)sizeof(ImDrawDataStreamCmd);
+        const int prev_cmds_bytes = state.Cmds.Size, prev_idx_count = cmd_list->IdxBuffer.Size, prev_vtx_count = cmd_list->VtxBuffer.Size;
+        state.Cmds.resize(cmds_bytes);
+        cmd_list->IdxBuffer.resize(idx_count);
+        cmd_list->VtxBuffer.resize(vtx_count);
+        StreamApplyDelta(state.Cmds.Data, prev_cmds_bytes, r.Read((unsigned int)cmds_bytes), cmds_bytes);
+        StreamApplyDelta((unsigned char*)cmd_list->IdxBuffer.Data, prev_idx_count * (int)sizeof(ImDrawIdx), r.Read((unsigned int)idx_count * sizeof(ImDrawIdx)), idx_count * (int)sizeof(ImDrawIdx));
+        StreamApplyDelta((unsigned char*)cmd_list->VtxBuffer.Data, prev_vtx_count * (int)sizeof(ImDrawVert), r.Read((unsigned int)vtx_count * sizeof(ImDrawVert)), vtx_count * (int)sizeof(ImDrawVert));
+
+        // Rebuild the commands, validating the indices of each one so a renderer can't read out of its buffers.
+        // The encoder sends the ranges of the commands one after the other, we require it so renderers summing ElemCount read the same indices.
+        bool valid = true;
+        unsigned int idx_end = 0;
+        cmd_list->CmdBuffer.resize(cmd_count);
+        for (int cmd_i = 0; cmd_i < cmd_count && valid; cmd_i++)
+        {
+            const ImDrawDataStreamCmd& cmd = ((const ImDrawDataStreamCmd*)state.Cmds.Data)[cmd_i];
+            ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            pcmd->ElemCount = cmd.ElemCount;
+            pcmd->IdxOffset = cmd.IdxOffset;
+            pcmd->ClipRect = cmd.ClipRect;
+            memcpy(&pcmd->TextureId, cmd.TextureId, sizeof(pcmd->TextureId));
+            pcmd->UserCallback = NULL;
+            pcmd->UserCallbackData = NULL;
+            valid = cmd.IdxOffset == idx_end && cmd.ElemCount <= (unsigned int)idx_count - idx_end;
+            for (unsigned int idx_i = idx_end, idx_i_end = idx_end + cmd.ElemCount; idx_i < idx_i_end && valid; idx_i++)
+                valid = cmd_list->IdxBuffer.Data[idx_i] < vtx_count;
+            idx_end += cmd.ElemCount;
+        }
+        if (!valid || idx_end != (unsigned int)idx_count)
+        {
+            Clear();
+            return false;
+        }
+        DrawData.TotalIdxCount += idx_count;
+        DrawData.TotalVtxCount += vtx_count;
+    }
+
+    DrawData.Valid = true;
+    DrawData.CmdLists = CmdLists.Data;
+    DrawData.CmdListsCount = CmdLists.Size;
+    FrameCount = frame_index + 1;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // ImFontAtlas
 //-----------------------------------------------------------------------------
@@ -1041,6 +1872,8 @@ ImFontAtlas::ImFontAtlas()
     TexPixelsRGBA32 = NULL;
     TexWidth = TexHeight = TexDesiredWidth = 0;
     TexUvWhitePixel = ImVec2(0, 0);
+    for (int n = 0; n < IM_ARRAYSIZE(TexUvLines); n++)
+        TexUvLines[n] = ImVec4(0, 0, 0, 0);
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1254,6 +2087,8 @@ bool    ImFontAtlas::Build()
     TexID = NULL;
     TexWidth = TexHeight = 0;
     TexUvWhitePixel = ImVec2(0, 0);
+    for (int n = 0; n < IM_ARRAYSIZE(TexUvLines); n++)
+        TexUvLines[n] = ImVec4(0, 0, 0, 0);
     ClearTexData();
 
     struct ImFontTempBuildData
@@ -1499,6 +2334,11 @@ void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
         r.w = (TEX_DATA_W*2)+1;
         r.h = TEX_DATA_H+1;
         rects.push_back(r);
+
+        // Anti-aliased line profiles: one row per integer width
+        r.w = IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2;
+        r.h = IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1;
+        rects.push_back(r);
     }
     else if (pass == 1)
     {
@@ -1515,6 +2355,19 @@ void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
         const ImVec2 tex_uv_scale(1.0f / TexWidth, 1.0f / TexHeight);
         TexUvWhitePixel = ImVec2((r.x + 0.5f) * tex_uv_scale.x, (r.y + 0.5f) * tex_uv_scale.y);
 
+        // Row n holds a centered run of n opaque texels. The UV span includes one transparent texel on each side, so bilinear filtering
+        // produces the 1 pixel AA fringe when the span is stretched over thickness + 2 pixels. V samples the middle of the row.
+        const stbrp_rect& r_lines = rects[1];
+        for (int n = 0; n <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX; n++)
+        {
+            const int pad_left = (r_lines.w - n) / 2;
+            unsigned char* write_ptr = TexPixelsAlpha8 + r_lines.x + (r_lines.y + n) * TexWidth;
+            for (int x = 0; x < r_lines.w; x++)
+                write_ptr[x] = (x >= pad_left && x < pad_left + n) ? 0xFF : 0x00;
+            const float v = (r_lines.y + n + 0.5f) * tex_uv_scale.y;
+            TexUvLines[n] = ImVec4((r_lines.x + pad_left - 1) * tex_uv_scale.x, v, (r_lines.x + pad_left + n + 1) * tex_uv_scale.x, v);
+        }
+
         // Setup mouse cursors
         const ImVec2 cursor_datas[ImGuiMouseCursor_Count_][3] =
         {
@@ -1528,7 +2381,8 @@ void ImFontAtlas::RenderCustomTexData(int pass, void* p_rects)
             { ImVec2(55,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNWSE
         };
 
-        for (int type = 0; type < ImGuiMouseCursor_Count_; type++)
+        // The cursor data lives in the current context (there may be none when building a shared atlas with IMGUI_USE_THREAD_LOCAL_CONTEXT)
+        for (int type = 0; type < ImGuiMouseCursor_Count_ && GImGui != NULL; type++)
         {
             ImGuiMouseCursorData& cursor_data = GImGui->MouseCursorData[type];
             ImVec2 pos = cursor_datas[type][0] + ImVec2((float)r.x, (float)r.y);
@@ -1628,6 +2482,7 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesJapanese()
         0x31F0, 0x31FF, // Katakana Phonetic Extensions
         0xFF00, 0xFFEF, // Half-width characters
     };
+    // Unpacked on first call: call this before sharing the atlas between threads (it is normally called while building the atlas)
     static bool full_ranges_unpacked = false;
     static ImWchar full_ranges[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(offsets_from_0x4E00)*2 + 1];
     if (!full_ranges_unpacked)
@@ -1668,6 +2523,208 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesThai()
     return &ranges[0];
 }
 
+//-----------------------------------------------------------------------------
+// ImImageAtlas
+//-----------------------------------------------------------------------------
+
+#define IM_IMAGE_ATLAS_MIN_SIZE     256
+
+ImImageAtlas::ImImageAtlas()
+{
+    TexID = NULL;
+    TexPixelsRGBA32 = NULL;
+    TexWidth = TexHeight = 0;
+    TexMaxSize = 4096;
+    Padding = 1;
+    TexDirty = TexResized = false;
+    TexDirtyX0 = TexDirtyY0 = TexDirtyX1 = TexDirtyY1 = 0;
+    FreedArea = 0;
+    PackContext = NULL;
+}
+
+ImImageAtlas::~ImImageAtlas()
+{
+    Clear();
+}
+
+void ImImageAtlas::Clear()
+{
+    if (TexPixelsRGBA32)
+        ImGui::MemFree(TexPixelsRGBA32);
+    if (PackContext)
+        ImGui::MemFree(PackContext);
+    TexPixelsRGBA32 = NULL;
+    PackContext = NULL;
+    TexWidth = TexHeight = 0;
+    Images.clear();
+    FreedArea = 0;
+    TexDirty = TexResized = false;
+    TexDirtyX0 = TexDirtyY0 = TexDirtyX1 = TexDirtyY1 = 0;
+}
+
+static stbrp_context* CreateImageAtlasPackContext(int width, int height)
+{
+    stbrp_context* context = (stbrp_context*)ImGui::MemAlloc(sizeof(stbrp_context) + width * sizeof(stbrp_node));
+    stbrp_init_target(context, width, height, (stbrp_node*)(context + 1), width);
+    return context;
+}
+
+static void ImageAtlasAddDirtyRect(ImImageAtlas* atlas, int x0, int y0, int x1, int y1)
+{
+    if (!atlas->TexDirty || atlas->TexDirtyX0 >= atlas->TexDirtyX1)
+    {
+        atlas->TexDirtyX0 = x0; atlas->TexDirtyY0 = y0; atlas->TexDirtyX1 = x1; atlas->TexDirtyY1 = y1;
+    }
+    else
+    {
+        atlas->TexDirtyX0 = ImMin(atlas->TexDirtyX0, x0); atlas->TexDirtyY0 = ImMin(atlas->TexDirtyY0, y0);
+        atlas->TexDirtyX1 = ImMax(atlas->TexDirtyX1, x1); atlas->TexDirtyY1 = ImMax(atlas->TexDirtyY1, y1);
+    }
+    atlas->TexDirty = true;
+}
+
+static void ImageAtlasBlit(ImImageAtlas* atlas, const ImImageAtlas::Image& image, const unsigned char* pixels_rgba, int src_pitch)
+{
+    for (int y = 0; y < image.Height; y++)
+        memcpy(atlas->TexPixelsRGBA32 + ((image.Y + y) * atlas->TexWidth + image.X) * 4, pixels_rgba + y * src_pitch, (size_t)image.Width * 4);
+    ImageAtlasAddDirtyRect(atlas, image.X, image.Y, image.X + image.Width, image.Y + image.Height);
+}
+
+// Pack all used images into a new texture, copying the pixels of those already in the old one (images with X < 0 are new and left blank).
+// Leave the atlas untouched and return false if they don't fit.
+bool ImImageAtlas::Repack(int tex_width, int tex_height)
+{
+    ImVector<stbrp_rect> rects;
+    rects.reserve(Images.Size);
+    for (int i = 0; i < Images.Size; i++)
+        if (Images[i].Used)
+        {
+            stbrp_rect r;
+            memset(&r, 0, sizeof(r));
+            r.id = i;
+            r.w = (stbrp_coord)(Images[i].Width + Padding * 2);
+            r.h = (stbrp_coord)(Images[i].Height + Padding * 2);
+            rects.push_back(r);
+        }
+    stbrp_context* context = CreateImageAtlasPackContext(tex_width, tex_height);
+    if (rects.Size > 0)
+        stbrp_pack_rects(context, rects.Data, rects.Size);
+    for (int i = 0; i < rects.Size; i++)
+        if (!rects[i].was_packed)
+        {
+            ImGui::MemFree(context);
+            return false;
+        }
+
+    unsigned char* pixels = (unsigned char*)ImGui::MemAlloc((size_t)tex_width * tex_height * 4);
+    memset(pixels, 0, (size_t)tex_width * tex_height * 4);
+    for (int i = 0; i < rects.Size; i++)
+    {
+        Image& image = Images[rects[i].id];
+        const int x = rects[i].x + Padding, y = rects[i].y + Padding;
+        if (image.X >= 0)
+            for (int row = 0; row < image.Height; row++)
+                memcpy(pixels + ((y + row) * tex_width + x) * 4, TexPixelsRGBA32 + ((image.Y + row) * TexWidth + image.X) * 4, (size_t)image.Width * 4);
+        image.X = x;
+        image.Y = y;
+    }
+    if (TexPixelsRGBA32)
+        ImGui::MemFree(TexPixelsRGBA32);
+    if (PackContext)
+        ImGui::MemFree(PackContext);
+    TexPixelsRGBA32 = pixels;
+    PackContext = context;
+    TexResized |= (TexWidth != tex_width || TexHeight != tex_height);
+    TexWidth = tex_width;
+    TexHeight = tex_height;
+    FreedArea = 0;
+    ImageAtlasAddDirtyRect(this, 0, 0, TexWidth, TexHeight);
+    return true;
+}
+
+int ImImageAtlas::AddImage(const unsigned char* pixels_rgba, int width, int height)
+{
+    IM_ASSERT(pixels_rgba != NULL && width > 0 && height > 0);
+    if (width + Padding * 2 > TexMaxSize || height + Padding * 2 > TexMaxSize)
+        return -1;
+
+    int handle = 0;
+    while (handle < Images.Size && Images[handle].Used)
+        handle++;
+    if (handle == Images.Size)
+        Images.resize(Images.Size + 1);
+    Image& image = Images[handle];
+    image.X = image.Y = -1;
+    image.Width = width;
+    image.Height = height;
+    image.Used = true;
+
+    // Try the free space left by the current packing first, then repack at the same size if images were removed, then grow
+    bool packed = false;
+    if (PackContext)
+    {
+        stbrp_rect r;
+        memset(&r, 0, sizeof(r));
+        r.w = (stbrp_coord)(width + Padding * 2);
+        r.h = (stbrp_coord)(height + Padding * 2);
+        stbrp_pack_rects((stbrp_context*)PackContext, &r, 1);
+        if (r.was_packed)
+        {
+            image.X = r.x + Padding;
+            image.Y = r.y + Padding;
+            packed = true;
+        }
+        else if (FreedArea > 0)
+        {
+            packed = Repack(TexWidth, TexHeight);
+        }
+    }
+    int tex_width = TexWidth, tex_height = TexHeight;
+    while (!packed)
+    {
+        if (tex_width == 0)
+            tex_width = tex_height = ImMin(IM_IMAGE_ATLAS_MIN_SIZE, TexMaxSize);
+        else if (tex_width <= tex_height && tex_width * 2 <= TexMaxSize)
+            tex_width *= 2;
+        else if (tex_height * 2 <= TexMaxSize)
+            tex_height *= 2;
+        else
+        {
+            image.Used = false;
+            return -1;
+        }
+        packed = Repack(tex_width, tex_height);
+    }
+    ImageAtlasBlit(this, image, pixels_rgba, width * 4);
+    return handle;
+}
+
+void ImImageAtlas::UpdateImage(int handle, const unsigned char* pixels_rgba)
+{
+    IM_ASSERT(handle >= 0 && handle < Images.Size && Images[handle].Used);
+    ImageAtlasBlit(this, Images[handle], pixels_rgba, Images[handle].Width * 4);
+}
+
+void ImImageAtlas::RemoveImage(int handle)
+{
+    IM_ASSERT(handle >= 0 && handle < Images.Size && Images[handle].Used);
+    Image& image = Images[handle];
+    image.Used = false;
+    FreedArea += (image.Width + Padding * 2) * (image.Height + Padding * 2);
+}
+
+bool ImImageAtlas::GetImage(int handle, ImTextureID* out_tex_id, ImVec2* out_uv0, ImVec2* out_uv1) const
+{
+    if (handle < 0 || handle >= Images.Size || !Images[handle].Used)
+        return false;
+    const Image& image = Images[handle];
+    const ImVec2 scale(1.0f / TexWidth, 1.0f / TexHeight);
+    if (out_tex_id) *out_tex_id = TexID;
+    if (out_uv0) *out_uv0 = ImVec2(image.X * scale.x, image.Y * scale.y);
+    if (out_uv1) *out_uv1 = ImVec2((image.X + image.Width) * scale.x, (image.Y + image.Height) * scale.y);
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // ImFont
 //-----------------------------------------------------------------------------
@@ -1997,6 +3054,11 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         pos.y = (float)(int)pos.y + DisplayOffset.y;
         ImVec2 pos_tl(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale);
         ImVec2 pos_br(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale);
+        if (draw_list->UseQuads)
+        {
+            draw_list->PrimQuad(pos_tl, pos_br, ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
+            return;
+        }
         draw_list->PrimReserve(6, 4);
         draw_list->PrimRectUV(pos_tl, pos_br, ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
     }
@@ -2026,11 +3088,16 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         while (s < text_end && *s != '\n')  // Fast-forward to next line
             s++;
 
-    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
-    const int vtx_count_max = (int)(text_end - s) * 4;
-    const int idx_count_max = (int)(text_end - s) * 6;
-    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
-    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+    // Reserve vertices (or quads, see ImDrawList::UseQuads) for remaining worse case (over-reserving is useful and easily amortized)
+    const int quad_count_max = (int)(text_end - s);
+    const int vtx_count_max = draw_list->UseQuads ? 0 : quad_count_max * 4;
+    const int idx_count_max = draw_list->UseQuads ? 0 : quad_count_max * 6;
+    ImDrawQuad* quad_write = NULL;
+    if (draw_list->UseQuads && quad_count_max > 0)
+        quad_write = draw_list->PrimReserveQuads(quad_count_max);
+    else
+        draw_list->PrimReserve(idx_count_max, vtx_count_max);
+    ImDrawQuad* const quad_write_start = quad_write;
 
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
@@ -2148,6 +3215,14 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
                     // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug build.
                     // Inlined here:
+                    if (quad_write)
+                    {
+                        quad_write->Min.x = x1; quad_write->Min.y = y1; quad_write->Max.x = x2; quad_write->Max.y = y2;
+                        quad_write->UvMin.x = u1; quad_write->UvMin.y = v1; quad_write->UvMax.x = u2; quad_write->UvMax.y = v2;
+                        quad_write->Col = col;
+                        quad_write++;
+                    }
+                    else
                     {
                         idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                         idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
@@ -2167,9 +3242,12 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     }
 
     // Give back unused vertices
-    draw_list->VtxBuffer.resize((int)(vtx_write - draw_list->VtxBuffer.Data));
-    draw_list->IdxBuffer.resize((int)(idx_write - draw_list->IdxBuffer.Data));
-    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    if (quad_write)
+    {
+        draw_list->PrimUnreserveQuads(quad_count_max - (int)(quad_write - quad_write_start));
+        return;
+    }
+    draw_list->PrimUnreserve(idx_count_max - (int)(idx_write - draw_list->_IdxWritePtr), vtx_count_max - (int)(vtx_write - draw_list->_VtxWritePtr));
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
@@ -2188,8 +3266,8 @@ static unsigned int stb_decompress_length(unsigned char *input)
     return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *stb__barrier, *stb__barrier2, *stb__barrier3, *stb__barrier4;
-static unsigned char *stb__dout;
+static IM_THREAD_LOCAL unsigned char *stb__barrier, *stb__barrier2, *stb__barrier3, *stb__barrier4;
+static IM_THREAD_LOCAL unsigned char *stb__dout;
 static void stb__match(unsigned char *data, unsigned int length)
 {
     // INVERSE of memmove... write each byte before copying the next...
@@ -2294,6 +3372,262 @@ static unsigned int stb_decompress(unsigned char *output, unsigned char *i, unsi
     }
 }
 
+// Variant of stb_decompress() for untrusted input, used by ImDrawDataDecoder: every token is checked against the end of the input, every copy against
+// the start and end of the output, and malformed data returns 0 instead of asserting. Doesn't use the stb__ globals.
+static unsigned int stb__in4_checked(const unsigned char *p)
+{
+    return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | (unsigned int)p[3];
+}
+
+static unsigned int stb_decompress_length_checked(const unsigned char *input, unsigned int input_size)
+{
+    return (input_size >= 16) ? stb__in4_checked(input + 8) : 0;
+}
+
+static unsigned int stb_decompress_checked(unsigned char *output, unsigned int output_size, const unsigned char *input, unsigned int input_size)
+{
+    const unsigned char *i = input, *i_end = input + input_size;
+    if (input_size < 16 || stb__in4_checked(i) != 0x57bC0000 || stb__in4_checked(i + 4) != 0)
+        return 0;
+    const unsigned int olen = stb__in4_checked(i + 8);
+    if (olen > output_size)
+        return 0;
+    unsigned char *dout = output, *dout_end = output + olen;
+    i += 16;
+
+    for (;;) {
+        const unsigned int avail = (unsigned int)(i_end - i);
+        if (avail < 1)
+            return 0;
+        unsigned int header, len, dist = 0;    // dist == 0 for literals
+        if (*i >= 0x80)                             { header = 2; if (avail < header) return 0; dist = i[1] + 1;                     len = i[0] - 0x80 + 1; }
+        else if (*i >= 0x40)                        { header = 3; if (avail < header) return 0; dist = stb__in2(0) - 0x4000 + 1;     len = i[2] + 1; }
+        else if (*i >= 0x20)                        { header = 1;                               len = i[0] - 0x20 + 1; }
+        else if (*i >= 0x18)                        { header = 4; if (avail < header) return 0; dist = stb__in3(0) - 0x180000 + 1;   len = i[3] + 1; }
+        else if (*i >= 0x10)                        { header = 5; if (avail < header) return 0; dist = stb__in3(0) - 0x100000 + 1;   len = stb__in2(3) + 1; }
+        else if (*i >= 0x08)                        { header = 2; if (avail < header) return 0; len = stb__in2(0) - 0x0800 + 1; }
+        else if (*i == 0x07)                        { header = 3; if (avail < header) return 0; len = stb__in2(1) + 1; }
+        else if (*i == 0x06)                        { header = 5; if (avail < header) return 0; dist = stb__in3(1) + 1;              len = i[4] + 1; }
+        else if (*i == 0x04)                        { header = 6; if (avail < header) return 0; dist = stb__in3(1) + 1;              len = stb__in2(4) + 1; }
+        else if (*i == 0x05 && avail >= 6 && i[1] == 0xfa)
+        {
+            if (dout != dout_end || stb_adler32(1, output, olen) != stb__in4_checked(i + 2))
+                return 0;
+            return olen;
+        }
+        else
+            return 0;
+
+        if (len > (unsigned int)(dout_end - dout))
+            return 0;
+        if (dist == 0)
+        {
+            if (len > avail - header)
+                return 0;
+            memcpy(dout, i + header, len);
+            dout += len;
+            i += header + len;
+        }
+        else
+        {
+            if (dist > (unsigned int)(dout - output))
+                return 0;
+            const unsigned char* src = dout - dist;     // May overlap the output: copy each byte before reading the next
+            while (len--)
+                *dout++ = *src++;
+            i += header;
+        }
+    }
+}
+
+// Compression from stb.h (public domain), used by ImDrawDataEncoder. Same as extra_fonts/binary_to_compressed_c.cpp, writing to memory only.
+static IM_THREAD_LOCAL unsigned char *stb__out;
+static IM_THREAD_LOCAL unsigned int stb__running_adler;
+
+static unsigned int stb_matchlen(unsigned char *m1, unsigned char *m2, unsigned int maxlen)
+{
+    unsigned int i;
+    for (i=0; i < maxlen; ++i)
+        if (m1[i] != m2[i]) return i;
+    return i;
+}
+
+#define stb_out(v)    (*stb__out++ = (unsigned char) (v))
+
+static void stb_out2(unsigned int v) { stb_out(v >> 8); stb_out(v); }
+static void stb_out3(unsigned int v) { stb_out(v >> 16); stb_out(v >> 8); stb_out(v); }
+static void stb_out4(unsigned int v) { stb_out(v >> 24); stb_out(v >> 16); stb_out(v >> 8 ); stb_out(v); }
+
+static void stb_outliterals(unsigned char *in, int numlit)
+{
+    while (numlit > 65536) {
+        stb_outliterals(in,65536);
+        in     += 65536;
+        numlit -= 65536;
+    }
+
+    if      (numlit ==     0)    ;
+    else if (numlit <=    32)    stb_out (0x000020 + numlit-1);
+    else if (numlit <=  2048)    stb_out2(0x000800 + numlit-1);
+    else /*  numlit <= 65536) */ stb_out3(0x070000 + numlit-1);
+
+    memcpy(stb__out,in,numlit);
+    stb__out += numlit;
+}
+
+static const int stb__window = 0x40000; // 256K
+static const unsigned int stb__hashsize = 32768;
+
+static int stb_not_crap(int best, int dist)
+{
+    return   ((best > 2  &&  dist <= 0x00100)
+        || (best > 5  &&  dist <= 0x04000)
+        || (best > 7  &&  dist <= 0x80000));
+}
+
+// note that you can play with the hashing functions all you
+// want without needing to change the decompressor
+#define stb__hc(q,h,c)      (((h) << 7) + ((h) >> 25) + q[c])
+#define stb__hc2(q,h,c,d)   (((h) << 14) + ((h) >> 18) + (q[c] << 7) + q[d])
+#define stb__hc3(q,c,d,e)   ((q[c] << 14) + (q[d] << 7) + q[e])
+
+static int stb_compress_chunk(unsigned char *start, unsigned char *end, int length, int *pending_literals, unsigned char **chash, unsigned int mask)
+{
+    int window = stb__window;
+    unsigned int match_max;
+    unsigned char *lit_start = start - *pending_literals;
+    unsigned char *q = start;
+
+#define STB__SCRAMBLE(h)   (((h) + ((h) >> 16)) & mask)
+
+    // stop short of the end so we don't scan off the end doing
+    // the hashing; this means we won't compress the last few bytes
+    // unless they were part of something longer
+    while (q < start+length && q+12 < end) {
+        int m;
+        unsigned int h1,h2,h3,h4, h;
+        unsigned char *t;
+        int best = 2, dist=0;
+
+        if (q+65536 > end)
+            match_max = (unsigned int)(end-q);
+        else
+            match_max = 65536;
+
+#define stb__nc(b,d)  ((d) <= window && ((b) > 9 || stb_not_crap(b,d)))
+
+#define STB__TRY(t,p)  /* avoid retrying a match we already tried */ \
+    if (p ? dist != q-t : 1)                                        \
+    if ((m = (int)stb_matchlen(t, q, match_max)) > best)            \
+    if (stb__nc(m,q-(t)))                                           \
+    best = m, dist = (int)(q - (t))
+
+        // rather than search for all matches, only try 4 candidate locations,
+        // chosen based on 4 different hash functions of different lengths.
+        // this strategy is inspired by LZO; hashing is unrolled here using the
+        // 'hc' macro
+        h = stb__hc3(q,0, 1, 2); h1 = STB__SCRAMBLE(h);
+        t = chash[h1]; if (t) STB__TRY(t,0);
+        h = stb__hc2(q,h, 3, 4); h2 = STB__SCRAMBLE(h);
+        h = stb__hc2(q,h, 5, 6);        t = chash[h2]; if (t) STB__TRY(t,1);
+        h = stb__hc2(q,h, 7, 8); h3 = STB__SCRAMBLE(h);
+        h = stb__hc2(q,h, 9,10);        t = chash[h3]; if (t) STB__TRY(t,1);
+        h = stb__hc2(q,h,11,12); h4 = STB__SCRAMBLE(h);
+        t = chash[h4]; if (t) STB__TRY(t,1);
+
+        // because we use a shared hash table, can only update it
+        // _after_ we've probed all of them
+        chash[h1] = chash[h2] = chash[h3] = chash[h4] = q;
+
+        if (best > 2)
+            IM_ASSERT(dist > 0);
+
+        // see if our best match qualifies
+        if (best < 3) { // fast path literals
+            ++q;
+        } else if (best > 2  &&  best <= 0x80    &&  dist <= 0x100) {
+            stb_outliterals(lit_start, (int)(q-lit_start)); lit_start = (q += best);
+            stb_out(0x80 + best-1);
+            stb_out(dist-1);
+        } else if (best > 5  &&  best <= 0x100   &&  dist <= 0x4000) {
+            stb_outliterals(lit_start, (int)(q-lit_start)); lit_start = (q += best);
+            stb_out2(0x4000 + dist-1);
+            stb_out(best-1);
+        } else if (best > 7  &&  best <= 0x100   &&  dist <= 0x80000) {
+            stb_outliterals(lit_start, (int)(q-lit_start)); lit_start = (q += best);
+            stb_out3(0x180000 + dist-1);
+            stb_out(best-1);
+        } else if (best > 8  &&  best <= 0x10000 &&  dist <= 0x80000) {
+            stb_outliterals(lit_start, (int)(q-lit_start)); lit_start = (q += best);
+            stb_out3(0x100000 + dist-1);
+            stb_out2(best-1);
+        } else if (best > 9                      &&  dist <= 0x1000000) {
+            if (best > 65536) best = 65536;
+            stb_outliterals(lit_start, (int)(q-lit_start)); lit_start = (q += best);
+            if (best <= 0x100) {
+                stb_out(0x06);
+                stb_out3(dist-1);
+                stb_out(best-1);
+            } else {
+                stb_out(0x04);
+                stb_out3(dist-1);
+                stb_out2(best-1);
+            }
+        } else {  // fallback literals if no match was a balanced tradeoff
+            ++q;
+        }
+    }
+
+    // if we didn't get all the way, add the rest to literals
+    if (q-start < length)
+        q = start+length;
+
+    // the literals are everything from lit_start to q
+    *pending_literals = (int)(q - lit_start);
+
+    stb__running_adler = stb_adler32(stb__running_adler, start, (unsigned int)(q - start));
+    return (int)(q - start);
+}
+
+#undef STB__SCRAMBLE
+#undef STB__TRY
+#undef stb__nc
+
+// Output needs up to length + length/4 + 512 bytes for incompressible data
+static unsigned int stb_compress(unsigned char *out, unsigned char *input, unsigned int length)
+{
+    stb__out = out;
+    int literals = 0;
+    unsigned char **chash = (unsigned char**)ImGui::MemAlloc(stb__hashsize * sizeof(unsigned char*));
+    memset(chash, 0, stb__hashsize * sizeof(unsigned char*));
+
+    // stream signature
+    stb_out(0x57); stb_out(0xbc);
+    stb_out2(0);
+
+    stb_out4(0);       // 64-bit length requires 32-bit leading 0
+    stb_out4(length);
+    stb_out4(stb__window);
+
+    stb__running_adler = 1;
+
+    unsigned int len = (unsigned int)stb_compress_chunk(input, input+length, (int)length, &literals, chash, stb__hashsize-1);
+    IM_ASSERT(len == length);
+    (void)len;
+
+    stb_outliterals(input+length - literals, literals);
+
+    ImGui::MemFree(chash);
+
+    stb_out2(0x05fa); // end opcode
+
+    stb_out4(stb__running_adler);
+
+    return (unsigned int)(stb__out - out);
+}
+
+#undef stb_out
+
 //-----------------------------------------------------------------------------
 // ProggyClean.ttf
 // Copyright (c) 2004, 2005 Tristan Grimmer
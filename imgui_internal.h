@@ -37,9 +37,12 @@ struct ImGuiGroupData;
 struct ImGuiSimpleColumns;
 struct ImGuiDrawContext;
 struct ImGuiTextEditState;
+struct ImGuiTextRopeEditState;
 struct ImGuiIniData;
+struct ImGuiLogWriteJob;
 struct ImGuiMouseCursorData;
 struct ImGuiPopupRef;
+struct ImGuiProfiler;
 struct ImGuiWindow;
 
 typedef int ImGuiLayoutType;      // enum ImGuiLayoutType_
@@ -67,8 +70,19 @@ namespace ImGuiStb
 // Context
 //-----------------------------------------------------------------------------
 
+// Storage class of the current context pointer and of the few other statics which can't be shared by threads (see IMGUI_USE_THREAD_LOCAL_CONTEXT)
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+#ifdef _MSC_VER
+#define IM_THREAD_LOCAL         __declspec(thread)
+#else
+#define IM_THREAD_LOCAL         __thread
+#endif
+#else
+#define IM_THREAD_LOCAL
+#endif
+
 #ifndef GImGui
-extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointer
+extern IMGUI_API IM_THREAD_LOCAL ImGuiContext* GImGui;  // Current implicit ImGui context pointer
 #endif
 
 //-----------------------------------------------------------------------------
@@ -79,6 +93,10 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointe
 #define IM_PI                   3.14159265358979323846f
 #define IM_OFFSETOF(_TYPE,_ELM) ((size_t)&(((_TYPE*)0)->_ELM))
 
+#ifndef IMGUI_DRAWLIST_TRIM_FRAMES
+#define IMGUI_DRAWLIST_TRIM_FRAMES      120     // See imconfig.h. Also the number of frames after which NewFrame() frees the draw list of a window that isn't submitted anymore
+#endif
+
 // Helpers: UTF-8 <> wchar
 IMGUI_API int           ImTextStrToUtf8(char* buf, int buf_size, const ImWchar* in_text, const ImWchar* in_text_end);      // return output UTF-8 bytes count
 IMGUI_API int           ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end);          // return input UTF-8 bytes count
@@ -91,7 +109,29 @@ IMGUI_API ImU32         ImHash(const void* data, int data_size, ImU32 seed = 0);
 IMGUI_API void*         ImFileLoadToMemory(const char* filename, const char* file_open_mode, int* out_file_size = NULL, int padding_bytes = 0);
 IMGUI_API FILE*         ImFileOpen(const char* filename, const char* file_open_mode);         
 IMGUI_API bool          ImIsPointInTriangle(const ImVec2& p, const ImVec2& a, const ImVec2& b, const ImVec2& c);
+IMGUI_API double        ImTimeNow();                                                // Monotonic clock, in seconds. Used by the frame profiler.
+
+// Helpers: Flags shared with jobs running on other threads (see io.FileWriteAsyncFn)
+#if defined(__GNUC__) || defined(__clang__)
+static inline int       ImAtomicLoad(volatile int* p)           { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void      ImAtomicStore(volatile int* p, int v)   { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static inline int       ImAtomicExchange(volatile int* p, int v){ return __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL); }
+#elif defined(_MSC_VER)
+#include <intrin.h>
+static inline int       ImAtomicLoad(volatile int* p)           { int v = *p; _ReadWriteBarrier(); return v; }
+static inline void      ImAtomicStore(volatile int* p, int v)   { _InterlockedExchange((volatile long*)p, (long)v); }
+static inline int       ImAtomicExchange(volatile int* p, int v){ return (int)_InterlockedExchange((volatile long*)p, (long)v); }
+#else
+// Other compilers: plain volatile accesses, without ordering guarantees. Only safe if io.FileWriteAsyncFn runs its jobs synchronously
+// and all contexts are used from the same thread (the memory pools of every context share one process-wide lock).
+static inline int       ImAtomicLoad(volatile int* p)           { return *p; }
+static inline void      ImAtomicStore(volatile int* p, int v)   { *p = v; }
+static inline int       ImAtomicExchange(volatile int* p, int v){ int old = *p; *p = v; return old; }
+#endif
+IMGUI_API void          ImThreadYield();                                            // Give up the rest of our time slice, while waiting for another thread
 static inline bool      ImCharIsSpace(int c)            { return c == ' ' || c == '\t' || c == 0x3000; }
+static inline char      ImCharToLower(char c)           { return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c; }
+static inline char      ImCharToUpper(char c)           { return (c >= 'a' && c <= 'z') ? (char)(c - ('a' - 'A')) : c; }
 static inline int       ImUpperPowerOfTwo(int v)        { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
 
 // Helpers: String
@@ -101,6 +141,7 @@ IMGUI_API char*         ImStrdup(const char* str);
 IMGUI_API int           ImStrlenW(const ImWchar* str);
 IMGUI_API const ImWchar*ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin); // Find beginning-of-line
 IMGUI_API const char*   ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end);
+IMGUI_API const char*   ImStristrLower(const char* haystack, const char* haystack_end, const char* needle_lower, const char* needle_lower_end);   // Same as ImStristr() with an already lower-cased needle (ASCII case folding). Uses SSE2 when available.
 IMGUI_API int           ImFormatString(char* buf, int buf_size, const char* fmt, ...) IM_PRINTFARGS(3);
 IMGUI_API int           ImFormatStringV(char* buf, int buf_size, const char* fmt, va_list args);
 
@@ -307,17 +348,25 @@ struct IMGUI_API ImGuiSimpleColumns
 struct IMGUI_API ImGuiTextEditState
 {
     ImGuiID             Id;                         // widget id owning the text state
-    ImVector<ImWchar>   Text;                       // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
+    ImVector<ImWchar>   Text;                       // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer. sized to the text length, grown on insertion.
     ImVector<char>      InitialText;                // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
     ImVector<char>      TempTextBuffer;
     int                 CurLenA, CurLenW;           // we need to maintain our buffer length in both UTF-8 and wchar format.
     int                 BufSizeA;                   // end-user buffer size
+    bool                BufResizable;               // ImGuiInputTextFlags_CallbackResize: BufSizeA doesn't limit the text length
     float               ScrollX;
     ImGuiStb::STB_TexteditState   StbState;
     float               CursorAnim;
     bool                CursorFollow;
     bool                SelectedAllMouseLock;
 
+    // Layout index, rebuilt lazily from the first edited line onward. Used by the stb_textedit row queries and for rendering.
+    ImVector<int>       LineStarts;                 // index of the first character of each line
+    ImVector<float>     CharX;                      // x offset of each character from the start of its line, CharX[CurLenW] is the end of the last line
+    bool                LayoutDirty;
+    ImFont*             LayoutFont;
+    float               LayoutFontSize;
+
     ImGuiTextEditState()                            { memset(this, 0, sizeof(*this)); }
     void                CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
     void                CursorClamp()               { StbState.cursor = ImMin(StbState.cursor, CurLenW); StbState.select_start = ImMin(StbState.select_start, CurLenW); StbState.select_end = ImMin(StbState.select_end, CurLenW); }
@@ -325,6 +374,29 @@ struct IMGUI_API ImGuiTextEditState
     void                ClearSelection()            { StbState.select_start = StbState.select_end = StbState.cursor; }
     void                SelectAll()                 { StbState.select_start = 0; StbState.select_end = CurLenW; StbState.cursor = StbState.select_end; StbState.has_preferred_x = false; }
     void                OnKeyPressed(int key);
+    void                InvalidateLayout(int pos);  // text changed from character #pos onward
+    void                UpdateLayout();
+    int                 GetLineFromChar(int n) const;
+};
+
+// Internal state of the currently focused/edited InputTextMultiline() over an ImGuiTextRope. Cursor and selection are byte offsets into the rope.
+struct IMGUI_API ImGuiTextRopeEditState
+{
+    ImGuiID             Id;                         // widget id owning the text state
+    int                 Cursor;
+    int                 SelectStart;                // selection is [SelectStart, Cursor) or [Cursor, SelectStart)
+    float               PreferredX;                 // x position kept while moving up/down, < 0.0f when unset
+    float               CursorAnim;
+    bool                CursorFollow;
+    ImVector<char>      TempTextBuffer;
+
+    ImGuiTextRopeEditState()                        { Id = 0; Cursor = SelectStart = 0; PreferredX = -1.0f; CursorAnim = 0.0f; CursorFollow = false; }
+    void                CursorAnimReset()           { CursorAnim = -0.30f; }
+    void                CursorClamp(int len)        { Cursor = ImClamp(Cursor, 0, len); SelectStart = ImClamp(SelectStart, 0, len); }
+    bool                HasSelection() const        { return Cursor != SelectStart; }
+    int                 GetSelectionMin() const     { return ImMin(Cursor, SelectStart); }
+    int                 GetSelectionMax() const     { return ImMax(Cursor, SelectStart); }
+    void                ReplaceSelection(ImGuiTextRope* rope, const char* text, const char* text_end);
 };
 
 // Data saved in imgui.ini file
@@ -335,6 +407,23 @@ struct ImGuiIniData
     ImVec2      Pos;
     ImVec2      Size;
     bool        Collapsed;
+    bool        Dirty;          // Changed since last written to the binary settings journal
+};
+
+#define IM_LOG_BUFFER_FLUSH_SIZE    (64 * 1024)     // Hand the logging buffer to the writer before the end of the frame once it gets this big
+
+// Pending write of a logging buffer to a file or callback, possibly running on another thread (see io.FileWriteAsyncFn)
+struct ImGuiLogWriteJob
+{
+    FILE*               File;
+    void                (*WriteFn)(void* user_data, const char* data, int size);
+    void*               WriteUserData;
+    const char*         Data;
+    int                 DataSize;
+    bool                Finish;         // Flush/close the file after writing
+    volatile int        Pending;
+
+    ImGuiLogWriteJob()  { memset(this, 0, sizeof(*this)); }
 };
 
 // Mouse cursor data (used when io.MouseDrawCursor is set)
@@ -347,6 +436,32 @@ struct ImGuiMouseCursorData
     ImVec2              TexUvMax[2];
 };
 
+// Hit-testing index over the windows, see ImGuiWindowGrid
+struct ImGuiWindowGridEntry
+{
+    ImRect          Rect;           // window->WindowRectClipped expanded by style.TouchExtraPadding
+    ImGuiWindow*    Window;
+    bool            IsChild;
+};
+
+#define IM_WINDOW_GRID_MIN_WINDOWS  32  // Below this number of hoverable windows a linear scan of g.Windows is as fast
+
+// Uniform grid over the clipped rectangles of the hoverable windows, built by EndFrame() once the windows are sorted.
+// FindHoveredWindow() uses it until NewFrame() resets the windows Active flags, or until FocusWindow() reorders g.Windows.
+struct ImGuiWindowGrid
+{
+    bool                            Valid;
+    ImVec2                          Origin;
+    ImVec2                          InvCellSize;
+    int                             CellsX, CellsY;
+    ImVec2                          TouchExtraPadding;  // Padding the rectangles were built with
+    ImVector<ImGuiWindowGridEntry>  Entries;            // Compact copy of the hoverable windows, in g.Windows order (back to front)
+    ImVector<int>                   CellStart;          // CellsX*CellsY+1 offsets into CellEntries
+    ImVector<int>                   CellEntries;        // Indices into Entries, back to front within each cell
+
+    ImGuiWindowGrid()               { Valid = false; CellsX = CellsY = 0; }
+};
+
 // Storage for current popup stack
 struct ImGuiPopupRef
 {
@@ -359,16 +474,155 @@ struct ImGuiPopupRef
     ImGuiPopupRef(ImGuiID id, ImGuiWindow* parent_window, ImGuiID parent_menu_set, const ImVec2& mouse_pos) { PopupId = id; Window = NULL; ParentWindow = parent_window; ParentMenuSet = parent_menu_set; MousePosOnOpen = mouse_pos; }
 };
 
+// Timing scope recorded by the frame profiler (when io.ProfilerEnabled is set)
+struct ImGuiProfileEvent
+{
+    ImGuiID             Id;                     // == window->ID for Begin()/End() scopes, ImHash(name) otherwise
+    const char*         Name;                   // Interned in ImGuiProfiler::Names
+    double              StartTime;
+    double              EndTime;
+    double              ChildTime;              // Time spent in nested scopes, so we can derive exclusive time
+    int                 Depth;
+};
+
+struct ImGuiProfileFrame
+{
+    int                 FrameCount;
+    double              StartTime;
+    double              EndTime;
+    unsigned int        EventsBegin;            // Range of events in ImGuiProfiler::EventsWritten space
+    unsigned int        EventsEnd;
+};
+
+#define IM_PROFILER_EVENTS_COUNT    (1 << 14)   // Ring buffer sizes, must be power of two
+#define IM_PROFILER_FRAMES_COUNT    (1 << 7)
+
+struct IMGUI_API ImGuiProfiler
+{
+    bool                        Active;         // Latched from io.ProfilerEnabled in NewFrame(), so scopes stay balanced within a frame
+    bool                        FrameOpen;
+    ImVector<ImGuiProfileEvent> Events;         // Ring buffer of closed scopes
+    unsigned int                EventsWritten;
+    ImVector<ImGuiProfileEvent> Stack;          // Open scopes
+    ImVector<ImGuiProfileFrame> Frames;         // Ring buffer of completed frames
+    unsigned int                FramesWritten;
+    ImGuiProfileFrame           CurrentFrame;
+    ImGuiStorage                Names;          // Interned scope names: ID -> char*
+
+    ImGuiProfiler()             { Active = FrameOpen = false; EventsWritten = FramesWritten = 0; memset(&CurrentFrame, 0, sizeof(CurrentFrame)); }
+    void                        Clear();
+    const char*                 InternName(ImGuiID id, const char* name);
+    bool                        IsEventValid(unsigned int n) const  { return (unsigned int)(EventsWritten - n - 1) < (unsigned int)Events.Size; }
+    ImGuiProfileEvent&          GetEvent(unsigned int n)            { return Events[(int)(n & (IM_PROFILER_EVENTS_COUNT - 1))]; }
+};
+
+// Input recorder/replayer (BeginInputRecording(), BeginInputReplay())
+// File: "ImGuiRec" + version + io.KeyMap[], then per frame: flags byte, DeltaTime, and only the fields which changed since the previous frame. Native byte order.
+enum ImGuiInputRecordFlags_
+{
+    ImGuiInputRecordFlags_DisplaySize   = 1 << 0,
+    ImGuiInputRecordFlags_MousePos      = 1 << 1,
+    ImGuiInputRecordFlags_Buttons       = 1 << 2,   // Mouse buttons and key modifiers
+    ImGuiInputRecordFlags_MouseWheel    = 1 << 3,
+    ImGuiInputRecordFlags_Keys          = 1 << 4,   // Count + indices of the io.KeysDown[] entries which toggled
+    ImGuiInputRecordFlags_Chars         = 1 << 5
+};
+
+#define IM_INPUT_RECORD_VERSION     1
+
+struct IMGUI_API ImGuiInputRecorder
+{
+    FILE*                       RecordFile;
+    ImVector<unsigned char>     FrameData;      // Frame being encoded, written with a single fwrite()
+    ImVector<unsigned char>     ReplayData;     // Whole recording, loaded by BeginInputReplay()
+    int                         ReplayPos;
+    float                       ReplayDeltaTime;// > 0.0f: fixed timestep replacing the recorded DeltaTime
+    int                         Frames;         // Frames recorded or replayed so far
+    ImVec2                      DisplaySize;    // Last recorded/replayed state
+    ImVec2                      MousePos;
+    int                         Buttons;        // io.MouseDown[0..4] then KeyCtrl, KeyShift, KeyAlt, KeySuper bits
+    bool                        KeysDown[512];
+
+    ImGuiInputRecorder()        { RecordFile = NULL; ReplayPos = 0; ReplayDeltaTime = 0.0f; ResetState(); }
+    void                        ResetState()    { Frames = 0; DisplaySize = ImVec2(0.0f, 0.0f); MousePos = ImVec2(-1.0f, -1.0f); Buttons = 0; memset(KeysDown, 0, sizeof(KeysDown)); }
+};
+
+// Size-class pools backing MemAlloc() when io.MemUsePools is set. Each chunk serves a single size class.
+// Chunks are kept sorted by address so MemFree() can find the owner of a pointer with a binary search.
+// The bookkeeping array is allocated with io.MemAllocFn() directly since we can't recurse into MemAlloc().
+// Pools holding chunks are also linked in a process-wide list, so a block freed while another context (or none) is current still finds its way back to its pool.
+// Such remote frees are queued on the owning pool and applied by its own context on the next NewFrame()/Alloc()/Trim(). When a context is destroyed while some of its blocks
+// are still in use (e.g. by a font atlas shared with other contexts), its chunks are handed over to an orphan pool which releases them as the blocks get freed.
+#define IM_MEMPOOL_CLASS_COUNT  9               // 16, 32, 64 .. 4096 bytes
+#define IM_MEMPOOL_CHUNK_SIZE   (64 * 1024)
+
+struct ImGuiMemPoolChunk
+{
+    char*               Data;
+    void*               FreeList;               // Blocks given back by MemFree()
+    int                 SizeClass;
+    int                 BlocksUsed;
+    int                 BlocksCarved;           // Blocks are carved lazily from the start of the chunk
+};
+
+struct IMGUI_API ImGuiMemPool
+{
+    ImGuiMemPoolChunk*  Chunks;
+    int                 ChunksCount;
+    int                 ChunksCapacity;
+    int                 LastChunk[IM_MEMPOOL_CLASS_COUNT];  // Index of the last chunk which served a given class, -1 if unknown
+    void                (*FreeFn)(void* ptr);   // io.MemFreeFn of the owning context, to release the chunks without it
+    ImGuiMemPool*       Next;                   // Next pool holding chunks, in the process-wide list
+    void*               RemoteFreeList;         // Blocks freed from another context or thread, waiting for NewFrame()/Alloc()/Trim() (protected by the list lock)
+    volatile int        RemoteFreesPending;
+    bool                Orphan;                 // Holds the remaining chunks of a destroyed context
+
+    ImGuiMemPool()      { Chunks = NULL; ChunksCount = ChunksCapacity = 0; for (int n = 0; n < IM_MEMPOOL_CLASS_COUNT; n++) LastChunk[n] = -1; FreeFn = NULL; Next = NULL; RemoteFreeList = NULL; RemoteFreesPending = 0; Orphan = false; }
+    ~ImGuiMemPool();
+    void*               Alloc(size_t sz);       // Return NULL if sz doesn't fit in a size class
+    bool                Free(void* ptr);        // Return false if ptr isn't owned by the pool. Only call with the owning context current.
+    void                Trim();                 // Release empty chunks
+    int                 GetReservedBytes() const { return ChunksCount * IM_MEMPOOL_CHUNK_SIZE; }
+    int                 FindChunk(const void* ptr) const;
+    void                TakeRemoteFrees();
+    void                TrimLocked();
+    static bool         FreeRemote(void* ptr);  // Give ptr back to whichever pool owns it, from any context or thread. Return false if no pool owns it.
+};
+
+// Bump allocator for transient data, rewound on NewFrame().
+// When a frame overflows the arena, extra blocks are chained and the arena is regrown to the peak size on the next rewind. It shrinks back after staying mostly unused for a while.
+#define IM_MEMFRAMEARENA_MIN_CAPACITY   4096
+struct IMGUI_API ImGuiMemFrameArena
+{
+    char*               Data;
+    size_t              Size;
+    size_t              Capacity;
+    void*               Overflow;               // Linked list of blocks allocated when Data was full
+    size_t              OverflowSize;
+    int                 UnderusedFrames;
+
+    ImGuiMemFrameArena()    { Data = NULL; Size = Capacity = OverflowSize = 0; Overflow = NULL; UnderusedFrames = 0; }
+    ~ImGuiMemFrameArena()   { Clear(); }
+    void*               Alloc(size_t sz);
+    void                Rewind();
+    void                Clear();
+};
+
 // Main state for ImGui
 struct ImGuiContext
 {
     bool                    Initialized;
     ImGuiIO                 IO;
+    ImGuiMemPool            MemPool;                            // Declared before anything which may hold memory, so it gets destructed last
+    ImGuiMemFrameArena      MemFrameArena;
+    int                     MemFrameAllocs;                     // Counters for the current frame, copied to IO.MetricsFrameAllocs/IO.MetricsFrameAllocsBytes in NewFrame()
+    int                     MemFrameAllocsBytes;
     ImGuiStyle              Style;
     ImFont*                 Font;                               // (Shortcut) == FontStack.empty() ? IO.Font : FontStack.back()
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize()
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Size of characters.
     ImVec2                  FontTexUvWhitePixel;                // (Shortcut) == Font->TexUvWhitePixel
+    const ImVec4*           FontTexUvLines;                     // (Shortcut) == Font->ContainerAtlas->TexUvLines
 
     float                   Time;
     int                     FrameCount;
@@ -376,6 +630,9 @@ struct ImGuiContext
     int                     FrameCountRendered;
     ImVector<ImGuiWindow*>  Windows;
     ImVector<ImGuiWindow*>  WindowsSortBuffer;
+    ImGuiStorage            WindowsById;                        // ImGuiID -> ImGuiWindow*, for FindWindowByID()
+    ImGuiWindowGrid         WindowGrid;                         // Hit-testing index over g.Windows, valid from EndFrame() to the next NewFrame()
+    ImGuiStorage            WindowsGcStorage;                   // ImGuiID -> ImGuiStorage*, StateStorage of the windows freed by GcStaleWindows() when io.WindowsGcKeepStorage is set
     ImGuiWindow*            CurrentWindow;                      // Being drawn into
     ImVector<ImGuiWindow*>  CurrentWindowStack;
     ImGuiWindow*            FocusedWindow;                      // Will catch keyboard inputs
@@ -395,6 +652,8 @@ struct ImGuiContext
     ImGuiID                 MovedWindowMoveId;                  // == MovedWindow->RootWindow->MoveId
     ImVector<ImGuiIniData>  Settings;                           // .ini Settings
     float                   SettingsDirtyTimer;                 // Save .ini Settings on disk when time reaches zero
+    int                     SettingsJournalRecords;             // Number of records in the binary settings journal, including overwritten ones
+    volatile int            SettingsSaveJobPending;             // Set while a binary settings write is in flight (possibly on another thread)
     ImVector<ImGuiColMod>   ColorModifiers;                     // Stack for PushStyleColor()/PopStyleColor()
     ImVector<ImGuiStyleMod> StyleModifiers;                     // Stack for PushStyleVar()/PopStyleVar()
     ImVector<ImFont*>       FontStack;                          // Stack for PushFont()/PopFont()
@@ -421,6 +680,7 @@ struct ImGuiContext
     // Render
     ImDrawData              RenderDrawData;                     // Main ImDrawData instance to pass render information to the user
     ImVector<ImDrawList*>   RenderDrawLists[3];
+    unsigned int            DrawListsContentVersion;            // Last ImDrawList::ContentVersion given out (see io.RenderDrawListsTrackChanges)
     float                   ModalWindowDarkeningRatio;
     ImDrawList              OverlayDrawList;                    // Optional software render of mouse cursors, if io.MouseDrawCursor is set + a few debug overlays
     ImGuiMouseCursor        MouseCursor;
@@ -428,6 +688,8 @@ struct ImGuiContext
 
     // Widget state
     ImGuiTextEditState      InputTextState;
+    ImGuiTextRopeEditState  InputTextRopeState;
+    ImGuiGridCallbackData   GridCallbackData;                   // Reused by Grid() to collect the text of the visible cells
     ImFont                  InputTextPasswordFont;
     ImGuiID                 ScalarAsInputTextId;                // Temporary text input when CTRL+clicking on a slider, etc.
     ImGuiStorage            ColorEditModeStorage;               // Store user selection of color edit mode
@@ -441,10 +703,19 @@ struct ImGuiContext
     char*                   PrivateClipboard;                   // If no custom clipboard handler is defined
     ImVec2                  OsImePosRequest, OsImePosSet;       // Cursor position request & last passed to the OS Input Method Editor
 
+    // Profiling
+    ImGuiProfiler           Profiler;
+    ImGuiInputRecorder      InputRecorder;
+
     // Logging
     bool                    LogEnabled;
     FILE*                   LogFile;                            // If != NULL log to stdout/ file
+    void                    (*LogWriteFn)(void* user_data, const char* data, int size); // Else if != NULL log to callback
+    void*                   LogWriteUserData;
     ImGuiTextBuffer*        LogClipboard;                       // Else log to clipboard. This is pointer so our GImGui static constructor doesn't call heap allocators.
+    ImVector<char>          LogBuffers[2];                      // File/callback output is accumulated into LogBuffers[LogBufferFront] and the other buffer is handed to LogWriteJob
+    int                     LogBufferFront;
+    ImGuiLogWriteJob        LogWriteJob;
     int                     LogStartDepth;
     int                     LogAutoExpandMaxDepth;
 
@@ -459,9 +730,11 @@ struct ImGuiContext
     ImGuiContext()
     {
         Initialized = false;
+        MemFrameAllocs = MemFrameAllocsBytes = 0;
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
         FontTexUvWhitePixel = ImVec2(0.0f, 0.0f);
+        FontTexUvLines = NULL;
 
         Time = 0.0f;
         FrameCount = 0;
@@ -483,6 +756,8 @@ struct ImGuiContext
         MovedWindow = NULL;
         MovedWindowMoveId = 0;
         SettingsDirtyTimer = 0.0f;
+        SettingsJournalRecords = 0;
+        SettingsSaveJobPending = 0;
 
         SetNextWindowPosVal = ImVec2(0.0f, 0.0f);
         SetNextWindowSizeVal = ImVec2(0.0f, 0.0f);
@@ -510,6 +785,7 @@ struct ImGuiContext
         PrivateClipboard = NULL;
         OsImePosRequest = OsImePosSet = ImVec2(-1.0f, -1.0f);
 
+        DrawListsContentVersion = 0;
         ModalWindowDarkeningRatio = 0.0f;
         OverlayDrawList._OwnerName = "##Overlay"; // Give it a name for debugging
         MouseCursor = ImGuiMouseCursor_Arrow;
@@ -517,7 +793,10 @@ struct ImGuiContext
 
         LogEnabled = false;
         LogFile = NULL;
+        LogWriteFn = NULL;
+        LogWriteUserData = NULL;
         LogClipboard = NULL;
+        LogBufferFront = 0;
         LogStartDepth = 0;
         LogAutoExpandMaxDepth = 2;
 
@@ -641,6 +920,7 @@ struct IMGUI_API ImGuiWindow
     bool                    Accessed;                           // Set to true when any widget access the current window
     bool                    Collapsed;                          // Set when collapsing window to become only title-bar
     bool                    SkipItems;                          // == Visible && !Collapsed
+    bool                    SkipItemsOffscreen;                 // Set when SkipItems is only set because the window is entirely outside of the display. The window is kept active (IDs alive, size and scroll preserved) but not rendered.
     int                     BeginCount;                         // Number of Begin() during the current frame (generally 0 or 1, 1+ if appending via multiple Begin/End pairs)
     ImGuiID                 PopupId;                            // ID in the popup stack when this window is used as a popup/menu (because we use generic Name/ID for recycling)
     int                     AutoFitFramesX, AutoFitFramesY;
@@ -657,6 +937,7 @@ struct IMGUI_API ImGuiWindow
     ImRect                  ClipRect;                           // = DrawList->clip_rect_stack.back(). Scissoring / clipping rectangle. x1, y1, x2, y2.
     ImRect                  WindowRectClipped;                  // = WindowRect just after setup in Begin(). == window->Rect() for root window.
     int                     LastFrameActive;
+    float                   LastTimeActive;                     // g.Time of the last frame this window was active, for io.WindowsGcTime
     float                   ItemWidthDefault;
     ImGuiSimpleColumns      MenuColumns;                        // Simplified columns storage for menu items
     ImGuiStorage            StateStorage;
@@ -675,13 +956,15 @@ struct IMGUI_API ImGuiWindow
     int                     FocusIdxTabRequestNext;             // "
 
 public:
-    ImGuiWindow(const char* name);
+    ImGuiWindow(const char* name, ImGuiID id);
     ~ImGuiWindow();
 
     ImGuiID     GetID(const char* str, const char* str_end = NULL);
     ImGuiID     GetID(const void* ptr);
     ImGuiID     GetIDNoKeepAlive(const char* str, const char* str_end = NULL);
 
+    int         GetRetainedBytes() const;
+
     ImRect      Rect() const                            { return ImRect(Pos.x, Pos.y, Pos.x+Size.x, Pos.y+Size.y); }
     float       CalcFontSize() const                    { return GImGui->FontBaseSize * FontWindowScale; }
     float       TitleBarHeight() const                  { return (Flags & ImGuiWindowFlags_NoTitleBar) ? 0.0f : CalcFontSize() + GImGui->Style.FramePadding.y * 2.0f; }
@@ -705,8 +988,11 @@ namespace ImGui
     inline    ImGuiWindow*  GetCurrentWindow()          { ImGuiContext& g = *GImGui; g.CurrentWindow->Accessed = true; return g.CurrentWindow; }
     IMGUI_API ImGuiWindow*  GetParentWindow();
     IMGUI_API ImGuiWindow*  FindWindowByName(const char* name);
+    IMGUI_API ImGuiWindow*  FindWindowByID(ImGuiID id);
+    IMGUI_API bool          BeginEx(ImGuiID id, const char* name, bool* p_open, const ImVec2& size_on_first_use, float bg_alpha, ImGuiWindowFlags flags);  // Begin() a window identified by 'id' rather than by its name. 'name' is only read on creation (NULL: generate a debug name) and for the title bar.
     IMGUI_API void          FocusWindow(ImGuiWindow* window);
 
+    IMGUI_API void          PushProfileScopeEx(ImGuiID id, const char* name, double start_time);
     IMGUI_API void          EndFrame();                 // Ends the ImGui frame. Automatically called by Render()! you most likely don't need to ever call that yourself directly. If you don't need to render you can call EndFrame() but you'll have wasted CPU already. If you don't need to render, don't create any windows instead!
 
     IMGUI_API void          SetActiveID(ImGuiID id, ImGuiWindow* window);
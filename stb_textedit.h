@@ -3,6 +3,7 @@
 // [ImGui] - fixed a state corruption/crash bug in stb_text_redo and stb_textedit_discard_redo (#715)
 // [ImGui] - fixed a crash bug in stb_textedit_discard_redo (#681)
 // [ImGui] - fixed some minor warnings
+// [ImGui] - added optional STB_TEXTEDIT_LOCATEROW/STB_TEXTEDIT_FINDROW/STB_TEXTEDIT_GETX hooks so hosts with a line index don't need rows to be laid out from the start of the text
 
 // stb_textedit.h - v1.9  - public domain - Sean Barrett
 // Development of this library was sponsored by RAD Game Tools
@@ -166,6 +167,11 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_LOCATEROW(obj,y,&base_y)    [ImGui] returns the first character of the row straddling 'y' and
+//                                               its base_y, or STRINGLEN(obj) if 'y' is below all rows
+//    STB_TEXTEDIT_FINDROW(obj,n,&prev,&y)     [ImGui] returns the first character of the row containing character #n,
+//                                               with the first character of the previous row and the row y offset
+//    STB_TEXTEDIT_GETX(obj,first,n)           [ImGui] returns the x offset of character #n in the row starting at #first
 //
 // Todo:
 //    STB_TEXTEDIT_K_PGUP        keyboard input to move cursor up a page
@@ -400,6 +406,17 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
    r.num_chars = 0;
 
    // search rows to find one that straddles 'y'
+#ifdef STB_TEXTEDIT_LOCATEROW
+   i = STB_TEXTEDIT_LOCATEROW(str, y, &base_y);
+   if (i < n) {
+      STB_TEXTEDIT_LAYOUTROW(&r, str, i);
+      if (r.num_chars <= 0)
+         return n;
+
+      if (i==0 && y < base_y + r.ymin)
+         return 0;
+   }
+#else
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (r.num_chars <= 0)
@@ -414,6 +431,7 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
       i += r.num_chars;
       base_y += r.baseline_y_delta;
    }
+#endif
 
    // below all text, return 'after' last character
    if (i >= n)
@@ -508,11 +526,19 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
          find->y = 0;
          find->x = 0;
          find->height = 1;
+#ifdef STB_TEXTEDIT_FINDROW
+         if (z > 0) {
+            float row_y;
+            prev_start = STB_TEXTEDIT_FINDROW(str, z - 1, &first, &row_y);
+         }
+         i = z;
+#else
          while (i < z) {
             STB_TEXTEDIT_LAYOUTROW(&r, str, i);
             prev_start = i;
             i += r.num_chars;
          }
+#endif
          find->first_char = i;
          find->length = 0;
          find->prev_first = prev_start;
@@ -523,6 +549,10 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
    // search rows to find the one that straddles character n
    find->y = 0;
 
+#ifdef STB_TEXTEDIT_FINDROW
+   i = STB_TEXTEDIT_FINDROW(str, n, &prev_start, &find->y);
+   STB_TEXTEDIT_LAYOUTROW(&r, str, i);
+#else
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (n < i + r.num_chars)
@@ -531,6 +561,7 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
       i += r.num_chars;
       find->y += r.baseline_y_delta;
    }
+#endif
 
    find->first_char = first = i;
    find->length = r.num_chars;
@@ -539,9 +570,13 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
 
    // now scan to find xpos
    find->x = r.x0;
+#ifdef STB_TEXTEDIT_GETX
+   find->x += STB_TEXTEDIT_GETX(str, first, n);
+#else
    i = 0;
    for (i=0; first+i < n; ++i)
       find->x += STB_TEXTEDIT_GETWIDTH(str, first, i);
+#endif
 }
 
 #define STB_TEXT_HAS_SELECTION(s)   ((s)->select_start != (s)->select_end)